@@ -1,8 +1,89 @@
-const { app, BrowserWindow, dialog, ipcMain } = require('electron');
+const { app, BrowserWindow, dialog, ipcMain, utilityProcess, MessageChannelMain } = require('electron');
 const path = require('path');
 const fs = require('fs');
+const { readTextFile, streamTextFile, encodeText, rememberEncoding, resolveSaveEncoding } = require('./main/textEncoding.cjs');
+const { saveFilesAtomically, recoverInterruptedSave, SaveConflictError } = require('./main/atomicSave.cjs');
+const { planFilePatch, fileMatchesHash, sha1 } = require('./main/filePatch.cjs');
+const { getPropItemIndex, invalidatePropItemIndex } = require('./main/propItemIndex.cjs');
+const { ResourceWatcher, createLineHasher, hashContent } = require('./main/resourceWatcher.cjs');
+const { readParseCache, writeParseCache } = require('./main/parseCache.cjs');
+const { openStreamWriter } = require('./main/streamWriter.cjs');
 const isDev = process.env.NODE_ENV !== 'production' || process.env.ELECTRON_START_URL;
 
+// Ermittelt den Ressourcenordner (App-Pfad, sonst Arbeitsverzeichnis)
+function getResourceFolder() {
+  const resourceFolder = path.join(app.getAppPath(), 'public', 'resource');
+  if (fs.existsSync(resourceFolder)) {
+    return resourceFolder;
+  }
+  return path.join(process.cwd(), 'public', 'resource');
+}
+
+// Löst einen Dateinamen relativ zum Ressourcenordner auf und verhindert Zugriffe außerhalb davon
+function resolveResourceFile(fileName) {
+  const resourceFolder = getResourceFolder();
+  const filePath = path.resolve(resourceFolder, fileName);
+  if (!fileName || path.isAbsolute(fileName) || !filePath.startsWith(resourceFolder + path.sep)) {
+    throw new Error(`Ungültiger Ressourcenpfad: ${fileName}`);
+  }
+  return filePath;
+}
+
+// Pfad einer kompilierten Symboltabelle (z.B. "defineItem.h.symtab") in userData/symtab
+function resolveSymbolTableFile(fileName) {
+  if (!/^[A-Za-z0-9._-]{1,200}\.symtab$/.test(fileName || '')) {
+    throw new Error(`Ungültiger Name einer Symboltabelle: ${fileName}`);
+  }
+  return path.join(app.getPath('userData'), 'symtab', fileName);
+}
+
+// Wie resolveResourceFile, ignoriert aber Groß-/Kleinschreibung ("Spec_Item.txt" vs. "Spec_item.txt")
+// @returns Pfad der vorhandenen Datei oder null
+async function findResourceFile(fileName) {
+  const filePath = resolveResourceFile(fileName);
+  if (fs.existsSync(filePath)) {
+    return filePath;
+  }
+  const match = (await fs.promises.readdir(path.dirname(filePath)))
+    .find(name => name.toLowerCase() === path.basename(filePath).toLowerCase());
+  return match ? path.join(path.dirname(filePath), match) : null;
+}
+
+// Vorhandene Datei in folder, deren Name sich nur in Groß-/Kleinschreibung unterscheidet
+// (z.B. Spec_Item.txt -> Spec_item.txt), sonst der Pfad zu einer neuen Datei
+async function resolveExistingPath(folder, fileName) {
+  const filePath = path.join(folder, fileName);
+  if (fs.existsSync(filePath)) {
+    return filePath;
+  }
+  const match = (await fs.promises.readdir(folder))
+    .find(name => name.toLowerCase() === fileName.toLowerCase());
+  return match ? path.join(folder, match) : filePath;
+}
+
+// Parser-Prozess (public/main/parserProcess.cjs): liest, dekodiert und scannt Spec_item.txt
+// außerhalb des Renderers. Wird beim ersten Verbinden gestartet und bleibt
+// bis zum Beenden der App bestehen; nach einem Absturz startet ihn die nächste Verbindung neu.
+let parserProcess = null;
+// Empfänger der Meldungen des Parser-Prozesses (je Fenster einer, siehe createWindow)
+const parserListeners = new Set();
+
+function getParserProcess() {
+  if (!parserProcess) {
+    parserProcess = utilityProcess.fork(path.join(__dirname, 'main', 'parserProcess.cjs'), [getResourceFolder()], {
+      serviceName: 'Cyrus Parser'
+    });
+    parserProcess.on('message', (message) => {
+      parserListeners.forEach(listener => listener(message));
+    });
+    parserProcess.on('exit', (code) => {
+      console.log(`Parser-Prozess beendet (Code ${code})`);
+      parserProcess = null;
+    });
+  }
+  return parserProcess;
+}
+
 function createWindow() {
   // Create the browser window
   const mainWindow = new BrowserWindow({
@@ -20,6 +101,24 @@ function createWindow() {
   // Set application menu
   mainWindow.setMenuBarVisibility(false);
 
+  // Externe Änderungen im Ressourcenordner als Zeilen-Deltas an den Renderer melden
+  const resourceWatcher = new ResourceWatcher(getResourceFolder(), (delta) => {
+    if (!mainWindow.isDestroyed()) {
+      mainWindow.webContents.send('resource-file-changed', delta);
+    }
+  }).start();
+  mainWindow.on('closed', () => resourceWatcher.close());
+
+  // Vom Parser-Prozess geladene Dateien: Kodierung für das Speichern merken und den
+  // Ausgangsstand für die Ressourcenüberwachung setzen (wie bei open-resource-stream)
+  const onParserMessage = (message) => {
+    if (message?.type !== 'loaded') return;
+    rememberEncoding(message.fileName, message.encoding);
+    resourceWatcher.prime(message.fileName, message.hash, message.lines);
+  };
+  parserListeners.add(onParserMessage);
+  mainWindow.on('closed', () => parserListeners.delete(onParserMessage));
+
   // Debug-Info ausgeben
   console.log('App path:', app.getAppPath());
   console.log('__dirname:', __dirname);
@@ -202,17 +301,30 @@ function createWindow() {
         console.log(`Created directory: ${saveDir}`);
       }
       
-      // Write the file directly without backup
-      fs.writeFileSync(actualPath, content, 'utf8');
+      // In der beim Laden erkannten Kodierung schreiben (Standard: UTF-8)
+      const encodingInfo = resolveSaveEncoding(fileName || actualPath);
+      const data = encodeText(content, encodingInfo);
+      const hash = sha1(data);
+      
+      // Gleiche Bytes wie auf der Platte: nicht schreiben (Änderungszeit und Backups bleiben)
+      if (await fileMatchesHash(actualPath, data.length, hash)) {
+        resourceWatcher.update(actualPath, content, hash);
+        console.log(`File unchanged, write skipped: ${actualPath}`);
+        return { success: true, path: actualPath, size: data.length, hash, unchanged: true };
+      }
+      
+      fs.writeFileSync(actualPath, data);
+      resourceWatcher.update(actualPath, content, hash);
       
       // Log success
       const stats = fs.statSync(actualPath);
-      console.log(`File saved: ${actualPath} (${stats.size} bytes)`);
+      console.log(`File saved (${encodingInfo.encoding}): ${actualPath} (${stats.size} bytes)`);
       
       return { 
         success: true, 
         path: actualPath,
-        size: stats.size
+        size: stats.size,
+        hash
       };
     } catch (error) {
       console.error('Error saving file:', error);
@@ -254,29 +366,35 @@ function createWindow() {
         console.log(`Created directory: ${saveDir}`);
       }
       
-      // Bestimme die zu verwendende Kodierung
-      let encoding = 'utf8';
-      if (options && options.encoding) {
-        if (options.encoding === 'latin1' || options.encoding === 'win1252' || options.useANSI) {
-          encoding = 'latin1'; // ANSI/Windows-1252 kompatibel
-          console.log(`Verwende ANSI-kompatible Kodierung (latin1) für ${fileName}`);
-        } else {
-          encoding = options.encoding;
-        }
-      }
+      // Bestimme die zu verwendende Kodierung: die beim Laden erkannte Kodierung hat Vorrang,
+      // damit die Datei byte-genau (inkl. BOM) zurückgeschrieben wird. "latin1"/useANSI wird
+      // als echtes Windows-1252 geschrieben (Node-latin1 verliert z.B. €, Œ, „).
+      const encodingInfo = resolveSaveEncoding(fileName || actualPath, options);
+      console.log(`Verwende Kodierung ${encodingInfo.encoding}${encodingInfo.bom ? ' (BOM)' : ''} für ${fileName}`);
       
       // Write the file with the specified encoding
-      fs.writeFileSync(actualPath, content, encoding);
+      const data = encodeText(content, encodingInfo);
+      const hash = sha1(data);
+      
+      if (await fileMatchesHash(actualPath, data.length, hash)) {
+        resourceWatcher.update(actualPath, content, hash);
+        console.log(`File unchanged, write skipped: ${actualPath}`);
+        return { success: true, path: actualPath, size: data.length, encoding: encodingInfo.encoding, hash, unchanged: true };
+      }
+      
+      fs.writeFileSync(actualPath, data);
+      resourceWatcher.update(actualPath, content, hash);
       
       // Log success
       const stats = fs.statSync(actualPath);
-      console.log(`File saved with encoding ${encoding}: ${actualPath} (${stats.size} bytes)`);
+      console.log(`File saved with encoding ${encodingInfo.encoding}: ${actualPath} (${stats.size} bytes)`);
       
       return { 
         success: true, 
         path: actualPath,
         size: stats.size,
-        encoding: encoding
+        encoding: encodingInfo.encoding,
+        hash
       };
     } catch (error) {
       console.error('Error saving file with encoding:', error);
@@ -324,90 +442,135 @@ function createWindow() {
           console.log(`Verzeichnis erstellt: ${finalPath}`);
       }
       
-      const results = [];
-      
-      // Speichere jede Datei einzeln
-      for (const file of files) {
-        try {
-          console.log(`Speichere Datei ${file.name} (${file.content ? file.content.length : 0} Zeichen)`);
-      
-      // Spezielle Behandlung für propItem.txt.txt
-          let finalContent = file.content;
+      // Alle Dateien vorbereiten. Jede Datei kommt als vollständiger Inhalt (content), als
+      // Zeilen-Patch auf den Stand baseHash (patch) oder, bei propItem.txt.txt, als geänderte
+      // Einträge (entries), die über den Zeilenindex in die Datei übernommen werden.
+      // Patches und Einträge werden nur als geänderte Byte-Bereiche geschrieben.
+      const entries = await Promise.all(files.map(async (file) => {
+        const fullPath = await resolveExistingPath(finalPath, file.name);
         
-          if (file.name === 'propItem.txt.txt' && fs.existsSync(path.join(finalPath, file.name))) {
-          try {
-            console.log(`Bestehende propItem.txt.txt gefunden, führe Inhalte zusammen`);
-              const existingContent = fs.readFileSync(path.join(finalPath, file.name), 'utf8');
-            
-            // Wir haben neue Einträge im Format "ID\tWert"
-            // Wir müssen sicherstellen, dass IDs nicht dupliziert werden
-            const existingLines = existingContent.split(/\r?\n/);
-              const newLines = file.content.split(/\r?\n/);
-            
-            // Erstelle eine Map von ID zu Wert aus dem bestehenden Inhalt
-            const entries = {};
-            existingLines.forEach(line => {
-              const parts = line.split('\t');
-              if (parts.length >= 2 && parts[0].trim().match(/IDS_PROPITEM_TXT_\d+/)) {
-                entries[parts[0].trim()] = parts[1].trim();
-              }
-            });
-            
-            // Aktualisiere oder füge neue Einträge hinzu
-            newLines.forEach(line => {
-              const parts = line.split('\t');
-              if (parts.length >= 2 && parts[0].trim().match(/IDS_PROPITEM_TXT_\d+/)) {
-                entries[parts[0].trim()] = parts[1].trim();
-              }
-            });
-            
-            // Erstelle den endgültigen Inhalt, sortiert nach ID
-            const finalLines = Object.entries(entries)
-              .sort((a, b) => {
-                const numA = parseInt(a[0].replace(/\D/g, ''), 10);
-                const numB = parseInt(b[0].replace(/\D/g, ''), 10);
-                return numA - numB;
-              })
-              .map(([id, value]) => `${id}\t${value}`);
-            
-            // Nutze Windows-Zeilenumbrüche für bessere Kompatibilität
-              finalContent = finalLines.join('\r\n');
-            
-            console.log(`Zusammengeführte propItem.txt.txt hat ${finalLines.length} Einträge`);
-          } catch (mergeError) {
-            console.error(`Fehler beim Zusammenführen von propItem.txt.txt:`, mergeError);
-            // Verwende neuen Inhalt, wenn Zusammenführung fehlschlägt
+        if (file.entries && fs.existsSync(fullPath)) {
+          const index = await getPropItemIndex(fullPath);
+          if (file.baseHash && index.hash !== file.baseHash) {
+            throw new SaveConflictError(fullPath);
           }
+          const merge = await index.planMerge(file.entries);
+          console.log(`${file.name}: ${merge.changed} Einträge geändert (${merge.inserted} neu), insgesamt ${index.numbers.length}`);
+          if (merge.hunks.length === 0) {
+            return { path: fullPath, unchanged: true, hash: index.hash, hunks: [] };
+          }
+          const ops = index.planWrite(merge.hunks);
+          return { path: fullPath, edits: ops.edits, size: ops.size, baseHash: index.hash, index, hunks: merge.hunks };
         }
-          
-          // The full path including filename
-          const fullPath = path.join(finalPath, file.name);
-          
-          // Entferne den Backup-Code - Dateien direkt überschreiben
-          fs.writeFileSync(fullPath, finalContent, { encoding: 'utf8', flag: 'w' });
-            
-            // Verify the file was actually written
-            if (fs.existsSync(fullPath)) {
-              const stats = fs.statSync(fullPath);
-            console.log(`Datei ${file.name} erfolgreich gespeichert. Größe: ${stats.size} Bytes`);
-          
-          results.push({ 
-              name: file.name,
-            success: true, 
-              path: fullPath,
-              size: stats.size
-          });
+        
+        if (file.entries) {
+          // Noch keine Datei: die Einträge sind ihr vollständiger Inhalt
+          const content = file.entries.map(([key, value]) => `${key}\t${value}`).join('\r\n');
+          return { path: fullPath, content, data: encodeText(content, resolveSaveEncoding(file.name)) };
+        }
+        
+        if (file.patch) {
+          const plan = await planFilePatch(fullPath, { ...file.patch, baseHash: file.baseHash });
+          if (plan.conflict) throw new SaveConflictError(fullPath);
+          if (!plan.success) throw new Error(`${file.name}: ${plan.error}`);
+          console.log(`Patch für ${file.name}: ${file.patch.hunks.length} Bereiche`);
+          if (plan.unchanged) return { path: fullPath, unchanged: true, hash: plan.hash };
+          return { path: fullPath, edits: plan.edits, baseHash: file.baseHash };
+        }
+        
+        // In der Kodierung der geladenen Datei schreiben
+        console.log(`Speichere Datei ${file.name} (${file.content.length} Zeichen)`);
+        return {
+          path: fullPath,
+          content: file.content,
+          data: encodeText(file.content, resolveSaveEncoding(file.name)),
+          baseHash: file.baseHash
+        };
+      }));
+      
+      // Alle Dateien gemeinsam schreiben: Temp-Dateien + fsync, dann atomar ersetzen.
+      // Ein Absturz mittendrin wird beim nächsten Start über das Journal aufgelöst.
+      let results;
+      try {
+        // Dateien, deren Bytes sich nicht ändern, werden nicht neu geschrieben
+        for (const entry of entries) {
+          if (!entry.data) continue;
+          entry.hash = sha1(entry.data);
+          entry.unchanged = await fileMatchesHash(entry.path, entry.data.length, entry.hash);
+        }
+        
+        const pending = entries.filter(entry => !entry.unchanged);
+        const written = pending.length > 0 ? await saveFilesAtomically(pending, app.getPath('userData')) : [];
+        
+        for (const entry of pending) {
+          if (entry.edits) {
+            // Größe und SHA-1 der zusammengesetzten Datei liefert atomicSave
+            const item = written.find(item => item.path === entry.path);
+            entry.size = item.size;
+            entry.hash = item.hash;
+          }
+          if (entry.index) {
+            await entry.index.commit(entry.hunks, entry.size, entry.hash);
+          }
+          if (entry.content !== undefined) {
+            resourceWatcher.update(entry.path, entry.content, entry.hash);
           } else {
-            throw new Error(`Datei existiert nach dem Schreiben nicht: ${fullPath}`);
+            await resourceWatcher.refresh(entry.path);
           }
-        } catch (fileError) {
-          console.error(`Fehler beim Speichern von ${file.name}:`, fileError);
-          
-          results.push({ 
+        }
+        
+        results = await Promise.all(files.map(async (file, index) => {
+          const entry = entries[index];
+          const size = written.find(item => item.path === entry.path)?.size ??
+            (await fs.promises.stat(entry.path)).size;
+          console.log(entry.unchanged
+            ? `Datei ${file.name} unverändert, nicht neu geschrieben (${size} Bytes)`
+            : `Datei ${file.name} erfolgreich gespeichert. Größe: ${size} Bytes`);
+          return {
             name: file.name,
-            success: false, 
-            error: fileError.message || 'Unbekannter Fehler'
+            success: true,
+            path: entry.path,
+            size,
+            hash: entry.hash,
+            unchanged: !!entry.unchanged,
+            // Für entries: die übernommenen Zeilen, damit der Renderer seinen Stand nachführt
+            hunks: entry.hunks
+          };
+        }));
+      } catch (saveError) {
+        // Ob die Bereiche schon in der Datei stehen, ist offen: Index neu aufbauen
+        entries.forEach(entry => { if (entry.index) invalidatePropItemIndex(entry.path); });
+        
+        if (saveError.committed) {
+          // Nach dem Commit-Punkt: alle neuen Inhalte liegen auf der Platte, nur einzelne Dateien
+          // sind noch nicht ersetzt; sie werden beim nächsten Speichern oder Start nachgezogen
+          console.error(`Speichern nach dem Commit unvollständig, ausstehend: ${saveError.pending.join(', ')}`, saveError.cause);
+          results = files.map((file, index) => {
+            const entry = entries[index];
+            if (saveError.pending.includes(entry.path)) {
+              return {
+                name: file.name,
+                success: false,
+                committed: true,
+                path: entry.path,
+                error: `Noch nicht ersetzt (${saveError.cause?.message || 'Unbekannter Fehler'}); wird beim nächsten Speichern oder Start abgeschlossen`
+              };
+            }
+            if (!entry.unchanged) resourceWatcher.refresh(entry.path).catch(() => {});
+            return { name: file.name, success: true, path: entry.path, hash: entry.hash, unchanged: !!entry.unchanged, hunks: entry.hunks };
           });
+        } else if (saveError.conflict) {
+          // Eine Datei wurde außerhalb des Editors geändert: nichts überschreiben, der Renderer meldet den Konflikt
+          console.warn(`Speichern abgebrochen, keine Datei wurde geändert: ${saveError.message}`);
+          results = files.map((file, index) => ({
+            name: file.name,
+            success: false,
+            conflict: entries[index].path === saveError.path,
+            error: saveError.message
+          }));
+        } else {
+          console.error(`Fehler beim Speichern der Dateien, keine Datei wurde geändert:`, saveError);
+          results = files.map(file => ({ name: file.name, success: false, error: saveError.message || 'Unbekannter Fehler' }));
         }
       }
       
@@ -416,10 +579,27 @@ function createWindow() {
       
       return { 
         success: allSuccessful,
+        // Teilweise gespeichert: einzelne Dateien werden erst beim nächsten Speichern oder Start ersetzt
+        partial: results.some(result => result.committed),
         results,
         timestamp: new Date().toISOString()
       };
     } catch (error) {
+      if (error.conflict) {
+        // Schon beim Vorbereiten erkannt (Basis-Hash passt nicht zur Datei)
+        console.warn(`Speichern abgebrochen: ${error.message}`);
+        return {
+          success: false,
+          error: error.message,
+          results: files.map(file => ({
+            name: file.name,
+            success: false,
+            conflict: path.basename(error.path).toLowerCase() === file.name.toLowerCase(),
+            error: error.message
+          })),
+          timestamp: new Date().toISOString()
+        };
+      }
       console.error(`Allgemeiner Fehler beim Speichern aller Dateien:`, error);
       
       return { 
@@ -471,6 +651,10 @@ function createWindow() {
       files.forEach(file => console.log(`- ${file}`));
       
       const fileContents = {};
+      // Erkannte Kodierung je Datei, damit der Renderer beim Speichern dieselbe verwenden kann
+      const fileEncodings = {};
+      // SHA-1 der Bytes je Datei (Basis für Patches beim Speichern)
+      const fileHashes = {};
       
       // Read each file
       for (const file of files) {
@@ -485,9 +669,14 @@ function createWindow() {
         
         try {
           console.log(`Lese Datei: ${file} (${stats.size} Bytes)`);
-          const content = fs.readFileSync(filePath, 'utf8');
+          // Kodierung erkennen (BOM/Heuristik) und einmal dekodieren
+          const { content, info, hash } = await readTextFile(filePath);
           fileContents[file] = content;
-          console.log(`Datei ${file} erfolgreich gelesen, Inhaltslänge: ${content.length}`);
+          fileEncodings[file] = info;
+          fileHashes[file] = hash;
+          rememberEncoding(file, info);
+          resourceWatcher.prime(file, hash, hashContent(content));
+          console.log(`Datei ${file} erfolgreich gelesen (${info.encoding}${info.bom ? ', BOM' : ''}), Inhaltslänge: ${content.length}`);
         } catch (readError) {
           console.error(`Error reading file ${file}:`, readError);
         }
@@ -497,7 +686,9 @@ function createWindow() {
       
       return {
         success: true,
-        files: fileContents
+        files: fileContents,
+        encodings: fileEncodings,
+        hashes: fileHashes
       };
     } catch (error) {
       console.error('Error loading all resource files:', error);
@@ -508,6 +699,215 @@ function createWindow() {
     }
   });
 
+  // Einzelne Ressourcendatei über einen MessagePort streamen
+  // Der Renderer schickt mit 'open-resource-stream' einen Port; darüber kommen nacheinander
+  // { type: 'chunk', text }, ggf. { type: 'reset' } (Kodierung neu erkannt, bisherige Teile
+  // verwerfen) und zum Schluss { type: 'end', encoding } oder { type: 'error', error }.
+  // Mit withBytes enthält 'end' zusätzlich die Rohdaten (bytes), damit der Renderer sie direkt
+  // scannen kann, statt den Text neu zu kodieren; UTF-16 lässt sich nicht auf Bytes scannen.
+  // Schließt der Renderer den Port vorher, wird das Lesen abgebrochen.
+  ipcMain.on('open-resource-stream', async (event, { fileName, withBytes }) => {
+    const [port] = event.ports;
+    if (!port) return;
+
+    const signal = { aborted: false };
+    port.on('close', () => { signal.aborted = true; });
+    port.start();
+
+    try {
+      const filePath = await findResourceFile(fileName);
+      if (!filePath) {
+        port.postMessage({ type: 'error', error: 'File not found' });
+        port.close();
+        return;
+      }
+
+      const startTime = Date.now();
+      // Zeilen-Hashes nebenbei sammeln: Ausgangsstand für die Ressourcenüberwachung
+      let lineHasher = createLineHasher();
+      const rawChunks = [];
+      const streamed = await streamTextFile(filePath, {
+        onBytes: withBytes ? (chunk) => rawChunks.push(chunk) : undefined,
+        onChunk: (text) => {
+          lineHasher.update(text);
+          port.postMessage({ type: 'chunk', text });
+        },
+        onReset: () => {
+          lineHasher = createLineHasher();
+          rawChunks.length = 0;
+          port.postMessage({ type: 'reset' });
+        },
+        signal
+      });
+
+      if (!streamed) {
+        console.log(`Stream für ${fileName} abgebrochen`);
+        return;
+      }
+
+      const { info, hash } = streamed;
+      rememberEncoding(path.basename(filePath), info);
+      resourceWatcher.prime(path.basename(filePath), hash, lineHasher.digest());
+      const bytes = withBytes && !/^utf-?16/i.test(info.encoding) ? Buffer.concat(rawChunks) : undefined;
+      port.postMessage({ type: 'end', fileName: path.basename(filePath), encoding: info, hash, bytes });
+      port.close();
+      console.log(`Ressource ${path.basename(filePath)} gestreamt (${info.encoding}) in ${Date.now() - startTime}ms`);
+    } catch (error) {
+      console.error(`Error streaming resource ${fileName}:`, error);
+      if (!signal.aborted) {
+        port.postMessage({ type: 'error', error: error.message || 'Unknown error' });
+        port.close();
+      }
+    }
+  });
+
+  // Datei in Teilen über einen MessagePort speichern (große Dateien, siehe public/main/streamWriter.cjs)
+  // Der Renderer schickt nacheinander { type: 'chunk', text } und zum Schluss { type: 'end' };
+  // jeder geschriebene Teil wird mit { type: 'ack' } bestätigt (Flusskontrolle), am Ende kommt
+  // { type: 'done', path, size, hash, unchanged } oder { type: 'error', error }. Schließt der Renderer den
+  // Port vorher, wird abgebrochen und die Zieldatei bleibt unverändert.
+  ipcMain.on('open-save-stream', async (event, { fileName, savePath, options }) => {
+    const [port] = event.ports;
+    if (!port) return;
+
+    let writer = null;
+    let finished = false;
+    // Teile nacheinander abarbeiten, auch wenn sie schneller ankommen als geschrieben wird
+    let queue = Promise.resolve();
+
+    const fail = async (error) => {
+      if (finished) return;
+      finished = true;
+      console.error(`Error streaming save of ${fileName}:`, error);
+      if (writer) await writer.abort();
+      port.postMessage({ type: 'error', error: error.message || 'Unknown error' });
+      port.close();
+    };
+
+    port.on('close', () => {
+      if (finished) return;
+      finished = true;
+      console.log(`Gestreamtes Speichern von ${fileName} abgebrochen`);
+      queue = queue.then(() => writer && writer.abort());
+    });
+
+    port.on('message', ({ data }) => {
+      queue = queue.then(async () => {
+        if (finished) return;
+        try {
+          if (data.type === 'chunk') {
+            await writer.write(data.text);
+            port.postMessage({ type: 'ack' });
+          } else if (data.type === 'end') {
+            const result = await writer.finish();
+            finished = true;
+            resourceWatcher.updateHashes(result.path, result.hash, result.lines);
+            console.log(result.unchanged
+              ? `File unchanged, chunked write discarded: ${result.path} (${result.size} bytes)`
+              : `File saved in chunks (${writer.encodingInfo.encoding}): ${result.path} (${result.size} bytes)`);
+            port.postMessage({ type: 'done', path: result.path, size: result.size, hash: result.hash, unchanged: result.unchanged });
+            port.close();
+          }
+        } catch (error) {
+          await fail(error);
+        }
+      });
+    });
+
+    try {
+      const actualPath = savePath.includes(':\\') || savePath.startsWith('/')
+        ? savePath
+        : path.join(__dirname, '..', savePath);
+      // In der beim Laden erkannten Kodierung schreiben (wie save-file-with-encoding)
+      const encodingInfo = resolveSaveEncoding(fileName || actualPath, options);
+      writer = await openStreamWriter(actualPath, encodingInfo);
+      if (finished) {
+        await writer.abort();
+        return;
+      }
+      port.start();
+    } catch (error) {
+      await fail(error);
+    }
+  });
+
+  // Direkten Kanal zwischen Renderer und Parser-Prozess herstellen: ein Port geht an den
+  // Parser-Prozess, der andere an den Renderer. Anfragen und Antworten (gepackte Zeilen)
+  // laufen danach nicht mehr über den Main-Prozess.
+  ipcMain.on('open-parser-port', (event) => {
+    try {
+      const { port1, port2 } = new MessageChannelMain();
+      getParserProcess().postMessage({ type: 'connect' }, [port1]);
+      event.sender.postMessage('parser-port', null, [port2]);
+    } catch (error) {
+      console.error('Error connecting to parser process:', error);
+    }
+  });
+
+  // Geparste Daten aus dem Parse-Cache lesen (Schlüssel = Inhalts-Hash + Parser-Version)
+  ipcMain.handle('read-parse-cache', async (_, key) => {
+    try {
+      const startTime = Date.now();
+      const data = await readParseCache(app.getPath('userData'), key);
+      if (data === null) {
+        return { success: true, hit: false };
+      }
+      console.log(`Parse-Cache ${key} gelesen in ${Date.now() - startTime}ms`);
+      return { success: true, hit: true, data };
+    } catch (error) {
+      console.error(`Error reading parse cache ${key}:`, error);
+      return { success: false, error: error.message || 'Unknown error' };
+    }
+  });
+
+  // Geparste Daten im Parse-Cache ablegen
+  ipcMain.handle('write-parse-cache', async (_, key, data) => {
+    try {
+      const size = await writeParseCache(app.getPath('userData'), key, data);
+      console.log(`Parse-Cache ${key} geschrieben (${size} Bytes)`);
+      return { success: true, size };
+    } catch (error) {
+      console.error(`Error writing parse cache ${key}:`, error);
+      return { success: false, error: error.message || 'Unknown error' };
+    }
+  });
+
+  // Kompilierte Symboltabelle aus userData/symtab lesen
+  ipcMain.handle('read-symbol-table', async (_, fileName) => {
+    try {
+      const filePath = resolveSymbolTableFile(fileName);
+      if (!fs.existsSync(filePath)) {
+        return { success: false, error: 'File not found' };
+      }
+      
+      const data = await fs.promises.readFile(filePath);
+      return { success: true, data: new Uint8Array(data.buffer, data.byteOffset, data.byteLength) };
+    } catch (error) {
+      console.error(`Error reading symbol table ${fileName}:`, error);
+      return { success: false, error: error.message || 'Unknown error' };
+    }
+  });
+
+  // Kompilierte Symboltabelle nach userData/symtab schreiben (der Ressourcenordner liegt
+  // in der gepackten App im schreibgeschützten asar-Archiv)
+  ipcMain.handle('write-symbol-table', async (_, fileName, data) => {
+    try {
+      const filePath = resolveSymbolTableFile(fileName);
+      const tempPath = `${filePath}.tmp`;
+      
+      // Erst in eine temporäre Datei schreiben, damit nie eine halbe Tabelle liegen bleibt
+      await fs.promises.mkdir(path.dirname(filePath), { recursive: true });
+      await fs.promises.writeFile(tempPath, Buffer.from(data));
+      await fs.promises.rename(tempPath, filePath);
+      
+      console.log(`Symboltabelle gespeichert: ${filePath} (${data.byteLength} Bytes)`);
+      return { success: true, path: filePath };
+    } catch (error) {
+      console.error(`Error writing symbol table ${fileName}:`, error);
+      return { success: false, error: error.message || 'Unknown error' };
+    }
+  });
+
   // Neuer Handler für die Pfadauflösung
   ipcMain.handle('get-resource-path', async (_, subPath) => {
     try {
@@ -580,7 +980,15 @@ function createWindow() {
 }
 
 // This method will be called when Electron has finished initialization
-app.whenReady().then(createWindow);
+app.whenReady().then(async () => {
+  // Einen beim letzten Lauf unterbrochenen Speichervorgang abschließen oder zurückrollen
+  try {
+    await recoverInterruptedSave(app.getPath('userData'));
+  } catch (error) {
+    console.error('Fehler beim Wiederherstellen eines unterbrochenen Speicherns:', error);
+  }
+  createWindow();
+});
 
 // Quit when all windows are closed, except on macOS
 app.on('window-all-closed', () => {
@@ -0,0 +1,367 @@
+// Atomares Speichern mehrerer Dateien mit Commit-Journal (Main-Prozess)
+//
+// Ablauf von saveFilesAtomically:
+//   1. Journal mit Status "writing" und der Liste aller Ziel-/Temp-Dateien schreiben
+//   2. Alle Temp-Dateien parallel schreiben und fsyncen
+//   3. Journal auf "committing" setzen (Commit-Punkt: ab hier sind alle neuen Inhalte auf der Platte)
+//   4. Temp-Dateien per rename auf die Ziele schieben, Verzeichnisse fsyncen
+//   5. Journal löschen
+//
+// Stürzt die App dazwischen ab, räumt recoverInterruptedSave beim nächsten Start auf:
+// "writing" wird zurückgerollt (Temp-Dateien löschen, Ziele sind unverändert),
+// "committing" wird vorwärts abgeschlossen (verbliebene Temp-Dateien umbenennen).
+// So sind z.B. Spec_item.txt, propItem.txt.txt und defineItem.h nie gegeneinander verschoben.
+//
+// Statt eines vollständigen Inhalts kann ein Eintrag auch Byte-Bereiche der Zieldatei ersetzen
+// (edits, z.B. die geänderten Zeilen von propItem.txt.txt). Die Temp-Datei wird dann in Schritt 2
+// im Main-Prozess aus der alten Datei und den neuen Bereichen zusammengesetzt; über IPC kommen
+// nur die Bereiche. Ab da gilt derselbe Ablauf wie für vollständige Inhalte, die Zieldatei wird
+// also auch hier nie an Ort und Stelle überschrieben.
+//
+// Jeder Speichervorgang hat sein eigenes Journal (save-journal-<id>.json) und die Vorgänge
+// laufen nacheinander: ein zweites Speichern kann weder das Journal des ersten überschreiben
+// noch dessen Umbenennungen mit den eigenen verschränken.
+//
+// Hat ein Eintrag einen baseHash, wird vorher (im selben Ablauf) geprüft, ob die Zieldatei noch
+// diesen Stand hat; sonst wird nichts geschrieben (SaveConflictError). So überschreibt ein
+// Speichern keine Änderungen, die inzwischen außerhalb des Editors gemacht wurden.
+const fs = require('fs');
+const path = require('path');
+const crypto = require('crypto');
+
+const JOURNAL_PREFIX = 'save-journal-';
+// Journal älterer Versionen (ein gemeinsames für alle Vorgänge)
+const LEGACY_JOURNAL_FILE = 'save-journal.json';
+
+// Speichervorgänge nacheinander ausführen
+let saveQueue = Promise.resolve();
+
+// Puffergröße beim Kopieren der unveränderten Bereiche
+const COPY_CHUNK_SIZE = 1024 * 1024;
+
+/**
+ * Fehler nach dem Commit-Punkt: die neuen Inhalte sind vollständig auf der Platte, aber nicht
+ * jede Temp-Datei konnte umbenannt werden. Das Journal bleibt liegen; die fehlenden Dateien
+ * werden vor dem nächsten Speichern oder beim nächsten Start vorwärts abgeschlossen.
+ */
+class PartialCommitError extends Error {
+  constructor(renamed, pending, cause) {
+    super(`${pending.length} von ${renamed.length + pending.length} Dateien nach dem Commit nicht umbenannt: ${cause.message}`);
+    this.name = 'PartialCommitError';
+    this.committed = true;
+    // Absolute Zielpfade: bereits ersetzt bzw. noch ausstehend
+    this.renamed = renamed;
+    this.pending = pending;
+    this.cause = cause;
+  }
+}
+
+/**
+ * SHA-1 einer Datei (in Teilen gelesen)
+ * @returns {Promise<string|null>} null, wenn die Datei nicht existiert
+ */
+async function hashFile(filePath) {
+  const hash = crypto.createHash('sha1');
+  try {
+    for await (const chunk of fs.createReadStream(filePath)) {
+      hash.update(chunk);
+    }
+  } catch (error) {
+    if (error.code === 'ENOENT') return null;
+    throw error;
+  }
+  return hash.digest('hex');
+}
+
+async function writeDurable(filePath, data) {
+  const handle = await fs.promises.open(filePath, 'w');
+  try {
+    await handle.writeFile(data);
+    await handle.sync();
+  } finally {
+    await handle.close();
+  }
+}
+
+// Verzeichnis-Einträge (rename) dauerhaft machen; unter Windows nicht möglich und nicht nötig
+async function syncDirectory(dirPath) {
+  if (process.platform === 'win32') return;
+  try {
+    const handle = await fs.promises.open(dirPath, 'r');
+    try {
+      await handle.sync();
+    } finally {
+      await handle.close();
+    }
+  } catch (error) {
+    console.warn(`Verzeichnis ${dirPath} konnte nicht synchronisiert werden:`, error.message);
+  }
+}
+
+async function writeJournal(journalPath, journal) {
+  const tempPath = `${journalPath}.tmp`;
+  await writeDurable(tempPath, JSON.stringify(journal, null, 2));
+  await fs.promises.rename(tempPath, journalPath);
+  await syncDirectory(path.dirname(journalPath));
+}
+
+async function removeIfExists(filePath) {
+  try {
+    await fs.promises.unlink(filePath);
+  } catch (error) {
+    if (error.code !== 'ENOENT') throw error;
+  }
+}
+
+/**
+ * Eine Zieldatei entspricht nicht mehr dem Stand, auf dem die neuen Inhalte beruhen
+ */
+class SaveConflictError extends Error {
+  constructor(filePath) {
+    super(`${path.basename(filePath)} wurde seit dem Laden außerhalb des Editors geändert`);
+    this.name = 'SaveConflictError';
+    this.conflict = true;
+    this.path = filePath;
+  }
+}
+
+/**
+ * Setzt die neue Datei aus der alten und den geänderten Bereichen in einer Temp-Datei zusammen
+ * Unveränderte Bereiche werden in Teilen kopiert; der SHA-1 entsteht beim Schreiben.
+ * @param {Array<{ from: number, to: number, data: Buffer }>} edits Aufsteigend, Offsets der alten Datei
+ * @returns {Promise<{ size: number, hash: string }>}
+ */
+async function writePatched(tempPath, sourcePath, edits) {
+  const hash = crypto.createHash('sha1');
+  let size = 0;
+  const source = await fs.promises.open(sourcePath, 'r');
+  try {
+    const target = await fs.promises.open(tempPath, 'w');
+    try {
+      const write = async (data) => {
+        hash.update(data);
+        for (let written = 0; written < data.length;) {
+          written += (await target.write(data, written, data.length - written)).bytesWritten;
+        }
+        size += data.length;
+      };
+      const buffer = Buffer.allocUnsafe(COPY_CHUNK_SIZE);
+      const copy = async (from, to) => {
+        for (let pos = from; pos < to;) {
+          const { bytesRead } = await source.read(buffer, 0, Math.min(buffer.length, to - pos), pos);
+          if (bytesRead === 0) throw new Error(`${path.basename(sourcePath)} ist kürzer als erwartet`);
+          await write(buffer.subarray(0, bytesRead));
+          pos += bytesRead;
+        }
+      };
+
+      let pos = 0;
+      for (const edit of edits) {
+        await copy(pos, edit.from);
+        await write(edit.data);
+        pos = edit.to;
+      }
+      await copy(pos, (await source.stat()).size);
+      await target.sync();
+    } finally {
+      await target.close();
+    }
+  } finally {
+    await source.close();
+  }
+  return { size, hash: hash.digest('hex') };
+}
+
+// Eine Datei des Vorgangs abschließen: Temp-Datei umbenennen
+async function finishFile(file) {
+  try {
+    await fs.promises.rename(file.temp, file.target);
+  } catch (error) {
+    // Bereits umbenannt (z.B. bei der Wiederherstellung nach einem Absturz)
+    if (error.code === 'ENOENT' && !fs.existsSync(file.temp)) return;
+    throw error;
+  }
+}
+
+// Alle Dateien des Vorgangs abschließen; ein Fehlschlag wird einmal wiederholt
+// (unter Windows kann ein Virenscanner oder Editor die Zieldatei kurz sperren)
+async function renameAll(files) {
+  const renamed = [];
+  const pending = [];
+  let lastError = null;
+
+  for (const file of files) {
+    try {
+      await finishFile(file);
+      renamed.push(file.target);
+    } catch (error) {
+      try {
+        await new Promise(resolve => setTimeout(resolve, 100));
+        await finishFile(file);
+        renamed.push(file.target);
+      } catch (retryError) {
+        lastError = retryError;
+        pending.push(file.target);
+      }
+    }
+  }
+
+  const directories = new Set(files.map(file => path.dirname(file.target)));
+  await Promise.all(Array.from(directories, syncDirectory));
+  return { renamed, pending, error: lastError };
+}
+
+// Journal-Dateien im Verzeichnis (auch das gemeinsame Journal älterer Versionen);
+// halb geschriebene Journale (.tmp) werden gelöscht, zu ihnen gab es keinen Commit
+async function listJournals(journalDir) {
+  let names;
+  try {
+    names = await fs.promises.readdir(journalDir);
+  } catch (error) {
+    if (error.code === 'ENOENT') return [];
+    throw error;
+  }
+  const isJournal = name => name === LEGACY_JOURNAL_FILE || (name.startsWith(JOURNAL_PREFIX) && name.endsWith('.json'));
+
+  await Promise.all(names
+    .filter(name => name.endsWith('.tmp') && isJournal(name.slice(0, -4)))
+    .map(name => removeIfExists(path.join(journalDir, name)).catch(() => {})));
+
+  return names.filter(isJournal).map(name => path.join(journalDir, name));
+}
+
+/**
+ * Schließt die Vorgänge eines Journals ab
+ * @returns {Promise<'rolled-back'|'rolled-forward'>}
+ */
+async function recoverJournal(journalPath) {
+  let journal;
+  try {
+    journal = JSON.parse(await fs.promises.readFile(journalPath, 'utf8'));
+  } catch (error) {
+    // Unlesbares Journal: es wurde nie vollständig geschrieben, also gab es keinen Commit
+    console.error(`Speicher-Journal ${path.basename(journalPath)} beschädigt, wird verworfen:`, error);
+    await removeIfExists(journalPath);
+    return 'rolled-back';
+  }
+
+  const files = Array.isArray(journal.files) ? journal.files : [];
+
+  if (journal.state === 'committing') {
+    const { pending, error } = await renameAll(files);
+    if (pending.length > 0) {
+      // Journal behalten, der nächste Versuch macht weiter
+      throw new PartialCommitError(files.map(file => file.target).filter(target => !pending.includes(target)), pending, error);
+    }
+    await removeIfExists(journalPath);
+    console.log(`Unterbrochenes Speichern ${journal.id} abgeschlossen (${files.length} Dateien)`);
+    return 'rolled-forward';
+  }
+
+  await Promise.all(files.map(file => removeIfExists(file.temp)));
+  await removeIfExists(journalPath);
+  console.log(`Unterbrochenes Speichern ${journal.id} zurückgerollt (${files.length} Dateien unverändert)`);
+  return 'rolled-back';
+}
+
+async function recoverJournals(journalDir) {
+  const results = [];
+  for (const journalPath of await listJournals(journalDir)) {
+    results.push(await recoverJournal(journalPath));
+  }
+  return results;
+}
+
+async function commitFiles(entries, journalDir) {
+  // Liegengebliebene Vorgänge zuerst abschließen, damit ein älterer Stand nicht später
+  // über diesen Vorgang geschrieben wird
+  try {
+    await recoverJournals(journalDir);
+  } catch (error) {
+    // Dieser Vorgang hat noch nichts geschrieben; kein PartialCommitError weiterreichen
+    throw new Error(`Vorheriges Speichern noch nicht abgeschlossen: ${error.message}`);
+  }
+
+  for (const entry of entries) {
+    if (entry.baseHash && await hashFile(entry.path) !== entry.baseHash) {
+      throw new SaveConflictError(entry.path);
+    }
+  }
+
+  const id = `${Date.now().toString(36)}-${crypto.randomBytes(4).toString('hex')}`;
+  const journalPath = path.join(journalDir, `${JOURNAL_PREFIX}${id}.json`);
+  const files = entries.map(entry => ({ target: entry.path, temp: `${entry.path}.${id}.tmp` }));
+  // Größe und SHA-1 der zusammengesetzten Dateien (edits)
+  const patched = new Array(entries.length);
+
+  await fs.promises.mkdir(journalDir, { recursive: true });
+  await writeJournal(journalPath, { id, state: 'writing', startedAt: new Date().toISOString(), files });
+
+  try {
+    await Promise.all(entries.map(async (entry, index) => {
+      if (entry.edits) {
+        patched[index] = await writePatched(files[index].temp, entry.path, entry.edits);
+      } else {
+        await fs.promises.mkdir(path.dirname(entry.path), { recursive: true });
+        await writeDurable(files[index].temp, entry.data);
+      }
+    }));
+    await writeJournal(journalPath, { id, state: 'committing', startedAt: new Date().toISOString(), files });
+  } catch (error) {
+    // Vor dem Commit-Punkt: zurückrollen, die Zieldateien wurden nicht angefasst
+    await Promise.all(files.map(file => removeIfExists(file.temp).catch(() => {})));
+    await removeIfExists(journalPath).catch(() => {});
+    throw error;
+  }
+
+  // Ab hier wird nur noch vorwärts abgeschlossen
+  const { renamed, pending, error } = await renameAll(files);
+  if (pending.length > 0) {
+    throw new PartialCommitError(renamed, pending, error);
+  }
+
+  await removeIfExists(journalPath);
+
+  return Promise.all(entries.map(async (entry, index) => patched[index]
+    ? { path: entry.path, ...patched[index] }
+    : { path: entry.path, size: (await fs.promises.stat(entry.path)).size }));
+}
+
+/**
+ * Schreibt mehrere Dateien als eine Einheit: entweder alle neuen Inhalte oder keiner
+ * Schlägt nach dem Commit-Punkt ein rename fehl, wird ein PartialCommitError mit den bereits
+ * ersetzten (renamed) und den noch ausstehenden Zielen (pending) geworfen.
+ * @param {Array<{ path: string, data?: Buffer, edits?: Array<{ from: number, to: number, data: Buffer }>, baseHash?: string }>} entries
+ *   Absolute Zielpfade mit vollständigem Inhalt (data) oder mit zu ersetzenden Bereichen (edits,
+ *   aufsteigend, Offsets [from, to) der bisherigen Datei);
+ *   baseHash: SHA-1, den die Zieldatei vorher haben muss (sonst SaveConflictError)
+ * @param {string} journalDir Verzeichnis für das Commit-Journal (z.B. userData)
+ * @returns {Promise<Array<{ path: string, size: number, hash?: string }>>} hash nur für edits
+ */
+function saveFilesAtomically(entries, journalDir) {
+  const run = saveQueue.then(() => commitFiles(entries, journalDir));
+  saveQueue = run.catch(() => {});
+  return run;
+}
+
+/**
+ * Schließt unterbrochene Speichervorgänge ab (beim App-Start aufrufen)
+ * @param {string} journalDir
+ * @returns {Promise<'none'|'rolled-back'|'rolled-forward'>} Ergebnis des letzten Vorgangs
+ */
+function recoverInterruptedSave(journalDir) {
+  const run = saveQueue.then(async () => {
+    const results = await recoverJournals(journalDir);
+    return results.length > 0 ? results[results.length - 1] : 'none';
+  });
+  saveQueue = run.catch(() => {});
+  return run;
+}
+
+module.exports = {
+  saveFilesAtomically,
+  recoverInterruptedSave,
+  hashFile,
+  PartialCommitError,
+  SaveConflictError
+};
@@ -0,0 +1,148 @@
+// Zeilenbasierte Patches auf Ressourcendateien anwenden (Main-Prozess)
+//
+// Statt beim Speichern den kompletten Dateitext über IPC zu schicken, sendet der Renderer
+// nur die geänderten Zeilenbereiche zusammen mit dem SHA-1 der Datei, auf der seine
+// Änderungen beruhen. Passt der Hash nicht mehr zur Datei auf der Platte (extern
+// geändert, anders gespeichert), wird der Patch als Konflikt abgelehnt; der Renderer
+// meldet ihn, statt die Datei zu überschreiben.
+//
+// planFilePatch übersetzt den Patch in Byte-Bereiche der alten Datei; geschrieben wird er wie
+// alle anderen Dateien eines Speichervorgangs über atomicSave.cjs, das die neue Datei aus der
+// alten und den Bereichen in einer Temp-Datei zusammensetzt und sie dann umbenennt: ein Absturz
+// hinterlässt entweder die alte oder die neue Datei, nie eine halb überschriebene. Den Hash
+// prüft atomicSave unmittelbar vor dem Schreiben erneut und liefert den SHA-1 der neuen Datei.
+//
+// Ein Hunk { start, end, text } ersetzt die Zeilen [start, end) der Basis durch text.
+// Zeilen sind durch "\n" getrennt (wie content.split('\n')), "\r" gehört zur Zeile;
+// der Bereich umfasst die Zeilenumbrüche, Zeile lineCount steht für das Dateiende.
+const fs = require('fs');
+const crypto = require('crypto');
+const { detectEncoding, encodeText, getRememberedEncoding, normalizeEncoding } = require('./textEncoding.cjs');
+const { hashFile } = require('./atomicSave.cjs');
+
+const sha1 = (buffer) => crypto.createHash('sha1').update(buffer).digest('hex');
+
+// Byte-Offset des BOM-Endes
+function bomLength(buffer, encoding) {
+  if (encoding === 'utf-8' && buffer[0] === 0xEF && buffer[1] === 0xBB && buffer[2] === 0xBF) return 3;
+  if (encoding === 'utf-16le' && buffer[0] === 0xFF && buffer[1] === 0xFE) return 2;
+  if (encoding === 'utf-16be' && buffer[0] === 0xFE && buffer[1] === 0xFF) return 2;
+  return 0;
+}
+
+/**
+ * Byte-Offsets der Zeilenanfänge; der letzte Eintrag ist das Dateiende
+ * @returns {number[]} Länge = Zeilenzahl + 1
+ */
+function indexLineStarts(buffer, encoding) {
+  const starts = [bomLength(buffer, encoding)];
+
+  if (encoding === 'utf-16le' || encoding === 'utf-16be') {
+    const low = encoding === 'utf-16le' ? 0 : 1;
+    for (let i = starts[0]; i + 1 < buffer.length; i += 2) {
+      if (buffer[i + low] === 0x0A && buffer[i + 1 - low] === 0x00) starts.push(i + 2);
+    }
+  } else {
+    // In UTF-8, Windows-1252 und CP949 kommt 0x0A nur als Zeilenumbruch vor
+    let pos = buffer.indexOf(0x0A, starts[0]);
+    while (pos !== -1) {
+      starts.push(pos + 1);
+      pos = buffer.indexOf(0x0A, pos + 1);
+    }
+  }
+
+  starts.push(buffer.length);
+  return starts;
+}
+
+/**
+ * Hunks in Byte-Bereiche übersetzen
+ * @param {Array<{ start: number, end: number, text: string }>} hunks Aufsteigend, nicht überlappend
+ * @param {(line: number) => number} offsetOf Byte-Offset eines Zeilenanfangs (lineCount: Dateiende)
+ * @returns {Array<{ from: number, to: number, data: Buffer }>|null} null bei ungültigen Hunks
+ */
+function hunksToEdits(hunks, lineCount, encoding, offsetOf) {
+  const edits = [];
+  let previousEnd = 0;
+  for (const hunk of hunks) {
+    if (hunk.start < previousEnd || hunk.end < hunk.start || hunk.end > lineCount) return null;
+    previousEnd = hunk.end;
+    edits.push({
+      from: offsetOf(hunk.start),
+      to: offsetOf(hunk.end),
+      data: encodeText(hunk.text, { encoding, bom: false })
+    });
+  }
+  return edits;
+}
+
+/**
+ * Bereitet einen Patch für das Speichern vor
+ * @param {string} filePath
+ * @param {{ baseHash: string, baseLineCount: number, hunks: Array<{ start: number, end: number, text: string }> }} patch
+ * @returns {Promise<{ success: boolean, conflict?: boolean, unchanged?: boolean, edits?: Array<{ from: number, to: number, data: Buffer }>, size?: number, hash?: string, error?: string }>}
+ *   edits für atomicSave; size/hash nur bei unchanged (die Datei bleibt wie sie ist)
+ */
+async function planFilePatch(filePath, patch) {
+  let buffer;
+  try {
+    buffer = await fs.promises.readFile(filePath);
+  } catch (error) {
+    if (error.code === 'ENOENT') return { success: false, conflict: true, error: 'File not found' };
+    throw error;
+  }
+
+  if (sha1(buffer) !== patch.baseHash) {
+    return { success: false, conflict: true, error: 'Base hash mismatch' };
+  }
+
+  const remembered = getRememberedEncoding(filePath);
+  const info = remembered || detectEncoding(buffer);
+  const encoding = normalizeEncoding(info.encoding);
+  const starts = indexLineStarts(buffer, encoding);
+  const lineCount = starts.length - 1;
+
+  if (lineCount !== patch.baseLineCount) {
+    return { success: false, conflict: true, error: `Line count mismatch (${lineCount} != ${patch.baseLineCount})` };
+  }
+
+  const edits = hunksToEdits(patch.hunks, lineCount, encoding, line => starts[line]);
+  if (!edits) {
+    return { success: false, error: 'Invalid hunks' };
+  }
+
+  // Nichts oder nur gleiche Bytes zu schreiben: Datei nicht anfassen
+  if (edits.every(edit => edit.data.equals(buffer.subarray(edit.from, edit.to)))) {
+    return { success: true, unchanged: true, hash: patch.baseHash, size: buffer.length };
+  }
+
+  return { success: true, edits };
+}
+
+/**
+ * Hat die Datei auf der Platte genau diese Bytes? Vergleicht zuerst die Größe, dann den SHA-1
+ * der in Teilen gelesenen Datei. Damit wird ein Speichern ohne Änderung erkannt und übersprungen.
+ * @param {string} filePath
+ * @param {number} size Länge der neuen Bytes
+ * @param {string} hash SHA-1 der neuen Bytes
+ * @returns {Promise<boolean>}
+ */
+async function fileMatchesHash(filePath, size, hash) {
+  let stats;
+  try {
+    stats = await fs.promises.stat(filePath);
+  } catch (error) {
+    if (error.code === 'ENOENT') return false;
+    throw error;
+  }
+  if (!stats.isFile() || stats.size !== size) return false;
+  return await hashFile(filePath) === hash;
+}
+
+module.exports = {
+  planFilePatch,
+  hunksToEdits,
+  fileMatchesHash,
+  indexLineStarts,
+  sha1
+};
@@ -0,0 +1,89 @@
+// Parse-Cache auf der Platte (Main-Prozess)
+//
+// Geparste Ressourcendaten werden unter einem Schlüssel aus Inhalts-Hash und
+// Parser-Version in userData/parse-cache abgelegt, serialisiert mit v8.serialize
+// (Typed Arrays des Spaltenspeichers bleiben binär, kein JSON). Ein Eintrag ist gültig,
+// solange sich Inhalt und Parser nicht ändern; es gibt kein Ablaufdatum. Nur die
+// zuletzt benutzten MAX_ENTRIES Einträge bleiben erhalten.
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const crypto = require('crypto');
+
+const CACHE_DIR = 'parse-cache';
+const MAX_ENTRIES = 8;
+const KEY_PATTERN = /^[A-Za-z0-9._-]{1,200}$/;
+
+function entryPath(baseDir, key) {
+  if (!KEY_PATTERN.test(key)) {
+    throw new Error(`Ungültiger Cache-Schlüssel: ${key}`);
+  }
+  return path.join(baseDir, CACHE_DIR, `${key}.v8`);
+}
+
+/**
+ * Liest einen Eintrag
+ * @param {string} baseDir Basisverzeichnis (userData)
+ * @param {string} key Schlüssel aus Inhalts-Hash und Parser-Version
+ * @returns {Promise<any | null>} Der gespeicherte Wert oder null
+ */
+async function readParseCache(baseDir, key) {
+  const filePath = entryPath(baseDir, key);
+  let buffer;
+  try {
+    buffer = await fs.promises.readFile(filePath);
+  } catch (error) {
+    if (error.code === 'ENOENT') return null;
+    throw error;
+  }
+
+  try {
+    const value = v8.deserialize(buffer);
+    // Zugriffszeit für die Verdrängung merken
+    const now = new Date();
+    fs.promises.utimes(filePath, now, now).catch(() => {});
+    return value;
+  } catch (error) {
+    // Beschädigt oder von einer anderen V8-Version geschrieben
+    console.warn(`Parse-Cache ${key} unlesbar, wird verworfen:`, error.message);
+    await fs.promises.unlink(filePath).catch(() => {});
+    return null;
+  }
+}
+
+/**
+ * Schreibt einen Eintrag (über eine Temp-Datei, damit nie ein halber Eintrag liegen bleibt)
+ * @returns {Promise<number>} Größe in Bytes
+ */
+async function writeParseCache(baseDir, key, value) {
+  const filePath = entryPath(baseDir, key);
+  const data = v8.serialize(value);
+  const tempPath = `${filePath}.${crypto.randomBytes(4).toString('hex')}.tmp`;
+
+  await fs.promises.mkdir(path.dirname(filePath), { recursive: true });
+  await fs.promises.writeFile(tempPath, data);
+  await fs.promises.rename(tempPath, filePath);
+  await pruneParseCache(baseDir);
+  return data.length;
+}
+
+// Nur die zuletzt benutzten Einträge behalten
+async function pruneParseCache(baseDir) {
+  const dir = path.join(baseDir, CACHE_DIR);
+  const names = (await fs.promises.readdir(dir)).filter(name => name.endsWith('.v8'));
+  if (names.length <= MAX_ENTRIES) return;
+
+  const entries = await Promise.all(names.map(async name => ({
+    name,
+    mtimeMs: (await fs.promises.stat(path.join(dir, name))).mtimeMs
+  })));
+  entries.sort((a, b) => b.mtimeMs - a.mtimeMs);
+  await Promise.all(entries.slice(MAX_ENTRIES).map(entry =>
+    fs.promises.unlink(path.join(dir, entry.name)).catch(() => {})
+  ));
+}
+
+module.exports = {
+  readParseCache,
+  writeParseCache
+};
@@ -0,0 +1,97 @@
+// Parser-Prozess (Electron utilityProcess)
+//
+// Liest, dekodiert und scannt Ressourcendateien außerhalb des Renderers. Der Main-Prozess
+// reicht für jedes Fenster einen MessagePort durch (connect); darüber stellt der Renderer
+// Anfragen der Form { id, type, ... } und erhält { id, result } oder { id, error }:
+//   scan { fileName } -> ganze Datei gescannt, siehe scanFile
+//
+// Nach einem scan meldet der Prozess dem Main-Prozess { type: 'loaded', fileName, hash,
+// encoding, lines }: Kodierung für das Speichern und Ausgangsstand für die Ressourcenüberwachung,
+// wie beim Laden über open-resource-stream.
+const fs = require('fs');
+const path = require('path');
+const { readTextFile } = require('./textEncoding.cjs');
+const { scanTabSeparated } = require('./tabScanner.cjs');
+const { hashContent } = require('./resourceWatcher.cjs');
+
+const textEncoder = new TextEncoder();
+
+const resourceFolder = process.argv[2];
+
+async function resolveFile(fileName) {
+  const filePath = path.resolve(resourceFolder, fileName);
+  if (!fileName || path.isAbsolute(fileName) || !filePath.startsWith(resourceFolder + path.sep)) {
+    throw new Error(`Ungültiger Ressourcenpfad: ${fileName}`);
+  }
+  if (fs.existsSync(filePath)) return filePath;
+
+  const match = (await fs.promises.readdir(path.dirname(filePath)))
+    .find(name => name.toLowerCase() === path.basename(filePath).toLowerCase());
+  if (!match) throw new Error(`Datei nicht gefunden: ${fileName}`);
+  return path.join(path.dirname(filePath), match);
+}
+
+/**
+ * Liest, dekodiert und scannt eine tab-getrennte Datei mit Kopfzeile (Spec_item.txt) für das
+ * Laden im Renderer. Alle Daten liegen in einem ArrayBuffer: zuerst die Offset-Arrays
+ * (rowLines, rowCells, cellStarts, cellEnds als Uint32), dann der Inhalt als UTF-8 (ohne BOM).
+ * Die Offsets beziehen sich auf diese UTF-8-Bytes, gescannt wird ab der Zeile nach der Kopfzeile.
+ * @returns {{ fileName, hash, encoding, lineCount, rowCount, cellCount, byteLength, buffer: ArrayBuffer }}
+ */
+async function scanFile(fileName) {
+  const filePath = await resolveFile(fileName);
+  const startTime = Date.now();
+  const { content, info, hash } = await readTextFile(filePath);
+  const bytes = textEncoder.encode(content);
+  const headerEnd = bytes.indexOf(10);
+  const table = scanTabSeparated(bytes, headerEnd === -1 ? bytes.length : headerEnd + 1);
+
+  const rowCount = table.rowLines.length;
+  const cellCount = table.cellStarts.length;
+  const offsetCount = rowCount + (rowCount + 1) + cellCount * 2;
+  const buffer = new ArrayBuffer(offsetCount * 4 + bytes.length);
+  const offsets = new Uint32Array(buffer, 0, offsetCount);
+  offsets.set(table.rowLines, 0);
+  offsets.set(table.rowCells, rowCount);
+  offsets.set(table.cellStarts, rowCount * 2 + 1);
+  offsets.set(table.cellEnds, rowCount * 2 + 1 + cellCount);
+  new Uint8Array(buffer, offsetCount * 4).set(bytes);
+
+  const baseName = path.basename(filePath);
+  process.parentPort.postMessage({ type: 'loaded', fileName: baseName, hash, encoding: info, lines: hashContent(content) });
+  console.log(`Parser-Prozess: ${baseName} gescannt, ${rowCount} Zeilen, ${cellCount} Zellen in ${Date.now() - startTime}ms`);
+
+  return { fileName: baseName, hash, encoding: info, lineCount: table.lineCount, rowCount, cellCount, byteLength: bytes.length, buffer };
+}
+
+async function handleRequest(request) {
+  switch (request.type) {
+    case 'scan':
+      return scanFile(request.fileName);
+    default:
+      throw new Error(`Unbekannte Anfrage: ${request.type}`);
+  }
+}
+
+function servePort(port) {
+  port.on('message', async ({ data }) => {
+    if (!data || data.id === undefined) return;
+    try {
+      // Typed Arrays und ArrayBuffer gehen als Ganzes (ohne Umwandlung in Listen) an den Renderer.
+      // Eine Transferliste nimmt MessagePortMain nur für Ports an; über die Prozessgrenze wird der
+      // Puffer ohnehin einmal kopiert
+      port.postMessage({ id: data.id, result: await handleRequest(data) });
+    } catch (error) {
+      port.postMessage({ id: data.id, error: error.message || String(error) });
+    }
+  });
+  port.start();
+}
+
+process.parentPort.on('message', (event) => {
+  if (event.data && event.data.type === 'connect' && event.ports[0]) {
+    servePort(event.ports[0]);
+  }
+});
+
+console.log(`Parser-Prozess gestartet (Ressourcenordner: ${resourceFolder})`);
@@ -0,0 +1,337 @@
+// Zeilenindex von propItem.txt.txt mit sortierten IDS_PROPITEM_TXT_*-Nummern (Main-Prozess)
+//
+// Beim Speichern übernimmt save-all-files die geänderten Einträge (ID -> Text) in die Datei
+// auf der Platte. Statt die 1,8 MB dafür jedes Mal neu zu lesen, zu parsen und komplett zu
+// sortieren, hält der Index für jede Zeile der Datei ihre Länge in Bytes und ihre ID (erste
+// Zelle vor dem Tab); die Nummern der IDs liegen sortiert vor. Ein Merge kostet so viel wie
+// die geänderten Einträge: vorhandene Einträge werden in ihrer Zeile ersetzt, neue IDs nach
+// der Zeile der nächstkleineren Nummer eingefügt. Alle übrigen Zeilen (auch Kommentare und
+// Zeilen ohne "ID\tWert") bleiben byte-genau erhalten.
+//
+// Die Byte-Offsets der Zeilen sind Präfixsummen ihrer Längen. Nach einer Änderung werden sie
+// erst beim nächsten Zugriff und nur ab der ersten geänderten Zeile neu berechnet; an das
+// Dateiende angehängte Einträge kosten also fast nichts.
+//
+// Geschrieben wird nicht hier, sondern über atomicSave.cjs: planWrite liefert die geänderten
+// Byte-Bereiche, commit übernimmt sie nach dem Speichern in den Index.
+const fs = require('fs');
+const { detectEncoding, encodeText, getRememberedEncoding, normalizeEncoding } = require('./textEncoding.cjs');
+const { hunksToEdits, indexLineStarts, sha1 } = require('./filePatch.cjs');
+
+const KEY_PATTERN = /IDS_PROPITEM_TXT_(\d+)/;
+
+// Erste Zelle einer Zeile (getrimmt) oder null, wenn die Zeile keinen Tab enthält
+function lineKey(line) {
+  const tab = line.indexOf('\t');
+  return tab === -1 ? null : line.slice(0, tab).trim();
+}
+
+function keyNumber(key) {
+  const match = key ? KEY_PATTERN.exec(key) : null;
+  return match ? parseInt(match[1], 10) : null;
+}
+
+/**
+ * Ersetzt den Text (zweite Zelle) einer Zeile; weitere Zellen und das Zeilenende bleiben erhalten
+ * @returns undefined, wenn der Text bis auf Leerraum gleich ist (die Parser trimmen die Werte)
+ */
+function replaceValue(line, value) {
+  let end = line.length;
+  if (end > 0 && line.charCodeAt(end - 1) === 10) end--;
+  if (end > 0 && line.charCodeAt(end - 1) === 13) end--;
+
+  const tab = line.indexOf('\t');
+  if (tab === -1 || tab >= end) return undefined;
+  let valueEnd = line.indexOf('\t', tab + 1);
+  if (valueEnd === -1 || valueEnd > end) valueEnd = end;
+  if (line.slice(tab + 1, valueEnd).trim() === value.trim()) return undefined;
+
+  return line.slice(0, tab + 1) + value + line.slice(valueEnd);
+}
+
+// Erste Position in einem aufsteigend sortierten Array mit Wert >= value
+function lowerBound(values, value) {
+  let low = 0;
+  let high = values.length;
+  while (low < high) {
+    const mid = (low + high) >>> 1;
+    if (values[mid] < value) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+class PropItemIndex {
+  constructor(filePath, encodingInfo) {
+    this.filePath = filePath;
+    this.encoding = normalizeEncoding(encodingInfo.encoding);
+    this.bomLength = 0;
+    this.decoder = new TextDecoder(this.encoding);
+
+    // Zeilen in Dateireihenfolge: { key, length (Bytes inkl. Zeilenumbruch), line, offset }
+    // line/offset sind ab validFrom veraltet (siehe ensureOffsets)
+    this.lines = [];
+    this.validFrom = 0;
+    // ID -> Zeilen (bei doppelten IDs mehrere)
+    this.byKey = new Map();
+    // Sortierte Nummern der IDS_PROPITEM_TXT_*-IDs und ihre Zeilen
+    this.numbers = [];
+    this.byNumber = new Map();
+
+    this.eol = '\r\n';
+    this.size = 0;
+    this.hash = null;
+    this.fileStat = null;
+  }
+
+  /**
+   * Index aus den Bytes der Datei und ihrem dekodierten Inhalt aufbauen
+   */
+  load(buffer, content) {
+    const starts = indexLineStarts(buffer, this.encoding);
+    const records = [];
+    let lineStart = 0;
+    for (let i = 0; i + 1 < starts.length; i++) {
+      const newline = content.indexOf('\n', lineStart);
+      const lineEnd = newline === -1 ? content.length : newline;
+      records.push({ key: lineKey(content.slice(lineStart, lineEnd)), length: starts[i + 1] - starts[i], line: i, offset: starts[i] });
+      lineStart = lineEnd + 1;
+    }
+    if (records.length !== starts.length - 1 || lineStart !== content.length + 1) {
+      throw new Error(`Zeilen von ${this.filePath} passen nicht zu den Bytes`);
+    }
+
+    this.bomLength = starts[0];
+    this.lines = records;
+    this.validFrom = records.length;
+    records.forEach(record => this.addKey(record));
+
+    const newline = content.indexOf('\n');
+    if (newline !== -1) this.eol = newline > 0 && content.charCodeAt(newline - 1) === 13 ? '\r\n' : '\n';
+    this.size = buffer.length;
+    this.hash = sha1(buffer);
+  }
+
+  addKey(record) {
+    if (!record.key) return;
+    const records = this.byKey.get(record.key);
+    if (records) records.push(record);
+    else this.byKey.set(record.key, [record]);
+
+    const number = keyNumber(record.key);
+    if (number === null) return;
+    const numbered = this.byNumber.get(number);
+    if (numbered) {
+      numbered.push(record);
+    } else {
+      this.byNumber.set(number, [record]);
+      this.numbers.splice(lowerBound(this.numbers, number), 0, number);
+    }
+  }
+
+  removeKey(record) {
+    if (!record.key) return;
+    const records = this.byKey.get(record.key);
+    records.splice(records.indexOf(record), 1);
+    if (records.length === 0) this.byKey.delete(record.key);
+
+    const number = keyNumber(record.key);
+    if (number === null) return;
+    const numbered = this.byNumber.get(number);
+    numbered.splice(numbered.indexOf(record), 1);
+    if (numbered.length === 0) {
+      this.byNumber.delete(number);
+      this.numbers.splice(lowerBound(this.numbers, number), 1);
+    }
+  }
+
+  // Zeilennummern und Byte-Offsets ab der ersten geänderten Zeile neu berechnen
+  ensureOffsets() {
+    if (this.validFrom >= this.lines.length) return;
+    const previous = this.lines[this.validFrom - 1];
+    let offset = previous ? previous.offset + previous.length : this.bomLength;
+    for (let i = this.validFrom; i < this.lines.length; i++) {
+      const record = this.lines[i];
+      record.line = i;
+      record.offset = offset;
+      offset += record.length;
+    }
+    this.validFrom = this.lines.length;
+  }
+
+  // Byte-Offset des Zeilenanfangs (lines.length: Dateiende)
+  offsetOf(line) {
+    this.ensureOffsets();
+    return line < this.lines.length ? this.lines[line].offset : this.size;
+  }
+
+  async readLine(handle, record) {
+    const buffer = Buffer.alloc(record.length);
+    await handle.read(buffer, 0, record.length, record.offset);
+    return this.decoder.decode(buffer);
+  }
+
+  // Zeile, vor der eine neue Nummer eingefügt wird: nach der letzten Zeile der nächstkleineren
+  // Nummer, sonst vor der ersten Zeile der nächstgrößeren; ohne Einträge am Dateiende
+  insertionLine(number) {
+    const position = lowerBound(this.numbers, number);
+    if (position > 0) {
+      return Math.max(...this.byNumber.get(this.numbers[position - 1]).map(record => record.line)) + 1;
+    }
+    if (position < this.numbers.length) {
+      return Math.min(...this.byNumber.get(this.numbers[position]).map(record => record.line));
+    }
+    const last = this.lines[this.lines.length - 1];
+    return last.length === 0 ? this.lines.length - 1 : this.lines.length;
+  }
+
+  /**
+   * Hunks (wie filePatch.cjs), die die Einträge in die Datei übernehmen; ändert den Index nicht
+   * @param {Array<[string, string]>} entries ID -> Text
+   * @returns {Promise<{ hunks: Array<{ start: number, end: number, text: string }>, changed: number, inserted: number }>}
+   */
+  async planMerge(entries) {
+    this.ensureOffsets();
+    const hunks = [];
+    const inserts = new Map();
+    let changed = 0;
+    let inserted = 0;
+
+    const handle = await fs.promises.open(this.filePath, 'r');
+    try {
+      for (const [key, value] of entries) {
+        const records = this.byKey.get(key);
+        if (records) {
+          for (const record of records) {
+            const text = replaceValue(await this.readLine(handle, record), value);
+            if (text === undefined) continue;
+            hunks.push({ start: record.line, end: record.line + 1, text });
+            changed++;
+          }
+          continue;
+        }
+
+        const number = keyNumber(key) ?? Infinity;
+        const line = this.insertionLine(number);
+        if (!inserts.has(line)) inserts.set(line, []);
+        inserts.get(line).push({ number, text: `${key}\t${value}` });
+        inserted++;
+      }
+
+      const lastLine = this.lines.length - 1;
+      for (const [line, items] of inserts) {
+        items.sort((a, b) => a.number - b.number);
+        const block = items.map(item => item.text);
+
+        if (line < this.lines.length) {
+          hunks.push({ start: line, end: line, text: block.map(text => text + this.eol).join('') });
+          continue;
+        }
+
+        // Nach der letzten Zeile ohne Zeilenumbruch: diese Zeile bekommt einen
+        const edited = hunks.find(hunk => hunk.start === lastLine && hunk.end === lastLine + 1);
+        const lastText = edited ? edited.text : await this.readLine(handle, this.lines[lastLine]);
+        const text = lastText + this.eol + block.join(this.eol);
+        if (edited) edited.text = text;
+        else hunks.push({ start: lastLine, end: lastLine + 1, text });
+      }
+    } finally {
+      await handle.close();
+    }
+
+    hunks.sort((a, b) => a.start - b.start || a.end - b.end);
+    return { hunks, changed, inserted };
+  }
+
+  /**
+   * Zu ersetzende Byte-Bereiche für Hunks aus planMerge (für atomicSave.cjs)
+   * @returns {{ edits: Array<{ from: number, to: number, data: Buffer }>, size: number }}
+   *   Offsets der bisherigen Datei, size: neue Dateilänge
+   */
+  planWrite(hunks) {
+    const edits = hunksToEdits(hunks, this.lines.length, this.encoding, line => this.offsetOf(line));
+    if (!edits) throw new Error('Ungültige Hunks für propItem.txt.txt');
+
+    const size = edits.reduce((total, edit) => total + edit.data.length - (edit.to - edit.from), this.size);
+    return { edits, size };
+  }
+
+  /**
+   * Übernimmt geschriebene Hunks in den Index
+   * @param {number} size Neue Dateilänge
+   * @param {string} hash SHA-1 der neuen Datei
+   */
+  async commit(hunks, size, hash) {
+    for (let h = hunks.length - 1; h >= 0; h--) {
+      const { start, end, text } = hunks[h];
+      const toEnd = end === this.lines.length;
+      const pieces = text.split('\n');
+      // Bis auf das Dateiende endet jeder Hunk mit einem Zeilenumbruch
+      if (!toEnd) pieces.pop();
+
+      const records = pieces.map((piece, index) => {
+        const line = toEnd && index === pieces.length - 1 ? piece : `${piece}\n`;
+        return { key: lineKey(piece), length: encodeText(line, { encoding: this.encoding, bom: false }).length, line: 0, offset: 0 };
+      });
+
+      this.lines.slice(start, end).forEach(record => this.removeKey(record));
+      this.lines.splice(start, end - start, ...records);
+      records.forEach(record => this.addKey(record));
+      this.validFrom = Math.min(this.validFrom, start);
+    }
+
+    this.size = size;
+    this.hash = hash;
+    await this.updateStat();
+  }
+
+  async updateStat() {
+    const stat = await fs.promises.stat(this.filePath);
+    this.fileStat = { size: stat.size, mtimeMs: stat.mtimeMs };
+  }
+
+  // Wurde die Datei seit dem letzten Lesen/Schreiben von außen geändert?
+  async isStale() {
+    try {
+      const stat = await fs.promises.stat(this.filePath);
+      return !this.fileStat || stat.size !== this.fileStat.size || stat.mtimeMs !== this.fileStat.mtimeMs;
+    } catch {
+      return true;
+    }
+  }
+}
+
+// Dateipfad -> Index
+const indexes = new Map();
+
+/**
+ * Liefert den Index für die Datei; liest sie nur neu, wenn sie sich auf der Platte geändert hat
+ */
+async function getPropItemIndex(filePath) {
+  const cached = indexes.get(filePath);
+  if (cached && !(await cached.isStale())) {
+    return cached;
+  }
+
+  const startTime = Date.now();
+  const buffer = await fs.promises.readFile(filePath);
+  const index = new PropItemIndex(filePath, getRememberedEncoding(filePath) || detectEncoding(buffer));
+  index.load(buffer, index.decoder.decode(buffer));
+  await index.updateStat();
+  indexes.set(filePath, index);
+
+  console.log(`propItem-Index für ${filePath} aufgebaut: ${index.lines.length} Zeilen, ${index.numbers.length} Nummern in ${Date.now() - startTime}ms`);
+  return index;
+}
+
+/**
+ * Index nach einem Schreiben der Datei außerhalb des Index verwerfen
+ */
+function invalidatePropItemIndex(filePath) {
+  indexes.delete(filePath);
+}
+
+module.exports = {
+  getPropItemIndex,
+  invalidatePropItemIndex
+};
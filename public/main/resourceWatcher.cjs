@@ -0,0 +1,266 @@
+// Überwachung des Ressourcenordners mit zeilenweisen Deltas (Main-Prozess)
+//
+// Ändert jemand defineItem.h oder Spec_item.txt außerhalb des Tools, meldet fs.watch die
+// Datei. Nach einer kurzen Beruhigungszeit (Editoren schreiben oft in mehreren Schritten)
+// wird die Datei gelesen und über Zeilen-Hashes mit dem letzten bekannten Stand
+// verglichen. An den Renderer gehen nur die geänderten Zeilenbereiche, im selben Format
+// wie beim Delta-Speichern ({ start, end, text }, siehe filePatch.cjs).
+//
+// Den Ausgangsstand liefern die Lade-Handler (prime/createLineHasher); Schreibvorgänge des
+// Tools selbst werden über refresh() übernommen, ohne ein Delta zu erzeugen.
+const fs = require('fs');
+const path = require('path');
+const { readTextFile } = require('./textEncoding.cjs');
+
+const DEBOUNCE_MS = 250;
+
+// FNV-1a über die UTF-16-Codeeinheiten einer Zeile
+function hashLine(text, start, end) {
+  let hash = 0x811c9dc5;
+  for (let i = start; i < end; i++) {
+    hash = Math.imul(hash ^ text.charCodeAt(i), 0x01000193);
+  }
+  return hash >>> 0;
+}
+
+/**
+ * Sammelt Zeilen-Hashes und -Längen über Textteile (auch wenn Zeilen über Teilgrenzen gehen)
+ */
+function createLineHasher() {
+  let hashes = new Uint32Array(1024);
+  let lengths = new Uint32Array(1024);
+  let count = 0;
+  let pending = '';
+
+  const push = (hash, length) => {
+    if (count === hashes.length) {
+      const grownHashes = new Uint32Array(hashes.length * 2);
+      const grownLengths = new Uint32Array(lengths.length * 2);
+      grownHashes.set(hashes);
+      grownLengths.set(lengths);
+      hashes = grownHashes;
+      lengths = grownLengths;
+    }
+    hashes[count] = hash;
+    lengths[count] = length;
+    count++;
+  };
+
+  return {
+    update(text) {
+      const chunk = pending.length > 0 ? pending + text : text;
+      let lineStart = 0;
+      for (let newline = chunk.indexOf('\n'); newline !== -1; newline = chunk.indexOf('\n', lineStart)) {
+        push(hashLine(chunk, lineStart, newline), newline - lineStart);
+        lineStart = newline + 1;
+      }
+      pending = chunk.substring(lineStart);
+    },
+    // Wie content.split('\n'): die letzte Zeile zählt auch ohne Zeilenumbruch
+    digest() {
+      push(hashLine(pending, 0, pending.length), pending.length);
+      pending = '';
+      return { hashes: hashes.slice(0, count), lengths: lengths.slice(0, count) };
+    }
+  };
+}
+
+function hashContent(content) {
+  const hasher = createLineHasher();
+  hasher.update(content);
+  return hasher.digest();
+}
+
+/**
+ * Vergleicht zwei Stände über ihre Zeilen-Hashes
+ * @returns {Array<{ start: number, end: number, text: string }>} Hunks auf dem alten Stand
+ */
+function diffLines(previous, next, content) {
+  const a = previous;
+  const b = next;
+  const same = (i, j) => a.hashes[i] === b.hashes[j] && a.lengths[i] === b.lengths[j];
+  const aCount = a.hashes.length;
+  const bCount = b.hashes.length;
+
+  let prefix = 0;
+  const minCount = Math.min(aCount, bCount);
+  while (prefix < minCount && same(prefix, prefix)) prefix++;
+
+  let suffix = 0;
+  while (suffix < minCount - prefix && same(aCount - 1 - suffix, bCount - 1 - suffix)) suffix++;
+
+  const aEnd = aCount - suffix;
+  const bEnd = bCount - suffix;
+  if (prefix === aEnd && prefix === bEnd) return [];
+
+  // Startposition jeder Zeile im neuen Text
+  const starts = new Uint32Array(bCount + 1);
+  for (let i = 0, pos = 0; i < bCount; i++) {
+    starts[i] = pos;
+    pos += b.lengths[i] + 1;
+  }
+  starts[bCount] = content.length;
+
+  const hunks = [];
+  if (aEnd - prefix === bEnd - prefix) {
+    let line = prefix;
+    while (line < aEnd) {
+      if (same(line, line)) {
+        line++;
+        continue;
+      }
+      const start = line;
+      while (line < aEnd && !same(line, line)) line++;
+      hunks.push({ start, end: line, text: content.slice(starts[start], starts[line]) });
+    }
+  } else {
+    // Reicht der Bereich bis zum Dateiende, eine Zeile früher beginnen: sonst fehlt beim
+    // Anhängen/Löschen am Ende der Zeilenumbruch der vorherigen Zeile
+    const start = suffix === 0 && prefix > 0 ? prefix - 1 : prefix;
+    hunks.push({ start, end: aEnd, text: content.slice(starts[start], starts[bEnd]) });
+  }
+  return hunks;
+}
+
+class ResourceWatcher {
+  /**
+   * @param {string} folder Überwachter Ordner (nicht rekursiv)
+   * @param {(delta: object) => void} onDelta Empfängt { fileName, hash, lineCount, hunks } oder { fileName, hash, reload: true }
+   */
+  constructor(folder, onDelta) {
+    this.folder = folder;
+    this.onDelta = onDelta;
+    // Dateiname (klein) -> { hash, hashes, lengths }
+    this.snapshots = new Map();
+    this.timers = new Map();
+    // Laufende Aktualisierungen nach eigenen Schreibvorgängen
+    this.refreshing = new Map();
+    this.watcher = null;
+  }
+
+  start() {
+    try {
+      this.watcher = fs.watch(this.folder, { persistent: false }, (eventType, fileName) => {
+        if (fileName) this.schedule(fileName.toString());
+      });
+      this.watcher.on('error', (error) => console.error('Fehler in der Ressourcenüberwachung:', error));
+      console.log(`Überwache Ressourcenordner: ${this.folder}`);
+    } catch (error) {
+      console.error(`Ressourcenordner ${this.folder} kann nicht überwacht werden:`, error);
+    }
+    return this;
+  }
+
+  close() {
+    if (this.watcher) this.watcher.close();
+    this.watcher = null;
+    this.timers.forEach(timer => clearTimeout(timer));
+    this.timers.clear();
+  }
+
+  /**
+   * Ausgangsstand einer Datei setzen (beim Laden durch den Renderer)
+   */
+  prime(fileName, hash, lines) {
+    this.snapshots.set(fileName.toLowerCase(), { hash, ...lines });
+  }
+
+  // Liegt die Datei im überwachten Ordner und kennt der Renderer ihren Stand?
+  isTracked(filePath) {
+    return path.dirname(path.resolve(filePath)) === path.resolve(this.folder) &&
+      this.snapshots.has(path.basename(filePath).toLowerCase());
+  }
+
+  /**
+   * Nach einem Schreibvorgang des Tools mit bekanntem Inhalt: Stand direkt übernehmen
+   */
+  update(filePath, content, hash) {
+    if (!this.isTracked(filePath)) return;
+    this.prime(path.basename(filePath), hash, hashContent(content));
+  }
+
+  /**
+   * Wie update, mit beim Schreiben gesammelten Zeilen-Hashes (gestreamtes Speichern)
+   */
+  updateHashes(filePath, hash, lines) {
+    if (!this.isTracked(filePath)) return;
+    this.prime(path.basename(filePath), hash, lines);
+  }
+
+  /**
+   * Nach einem Schreibvorgang des Tools: Stand neu einlesen, ohne ein Delta zu senden
+   */
+  refresh(filePath) {
+    if (!this.isTracked(filePath)) return Promise.resolve();
+
+    const key = path.basename(filePath).toLowerCase();
+
+    const task = readTextFile(filePath)
+      .then(({ content, hash }) => this.prime(key, hash, hashContent(content)))
+      .catch(error => {
+        console.error(`Stand von ${filePath} konnte nicht aktualisiert werden:`, error);
+        this.snapshots.delete(key);
+      })
+      .finally(() => {
+        if (this.refreshing.get(key) === task) this.refreshing.delete(key);
+      });
+    this.refreshing.set(key, task);
+    return task;
+  }
+
+  schedule(fileName) {
+    // Temp-Dateien und Journale der Speicherroutinen ignorieren; .redo: Reste aus Versionen,
+    // die Byte-Bereiche noch über Redo-Dateien neben der Zieldatei geschrieben haben
+    if (/\.(tmp|symtab|redo)$/i.test(fileName)) return;
+
+    clearTimeout(this.timers.get(fileName));
+    this.timers.set(fileName, setTimeout(() => {
+      this.timers.delete(fileName);
+      this.process(fileName).catch(error => console.error(`Fehler beim Verarbeiten der Änderung an ${fileName}:`, error));
+    }, DEBOUNCE_MS));
+  }
+
+  async process(fileName) {
+    const key = fileName.toLowerCase();
+    const filePath = path.join(this.folder, fileName);
+
+    // Eigene Schreibvorgänge zuerst übernehmen
+    const pendingRefresh = this.refreshing.get(key);
+    if (pendingRefresh) await pendingRefresh;
+
+    let stat;
+    try {
+      stat = await fs.promises.stat(filePath);
+    } catch {
+      // Gelöscht oder umbenannt
+      if (this.snapshots.delete(key)) this.onDelta({ fileName, removed: true });
+      return;
+    }
+    if (!stat.isFile()) return;
+
+    const startTime = process.hrtime.bigint();
+    const { content, hash } = await readTextFile(filePath);
+    const previous = this.snapshots.get(key);
+    if (previous && previous.hash === hash) return;
+
+    const lines = hashContent(content);
+    this.prime(key, hash, lines);
+
+    if (!previous) {
+      this.onDelta({ fileName, hash, reload: true });
+      return;
+    }
+
+    const hunks = diffLines(previous, lines, content);
+    const elapsed = Number(process.hrtime.bigint() - startTime) / 1e6;
+    console.log(`Externe Änderung an ${fileName}: ${hunks.length} Bereiche (${elapsed.toFixed(1)}ms)`);
+    this.onDelta({ fileName, hash, baseHash: previous.hash, lineCount: lines.hashes.length, hunks });
+  }
+}
+
+module.exports = {
+  ResourceWatcher,
+  createLineHasher,
+  hashContent,
+  diffLines
+};
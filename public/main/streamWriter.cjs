@@ -0,0 +1,112 @@
+// Textdateien in Teilen schreiben (Main-Prozess)
+//
+// Große Dateien (Spec_item.txt mit 100k+ Zeilen) kommen vom Renderer in Teilen über einen
+// MessagePort statt als ein String. Jeder Teil wird sofort kodiert und in eine Temp-Datei
+// neben dem Ziel geschrieben; finish() schiebt sie per rename auf das Ziel. SHA-1 und
+// Zeilen-Hashes (für die Ressourcenüberwachung) entstehen nebenbei, der Gesamtinhalt liegt
+// weder im Renderer noch hier als ein String oder Buffer vor.
+const fs = require('fs');
+const path = require('path');
+const crypto = require('crypto');
+const { encodeText } = require('./textEncoding.cjs');
+const { createLineHasher } = require('./resourceWatcher.cjs');
+const { fileMatchesHash } = require('./filePatch.cjs');
+
+class StreamWriter {
+  /**
+   * @param {string} targetPath Absoluter Zielpfad
+   * @param {{ encoding: string, bom?: boolean }} encodingInfo Kodierung der Datei (siehe resolveSaveEncoding)
+   */
+  constructor(targetPath, encodingInfo) {
+    this.targetPath = targetPath;
+    this.tempPath = `${targetPath}.${Date.now().toString(36)}-${crypto.randomBytes(4).toString('hex')}.tmp`;
+    this.encodingInfo = encodingInfo;
+    this.hash = crypto.createHash('sha1');
+    this.lineHasher = createLineHasher();
+    this.size = 0;
+    this.stream = null;
+    this.failure = null;
+  }
+
+  async open() {
+    await fs.promises.mkdir(path.dirname(this.targetPath), { recursive: true });
+    // flush: vor dem Schließen fsyncen, damit das rename nur vollständige Inhalte sichtbar macht
+    this.stream = fs.createWriteStream(this.tempPath, { flush: true });
+    this.stream.on('error', (error) => { this.failure = error; });
+    await new Promise((resolve, reject) => {
+      this.stream.once('open', resolve);
+      this.stream.once('error', reject);
+    });
+    return this;
+  }
+
+  /**
+   * Einen Teil kodieren und schreiben; wartet, wenn der Puffer des Streams voll ist
+   * @param {string} text Teil des Inhalts (an Zeichen-, nicht Bytegrenzen geteilt)
+   */
+  async write(text) {
+    if (this.failure) throw this.failure;
+    // BOM nur vor dem ersten Teil
+    const data = encodeText(text, { ...this.encodingInfo, bom: this.size === 0 && this.encodingInfo.bom });
+    this.hash.update(data);
+    this.lineHasher.update(text);
+    this.size += data.length;
+
+    if (!this.stream.write(data)) {
+      await new Promise((resolve, reject) => {
+        const onError = (error) => { this.stream.off('drain', onDrain); reject(error); };
+        const onDrain = () => { this.stream.off('error', onError); resolve(); };
+        this.stream.once('drain', onDrain);
+        this.stream.once('error', onError);
+      });
+    }
+  }
+
+  /**
+   * Stream schließen und die Temp-Datei auf das Ziel schieben
+   * Hat das Ziel bereits dieselben Bytes (gleicher SHA-1), wird die Temp-Datei verworfen (unchanged)
+   * @returns {Promise<{ path: string, size: number, hash: string, unchanged: boolean, lines: { hashes: Uint32Array, lengths: Uint32Array } }>}
+   */
+  async finish() {
+    if (this.failure) throw this.failure;
+    await new Promise((resolve, reject) => {
+      this.stream.once('error', reject);
+      this.stream.end(resolve);
+    });
+    const hash = this.hash.digest('hex');
+    const unchanged = await fileMatchesHash(this.targetPath, this.size, hash);
+    if (unchanged) {
+      await fs.promises.unlink(this.tempPath);
+    } else {
+      await fs.promises.rename(this.tempPath, this.targetPath);
+    }
+    return { path: this.targetPath, size: this.size, hash, unchanged, lines: this.lineHasher.digest() };
+  }
+
+  // Abbrechen: die Zieldatei bleibt unverändert
+  async abort() {
+    if (this.stream && !this.stream.closed) {
+      await new Promise(resolve => {
+        this.stream.once('close', resolve);
+        this.stream.destroy();
+      });
+    }
+    await fs.promises.unlink(this.tempPath).catch(error => {
+      if (error.code !== 'ENOENT') console.warn(`Temp-Datei ${this.tempPath} konnte nicht gelöscht werden:`, error.message);
+    });
+  }
+}
+
+/**
+ * Öffnet eine Datei zum Schreiben in Teilen
+ * @param {string} targetPath Absoluter Zielpfad
+ * @param {{ encoding: string, bom?: boolean }} encodingInfo
+ * @returns {Promise<StreamWriter>}
+ */
+function openStreamWriter(targetPath, encodingInfo) {
+  return new StreamWriter(targetPath, encodingInfo).open();
+}
+
+module.exports = {
+  openStreamWriter
+};
@@ -0,0 +1,100 @@
+// Tab-getrennte Bytes in eine Offset-Tabelle scannen (Parser-Prozess)
+//
+// Gleicher Algorithmus wie scanTabSeparated in src/utils/file/tabScanner.ts: pro Zeile die
+// Zeilennummer und der Index der ersten Zelle, pro Zelle Start und Ende (getrimmt) im Puffer.
+// Der Renderer setzt aus den Arrays direkt seine TabTable zusammen und muss die Datei beim
+// Laden nicht selbst scannen. Beide Seiten müssen dieselben Offsets liefern.
+
+const CHAR_TAB = 9;
+const CHAR_LF = 10;
+
+const isSpace = (code) => code === 32 || (code >= 9 && code <= 13);
+
+// Wachsende Uint32-Liste für die Offsets
+class OffsetList {
+  constructor(capacity) {
+    this.data = new Uint32Array(Math.max(16, Math.ceil(capacity)));
+    this.length = 0;
+  }
+
+  push(value) {
+    if (this.length === this.data.length) {
+      const grown = new Uint32Array(this.data.length * 2);
+      grown.set(this.data);
+      this.data = grown;
+    }
+    this.data[this.length++] = value;
+  }
+
+  toArray() {
+    return this.data.subarray(0, this.length);
+  }
+}
+
+/**
+ * Scannt tab-getrennte Bytes ab start; leere Zeilen werden übersprungen
+ * @param {Uint8Array} bytes
+ * @param {number} start
+ * @returns {{ rowLines: Uint32Array, rowCells: Uint32Array, cellStarts: Uint32Array, cellEnds: Uint32Array, lineCount: number }}
+ */
+function scanTabSeparated(bytes, start = 0) {
+  const end = bytes.length;
+
+  // Schätzung: ~500 Bytes pro Zeile, ~3 Bytes pro Zelle (Spec_item.txt)
+  const rowLines = new OffsetList((end - start) / 500);
+  const rowCells = new OffsetList((end - start) / 500 + 1);
+  const cellStarts = new OffsetList((end - start) / 3);
+  const cellEnds = new OffsetList((end - start) / 3);
+
+  let line = 0;
+  let pos = start;
+
+  while (pos <= end) {
+    let lineEnd = bytes.indexOf(CHAR_LF, pos);
+    if (lineEnd === -1 || lineEnd > end) lineEnd = end;
+
+    // Zeile trimmen (entspricht line.trim())
+    let contentStart = pos;
+    let contentEnd = lineEnd;
+    while (contentStart < contentEnd && isSpace(bytes[contentStart])) contentStart++;
+    while (contentEnd > contentStart && isSpace(bytes[contentEnd - 1])) contentEnd--;
+
+    if (contentEnd > contentStart) {
+      rowLines.push(line);
+      rowCells.push(cellStarts.length);
+
+      let cellStart = contentStart;
+      while (true) {
+        let cellEnd = cellStart;
+        while (cellEnd < contentEnd && bytes[cellEnd] !== CHAR_TAB) cellEnd++;
+        const next = cellEnd + 1;
+
+        // Zelle trimmen (entspricht cell.trim())
+        while (cellStart < cellEnd && isSpace(bytes[cellStart])) cellStart++;
+        while (cellEnd > cellStart && isSpace(bytes[cellEnd - 1])) cellEnd--;
+        cellStarts.push(cellStart);
+        cellEnds.push(cellEnd);
+
+        if (next > contentEnd) break;
+        cellStart = next;
+      }
+    }
+
+    line++;
+    pos = lineEnd + 1;
+  }
+
+  rowCells.push(cellStarts.length);
+
+  return {
+    rowLines: rowLines.toArray(),
+    rowCells: rowCells.toArray(),
+    cellStarts: cellStarts.toArray(),
+    cellEnds: cellEnds.toArray(),
+    lineCount: line
+  };
+}
+
+module.exports = {
+  scanTabSeparated
+};
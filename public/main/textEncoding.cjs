@@ -0,0 +1,299 @@
+// Kodierungserkennung und verlustfreies Lesen/Schreiben von Ressourcendateien (Main-Prozess)
+//
+// Die Ressourcen liegen in unterschiedlichen Kodierungen vor: UTF-8, UTF-16LE mit BOM
+// (character.inc, propQuest.txt.txt, textClient.inc, character.txt.txt, propMover.txt.txt),
+// Windows-1252 (propItem.txt.txt) und CP949 (koreanische Kommentare in älteren Headern).
+// Jede Datei wird einmal erkannt und dekodiert; die erkannte Kodierung wird pro Dateiname
+// gemerkt, damit beim Speichern exakt dieselben Bytes (inkl. BOM) entstehen.
+const fs = require('fs');
+const path = require('path');
+const crypto = require('crypto');
+
+const UTF8_BOM = [0xEF, 0xBB, 0xBF];
+// Größe der Stichprobe für die UTF-16-Erkennung ohne BOM
+const SAMPLE_SIZE = 4096;
+
+// Dateiname (klein) -> { encoding, bom, lineEnding }
+const rememberedEncodings = new Map();
+
+function hasPrefix(buffer, bytes) {
+  return buffer.length >= bytes.length && bytes.every((byte, index) => buffer[index] === byte);
+}
+
+// UTF-16 ohne BOM: fast jedes zweite Byte ist 0 (ASCII-lastiger Text)
+function detectUtf16WithoutBom(buffer) {
+  const length = Math.min(buffer.length, SAMPLE_SIZE) & ~1;
+  if (length < 4) return null;
+
+  let evenZeros = 0;
+  let oddZeros = 0;
+  for (let i = 0; i < length; i += 2) {
+    if (buffer[i] === 0) evenZeros++;
+    if (buffer[i + 1] === 0) oddZeros++;
+  }
+
+  const pairs = length / 2;
+  if (oddZeros > pairs * 0.3 && evenZeros < pairs * 0.05) return 'utf-16le';
+  if (evenZeros > pairs * 0.3 && oddZeros < pairs * 0.05) return 'utf-16be';
+  return null;
+}
+
+// Unterscheidet CP949 und Windows-1252 anhand der Bytes >= 0x80:
+// in CP949 bilden sie fast ausschließlich gültige Doppelbyte-Zeichen
+function detectLegacyEncoding(buffer) {
+  let pairs = 0;
+  let invalid = 0;
+
+  for (let i = 0; i < buffer.length; i++) {
+    const lead = buffer[i];
+    if (lead < 0x80) continue;
+
+    const trail = buffer[i + 1];
+    const validLead = lead >= 0x81 && lead <= 0xFE;
+    const validTrail = trail !== undefined &&
+      ((trail >= 0x41 && trail <= 0x5A) || (trail >= 0x61 && trail <= 0x7A) || (trail >= 0x81 && trail <= 0xFE));
+
+    if (validLead && validTrail) {
+      pairs++;
+      i++;
+    } else {
+      invalid++;
+    }
+  }
+
+  return pairs > 0 && invalid <= pairs * 0.05 ? 'euc-kr' : 'windows-1252';
+}
+
+function detectLineEnding(text) {
+  const newline = text.indexOf('\n');
+  if (newline === -1) return null;
+  return newline > 0 && text[newline - 1] === '\r' ? '\r\n' : '\n';
+}
+
+/**
+ * Erkennt die Kodierung anhand von BOM und Heuristiken
+ * @returns {{ encoding: string, bom: boolean }} encoding als WHATWG-Label (für TextDecoder)
+ */
+function detectEncoding(buffer) {
+  if (hasPrefix(buffer, UTF8_BOM)) return { encoding: 'utf-8', bom: true };
+  if (hasPrefix(buffer, [0xFF, 0xFE])) return { encoding: 'utf-16le', bom: true };
+  if (hasPrefix(buffer, [0xFE, 0xFF])) return { encoding: 'utf-16be', bom: true };
+
+  const utf16 = detectUtf16WithoutBom(buffer);
+  if (utf16) return { encoding: utf16, bom: false };
+
+  try {
+    new TextDecoder('utf-8', { fatal: true }).decode(buffer);
+    return { encoding: 'utf-8', bom: false };
+  } catch {
+    return { encoding: detectLegacyEncoding(buffer), bom: false };
+  }
+}
+
+/**
+ * Liest eine Textdatei gestreamt und dekodiert sie in einem Durchlauf
+ * Ohne BOM wird zunächst UTF-8 angenommen (fatal). Scheitert das, wird das Lesen abgebrochen,
+ * die Datei vollständig neu gelesen und die Kodierung über den gesamten Inhalt bestimmt; onReset
+ * signalisiert dann, dass bereits gelieferte Teile verworfen werden müssen und der Inhalt neu kommt.
+ * Die gelesenen Teile werden nicht behalten; die Erkennung nutzt nur den Anfang des ersten Teils.
+ * Nebenbei wird ein SHA-1 über die Bytes auf der Platte gebildet (Basis für Patches).
+ * onBytes erhält jeden gelesenen Teil unverändert (z.B. um die Rohdaten mitzuschicken); nach
+ * onReset kommen auch die Rohdaten neu.
+ * @param {string} filePath
+ * @param {{ onChunk: (text: string) => void, onReset?: () => void, onBytes?: (chunk: Buffer) => void, signal?: { aborted: boolean } }} handlers
+ * @returns {Promise<{ info: { encoding: string, bom: boolean, lineEnding: string|null }, hash: string }|null>} null bei Abbruch
+ */
+async function streamTextFile(filePath, { onChunk, onReset, onBytes, signal }) {
+  let decoder = null;
+  let info = null;
+  let fallback = false;
+  let lineEnding;
+  const hash = crypto.createHash('sha1');
+
+  const emit = (text) => {
+    if (!text) return;
+    if (lineEnding === undefined && text.includes('\n')) lineEnding = detectLineEnding(text);
+    onChunk(text);
+  };
+
+  const stream = fs.createReadStream(filePath, { highWaterMark: 1024 * 1024 });
+  for await (const chunk of stream) {
+    if (signal && signal.aborted) {
+      stream.destroy();
+      return null;
+    }
+    hash.update(chunk);
+    if (onBytes) onBytes(chunk);
+
+    if (!decoder) {
+      const head = chunk.subarray(0, SAMPLE_SIZE);
+      const bomInfo = hasPrefix(head, UTF8_BOM) || hasPrefix(head, [0xFF, 0xFE]) || hasPrefix(head, [0xFE, 0xFF])
+        ? detectEncoding(head)
+        : null;
+      const utf16 = bomInfo ? null : detectUtf16WithoutBom(head);
+      info = bomInfo || { encoding: utf16 || 'utf-8', bom: false };
+      decoder = new TextDecoder(info.encoding, { fatal: info.encoding === 'utf-8' && !info.bom });
+    }
+
+    try {
+      emit(decoder.decode(chunk, { stream: true }));
+    } catch {
+      // Kein gültiges UTF-8 - die ganze Datei neu lesen und über den gesamten Inhalt entscheiden
+      fallback = true;
+      stream.destroy();
+      break;
+    }
+  }
+
+  if (!decoder) {
+    info = { encoding: 'utf-8', bom: false };
+  } else {
+    if (!fallback) {
+      try {
+        emit(decoder.decode());
+      } catch {
+        fallback = true;
+      }
+    }
+
+    if (fallback) {
+      const buffer = await fs.promises.readFile(filePath);
+      if (signal && signal.aborted) return null;
+      info = detectEncoding(buffer);
+      lineEnding = undefined;
+      if (onReset) onReset();
+      if (onBytes) onBytes(buffer);
+      emit(new TextDecoder(info.encoding).decode(buffer));
+      // Der Hash muss zum neu gelesenen Stand passen
+      return { info: { ...info, lineEnding: lineEnding || null }, hash: crypto.createHash('sha1').update(buffer).digest('hex') };
+    }
+  }
+
+  return { info: { ...info, lineEnding: lineEnding || null }, hash: hash.digest('hex') };
+}
+
+/**
+ * Liest eine Textdatei vollständig (siehe streamTextFile)
+ * @returns {Promise<{ content: string, info: { encoding: string, bom: boolean, lineEnding: string|null }, hash: string }>}
+ */
+async function readTextFile(filePath) {
+  let parts = [];
+  const { info, hash } = await streamTextFile(filePath, {
+    onChunk: (text) => parts.push(text),
+    onReset: () => { parts = []; }
+  });
+  return { content: parts.join(''), info, hash };
+}
+
+// Windows-1252 als exakte Umkehrung des TextDecoders (auch für 0x81, 0x8D, ... ohne Zeichen)
+// UTF-16-Codeeinheit -> Byte, -1 für nicht darstellbare Zeichen
+let windows1252Table = null;
+function getWindows1252Table() {
+  if (!windows1252Table) {
+    windows1252Table = new Int16Array(0x10000).fill(-1);
+    const decoded = new TextDecoder('windows-1252').decode(Uint8Array.from({ length: 256 }, (_, i) => i));
+    for (let i = 0; i < 256; i++) windows1252Table[decoded.charCodeAt(i)] = i;
+  }
+  return windows1252Table;
+}
+
+/**
+ * Kodiert Text in die angegebene Kodierung (Gegenstück zu readTextFile)
+ * @param {string} content
+ * @param {{ encoding: string, bom?: boolean }} info
+ * @returns {Buffer}
+ */
+function encodeText(content, info) {
+  const encoding = normalizeEncoding(info.encoding);
+  let body;
+  let bom = [];
+
+  switch (encoding) {
+    case 'utf-16le':
+      body = Buffer.from(content, 'utf16le');
+      if (info.bom) bom = [0xFF, 0xFE];
+      break;
+    case 'utf-16be':
+      body = Buffer.from(content, 'utf16le').swap16();
+      if (info.bom) bom = [0xFE, 0xFF];
+      break;
+    case 'windows-1252': {
+      const table = getWindows1252Table();
+      body = Buffer.alloc(content.length);
+      for (let i = 0; i < content.length; i++) {
+        const byte = table[content.charCodeAt(i)];
+        body[i] = byte === -1 ? 0x3F : byte; // '?'
+      }
+      break;
+    }
+    case 'euc-kr':
+      body = require('iconv-lite').encode(content, 'cp949');
+      break;
+    default:
+      body = Buffer.from(content, 'utf8');
+      if (info.bom) bom = UTF8_BOM;
+      break;
+  }
+
+  return bom.length > 0 ? Buffer.concat([Buffer.from(bom), body]) : body;
+}
+
+// Ältere Aufrufer übergeben Node-Kodierungsnamen ("latin1", "utf8", "win1252")
+function normalizeEncoding(encoding) {
+  switch ((encoding || '').toLowerCase()) {
+    case 'latin1':
+    case 'ansi':
+    case 'win1252':
+    case 'cp1252':
+    case 'windows-1252':
+      return 'windows-1252';
+    case 'utf16le':
+    case 'utf-16le':
+    case 'ucs2':
+      return 'utf-16le';
+    case 'utf16be':
+    case 'utf-16be':
+      return 'utf-16be';
+    case 'cp949':
+    case 'euc-kr':
+      return 'euc-kr';
+    default:
+      return 'utf-8';
+  }
+}
+
+function rememberEncoding(fileName, info) {
+  rememberedEncodings.set(path.basename(fileName).toLowerCase(), info);
+}
+
+function getRememberedEncoding(fileName) {
+  return rememberedEncodings.get(path.basename(fileName).toLowerCase()) || null;
+}
+
+/**
+ * Bestimmt die Kodierung zum Speichern: die beim Laden erkannte Kodierung hat Vorrang,
+ * damit unveränderte Inhalte byte-genau zurückgeschrieben werden. Mit forceEncoding
+ * kann der Aufrufer eine andere Kodierung erzwingen.
+ */
+function resolveSaveEncoding(fileName, options) {
+  const remembered = getRememberedEncoding(fileName);
+  if (remembered && !(options && options.forceEncoding)) return remembered;
+
+  if (options && (options.encoding || options.useANSI)) {
+    const encoding = options.useANSI ? 'windows-1252' : normalizeEncoding(options.encoding);
+    return { encoding, bom: !!options.bom };
+  }
+
+  return remembered || { encoding: 'utf-8', bom: false };
+}
+
+module.exports = {
+  detectEncoding,
+  readTextFile,
+  streamTextFile,
+  encodeText,
+  normalizeEncoding,
+  rememberEncoding,
+  getRememberedEncoding,
+  resolveSaveEncoding
+};
@@ -38,10 +38,139 @@ contextBridge.exposeInMainWorld(
     loadAllFiles: () => 
       ipcRenderer.invoke('load-all-files'),
     
+    // Einzelne Ressourcendatei laden; der Inhalt kommt in Teilen über einen MessagePort
+    // onChunk (optional) erhält jeden Teil sofort, z.B. um ihn schon während des Lesens zu parsen;
+    // onReset (optional): die bisherigen Teile sind ungültig (Kodierung neu erkannt), es folgt der ganze Inhalt
+    // withBytes (optional): das Ergebnis enthält zusätzlich die Rohdaten der Datei (bytes, nicht bei UTF-16)
+    // Schließt der Main-Prozess den Port ohne Ende- oder Fehlermeldung, wird das Promise abgelehnt
+    loadResourceFile: (fileName, onChunk, onReset, withBytes) => new Promise((resolve, reject) => {
+      const { port1, port2 } = new MessageChannel();
+      let parts = [];
+      let settled = false;
+      
+      const finish = (settle, value) => {
+        if (settled) return;
+        settled = true;
+        port1.close();
+        settle(value);
+      };
+      
+      port1.onmessage = ({ data }) => {
+        switch (data.type) {
+          case 'chunk':
+            parts.push(data.text);
+            if (onChunk) onChunk(data.text);
+            break;
+          case 'reset':
+            parts = [];
+            if (onReset) onReset();
+            break;
+          case 'end':
+            finish(resolve, { success: true, fileName: data.fileName, content: parts.join(''), bytes: data.bytes, encoding: data.encoding, hash: data.hash });
+            break;
+          case 'error':
+            finish(resolve, { success: false, error: data.error });
+            break;
+        }
+      };
+      // Electron meldet das Schließen der Gegenseite (z.B. Absturz oder Abbruch im Main-Prozess)
+      port1.addEventListener('close', () => {
+        finish(reject, new Error(`Stream für ${fileName} wurde ohne Ende geschlossen`));
+      });
+      port1.start();
+      
+      ipcRenderer.postMessage('open-resource-stream', { fileName, withBytes: !!withBytes }, [port2]);
+    }),
+    
+    // Datei in Teilen speichern (siehe public/main/streamWriter.cjs)
+    // write(text) wartet, solange zu viele Teile unbestätigt sind; close() liefert
+    // { success, path, size, hash, unchanged }, abort() verwirft alles Geschriebene
+    openSaveStream: (fileName, savePath, options) => {
+      const MAX_PENDING_CHUNKS = 4;
+      const { port1, port2 } = new MessageChannel();
+      let pending = 0;
+      let failure = null;
+      let resumeWrite = null;
+      let settle = null;
+      const result = new Promise((resolve) => { settle = resolve; });
+
+      const resume = () => {
+        if (!resumeWrite) return;
+        const resolve = resumeWrite;
+        resumeWrite = null;
+        resolve();
+      };
+
+      port1.onmessage = ({ data }) => {
+        switch (data.type) {
+          case 'ack':
+            pending--;
+            resume();
+            break;
+          case 'done':
+            port1.close();
+            settle({ success: true, path: data.path, size: data.size, hash: data.hash, unchanged: data.unchanged });
+            break;
+          case 'error':
+            failure = data.error;
+            port1.close();
+            settle({ success: false, error: data.error });
+            resume();
+            break;
+        }
+      };
+
+      ipcRenderer.postMessage('open-save-stream', { fileName, savePath, options }, [port2]);
+
+      return {
+        write: async (text) => {
+          if (failure) throw new Error(failure);
+          port1.postMessage({ type: 'chunk', text });
+          pending++;
+          if (pending >= MAX_PENDING_CHUNKS) {
+            await new Promise((resolve) => { resumeWrite = resolve; });
+          }
+          if (failure) throw new Error(failure);
+        },
+        close: () => {
+          if (!failure) port1.postMessage({ type: 'end' });
+          return result;
+        },
+        abort: () => {
+          failure = failure || 'Aborted';
+          port1.close();
+          settle({ success: false, error: failure });
+        }
+      };
+    },
+
     // Listen for save response events
     onSaveFileResponse: (callback) => 
       ipcRenderer.on('save-file-response', (_, data) => callback(data)),
     
+    // Externe Änderungen an Ressourcendateien (Zeilen-Deltas, siehe public/main/resourceWatcher.cjs)
+    onResourceFileChanged: (callback) =>
+      ipcRenderer.on('resource-file-changed', (_, delta) => callback(delta)),
+    
+    // Kompilierte Symboltabellen in userData/symtab lesen/schreiben
+    readSymbolTable: (fileName) =>
+      ipcRenderer.invoke('read-symbol-table', fileName),
+    
+    writeSymbolTable: (fileName, data) =>
+      ipcRenderer.invoke('write-symbol-table', fileName, data),
+    
+    // Parse-Cache in userData (siehe public/main/parseCache.cjs)
+    readParseCache: (key) =>
+      ipcRenderer.invoke('read-parse-cache', key),
+    
+    writeParseCache: (key, data) =>
+      ipcRenderer.invoke('write-parse-cache', key, data),
+    
+    // Verbindung zum Parser-Prozess anfordern (siehe public/main/parserProcess.cjs); der
+    // Port kommt als window-Nachricht { type: 'parser-port' } an
+    connectParser: () =>
+      ipcRenderer.send('open-parser-port'),
+    
     // Neue Funktion: Resolve resource path
     getResourcePath: (subPath) => 
       ipcRenderer.invoke('get-resource-path', subPath),
@@ -111,3 +240,10 @@ window.addEventListener('save-all-files', (event) => {
       }));
     });
 });
+
+// Port zum Parser-Prozess an die Seite weiterreichen (über contextBridge lassen sich keine
+// Ports übergeben); danach spricht der Renderer direkt mit dem Parser-Prozess.
+// Zielursprung '/': nur an Dokumente mit dem Ursprung der App, nicht an eingebettete Seiten
+ipcRenderer.on('parser-port', (event) => {
+  window.postMessage({ type: 'parser-port' }, '/', event.ports);
+});
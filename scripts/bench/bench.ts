@@ -0,0 +1,349 @@
+/**
+ * Benchmarks für Parser und Serialisierer (headless unter Node)
+ *
+ * Aufruf: npm run bench -- [Optionen]
+ *   --corpus=<Ordner>     Eingabedateien (Standard: public/resource)
+ *   --filter=<Text>       Nur Fälle, deren Name den Text enthält
+ *   --min-time=<ms>       Messdauer je Fall (Standard: 2000)
+ *   --threshold=<Anteil>  Erlaubte Verschlechterung des Medians gegenüber der Baseline (Standard: 0.1 = 10 %)
+ *   --update-baseline     Ergebnisse als Baseline dieser Maschine speichern (scripts/bench/baseline.json)
+ *   --output=<Datei>      Ergebnisse zusätzlich als JSON schreiben
+ *   --ci                  Ohne Baseline für diese Maschine mit Exit-Code 2 abbrechen statt nur zu messen
+ *                         (auch bei CI=true)
+ *
+ * Gemessen werden Durchsatz (MB/s, ops/s), Latenz (p50/p99) und Allokationen je Durchlauf
+ * (Heap-Zuwachs und GC-Läufe; der Heap-Zuwachs ist nur mit --expose-gc aussagekräftig, das
+ * npm-Skript setzt es). Liegt ein Median über der Baseline plus Schwelle, endet der Lauf mit
+ * Exit-Code 1. Fehlt eine Datei im Korpus, wird der Fall übersprungen. Die eingecheckte
+ * Baseline gilt für den Standardkorpus. Absolute Zeiten sind nur auf derselben Hardware
+ * vergleichbar, deshalb hält die Datei je Maschine (Plattform und CPU-Modell) eine eigene
+ * Baseline; verglichen wird nur mit der Baseline der Maschine, auf der der Lauf stattfindet.
+ *
+ * Die Parser protokollieren sehr ausführlich; console.log/info/warn/debug sind während der
+ * Messung stumm geschaltet, sonst würde die Ausgabe gemessen.
+ */
+import fs from "fs";
+import path from "path";
+import os from "os";
+import { createRequire } from "module";
+import { PerformanceObserver, performance } from "perf_hooks";
+import { parseFileContent } from "../../src/utils/file/parseUtils";
+import { parsePropItemFile, resetParsedPropItem } from "../../src/utils/file/propItemUtils";
+import { parseDefineItemFile } from "../../src/utils/file/defineItemParser";
+import { parseMdlDynaFile } from "../../src/utils/file/mdlDynaParser";
+import { serializeWithNameReplacement } from "../../src/utils/file/serializeUtils";
+import { parseCollectorData, serializeCollectorData } from "../../src/utils/collectorUtils";
+
+const root = process.cwd();
+const requireFromRoot = createRequire(path.join(root, "package.json"));
+// Gleiche Kodierungserkennung wie beim Laden in der App
+const { readTextFile } = requireFromRoot("./public/main/textEncoding.cjs");
+
+const BASELINE_PATH = path.join(root, "scripts", "bench", "baseline.json");
+const WARMUP_RUNS = 2;
+const MIN_SAMPLES = 5;
+const MAX_SAMPLES = 200;
+
+interface BenchCase {
+  name: string;
+  // Eingabedatei relativ zum Korpus
+  file: string;
+  // Weitere Dateien, die vorher geladen sein müssen (z.B. propItem.txt.txt für die Namen)
+  setup?: (content: string, readCorpusFile: (name: string) => Promise<string | null>) => Promise<unknown>;
+  run: (content: string, state: unknown) => unknown;
+}
+
+interface BenchResult {
+  name: string;
+  file: string;
+  bytes: number;
+  samples: number;
+  p50Ms: number;
+  p99Ms: number;
+  meanMs: number;
+  mbPerSec: number;
+  opsPerSec: number;
+  // Heap-Zuwachs je Durchlauf (Median), null ohne --expose-gc
+  allocBytesPerOp: number | null;
+  gcPerOp: number;
+}
+
+interface MachineBaseline {
+  createdAt: string;
+  node: string;
+  platform: string;
+  cpu: string;
+  results: Record<string, BenchResult>;
+}
+
+// Baselines je Maschine, Schlüssel siehe machineKey
+interface Baseline {
+  machines: Record<string, MachineBaseline>;
+}
+
+const currentPlatform = `${process.platform}-${process.arch}`;
+const currentCpu = os.cpus()[0]?.model.trim() || "unknown";
+
+const machineKey = (platform: string, cpu: string): string => `${platform} ${cpu}`;
+
+const readBaseline = (): Baseline | null => {
+  if (!fs.existsSync(BASELINE_PATH)) return null;
+  const data = JSON.parse(fs.readFileSync(BASELINE_PATH, "utf8"));
+  // Älteres Format: eine einzige Baseline ohne Maschinenschlüssel
+  if (data.results) {
+    return { machines: { [machineKey(data.platform, data.cpu)]: data } };
+  }
+  return data;
+};
+
+const cases: BenchCase[] = [
+  {
+    name: "parseFileContent",
+    file: "Spec_item.txt",
+    setup: async (_, readCorpusFile) => {
+      // Anzeigenamen kommen aus propItem.txt.txt
+      const propItem = await readCorpusFile("propItem.txt.txt");
+      if (propItem) parsePropItemFile(propItem);
+      return null;
+    },
+    run: (content) => parseFileContent(content)
+  },
+  {
+    name: "parsePropItemFile",
+    file: "propItem.txt.txt",
+    run: (content) => {
+      // Sonst liefert parsePropItemFile ab dem zweiten Durchlauf nur die gemerkten Mappings
+      resetParsedPropItem();
+      return parsePropItemFile(content);
+    }
+  },
+  {
+    name: "parseDefineItemFile",
+    file: "defineItem.h",
+    run: (content) => parseDefineItemFile(content)
+  },
+  {
+    name: "parseMdlDynaFile",
+    file: "mdlDyna.inc",
+    run: (content) => parseMdlDynaFile(content)
+  },
+  {
+    name: "parseCollectorData",
+    file: "s.txt",
+    run: (content) => parseCollectorData(content)
+  },
+  {
+    name: "serializeWithNameReplacement",
+    file: "Spec_item.txt",
+    setup: async (content, readCorpusFile) => {
+      const propItem = await readCorpusFile("propItem.txt.txt");
+      if (propItem) parsePropItemFile(propItem);
+      return parseFileContent(content);
+    },
+    run: (content, fileData) => serializeWithNameReplacement(fileData, content)
+  },
+  {
+    name: "serializeCollectorData",
+    file: "s.txt",
+    setup: async (content) => parseCollectorData(content),
+    run: (content, data) => serializeCollectorData(data as ReturnType<typeof parseCollectorData>, content)
+  }
+];
+
+const parseArgs = (argv: string[]) => {
+  const options: Record<string, string | true> = {};
+  for (const arg of argv) {
+    const match = arg.match(/^--([^=]+)(?:=(.*))?$/);
+    if (match) options[match[1]] = match[2] === undefined ? true : match[2];
+  }
+  return {
+    corpus: path.resolve(root, String(options.corpus || "public/resource")),
+    filter: typeof options.filter === "string" ? options.filter : undefined,
+    minTime: Number(options["min-time"] || 2000),
+    threshold: Number(options.threshold ?? process.env.BENCH_THRESHOLD ?? 0.1),
+    updateBaseline: options["update-baseline"] === true,
+    ci: options.ci === true || (!!process.env.CI && process.env.CI !== "false"),
+    output: typeof options.output === "string" ? path.resolve(root, options.output) : undefined
+  };
+};
+
+// Nearest-Rank-Perzentil einer aufsteigend sortierten Liste
+const percentile = (sorted: number[], p: number): number =>
+  sorted[Math.min(sorted.length - 1, Math.max(0, Math.ceil(p * sorted.length) - 1))];
+
+const median = (values: number[]): number => percentile([...values].sort((a, b) => a - b), 0.5);
+
+const silenceConsole = () => {
+  const saved = { log: console.log, info: console.info, warn: console.warn, debug: console.debug };
+  const noop = () => {};
+  console.log = console.info = console.warn = console.debug = noop;
+  return () => Object.assign(console, saved);
+};
+
+// GC-Läufe mit Zeitstempel, um sie den Messungen zuordnen zu können
+const gcEvents: number[] = [];
+const gcObserver = new PerformanceObserver(list => {
+  for (const entry of list.getEntries()) gcEvents.push(entry.startTime);
+});
+
+const runCase = async (benchCase: BenchCase, corpus: string, minTime: number): Promise<BenchResult | null> => {
+  const readCorpusFile = async (name: string): Promise<string | null> => {
+    const filePath = path.join(corpus, name);
+    if (!fs.existsSync(filePath)) return null;
+    return (await readTextFile(filePath)).content;
+  };
+
+  const content = await readCorpusFile(benchCase.file);
+  if (content === null) {
+    console.log(`  ${benchCase.name}: übersprungen (${benchCase.file} fehlt im Korpus)`);
+    return null;
+  }
+
+  const bytes = fs.statSync(path.join(corpus, benchCase.file)).size;
+  const gc = (globalThis as any).gc as (() => void) | undefined;
+  const restoreConsole = silenceConsole();
+
+  const times: number[] = [];
+  const allocations: number[] = [];
+  const windows: [number, number][] = [];
+
+  try {
+    const state = benchCase.setup ? await benchCase.setup(content, readCorpusFile) : null;
+    for (let i = 0; i < WARMUP_RUNS; i++) benchCase.run(content, state);
+
+    const deadline = performance.now() + minTime;
+    while (times.length < MAX_SAMPLES && (times.length < MIN_SAMPLES || performance.now() < deadline)) {
+      if (gc) gc();
+      const heapBefore = process.memoryUsage().heapUsed;
+      const start = performance.now();
+      benchCase.run(content, state);
+      const end = performance.now();
+      const heapAfter = process.memoryUsage().heapUsed;
+
+      times.push(end - start);
+      windows.push([start, end]);
+      allocations.push(Math.max(0, heapAfter - heapBefore));
+    }
+  } finally {
+    restoreConsole();
+  }
+
+  // Einträge des Observers kommen asynchron
+  await new Promise(resolve => setTimeout(resolve, 0));
+  const gcCount = gcEvents.filter(time => windows.some(([start, end]) => time >= start && time <= end)).length;
+  gcEvents.length = 0;
+
+  const sorted = [...times].sort((a, b) => a - b);
+  const meanMs = times.reduce((sum, time) => sum + time, 0) / times.length;
+  const p50Ms = percentile(sorted, 0.5);
+
+  return {
+    name: benchCase.name,
+    file: benchCase.file,
+    bytes,
+    samples: times.length,
+    p50Ms,
+    p99Ms: percentile(sorted, 0.99),
+    meanMs,
+    mbPerSec: bytes / (1024 * 1024) / (p50Ms / 1000),
+    opsPerSec: 1000 / meanMs,
+    allocBytesPerOp: gc ? median(allocations) : null,
+    gcPerOp: gcCount / times.length
+  };
+};
+
+const formatRow = (result: BenchResult, baseline?: BenchResult): string => {
+  const change = baseline ? ((result.p50Ms / baseline.p50Ms - 1) * 100) : null;
+  return [
+    result.name.padEnd(30),
+    `${result.mbPerSec.toFixed(1).padStart(8)} MB/s`,
+    `${result.opsPerSec.toFixed(1).padStart(8)} ops/s`,
+    `p50 ${result.p50Ms.toFixed(2).padStart(9)} ms`,
+    `p99 ${result.p99Ms.toFixed(2).padStart(9)} ms`,
+    `alloc ${result.allocBytesPerOp === null ? "      n/a" : `${(result.allocBytesPerOp / (1024 * 1024)).toFixed(1).padStart(6)} MB`}`,
+    `gc ${result.gcPerOp.toFixed(1).padStart(5)}/op`,
+    change === null ? "" : `${change >= 0 ? "+" : ""}${change.toFixed(1)}%`
+  ].join("  ");
+};
+
+const main = async () => {
+  const options = parseArgs(process.argv.slice(2));
+  if (!fs.existsSync(options.corpus)) {
+    console.error(`Korpus nicht gefunden: ${options.corpus}`);
+    process.exit(2);
+  }
+
+  const baselines = readBaseline();
+  const machine = machineKey(currentPlatform, currentCpu);
+  const baseline = baselines?.machines[machine] ?? null;
+
+  // Im CI-Modus würde ein Lauf ohne Baseline nie eine Verschlechterung melden
+  if (!baseline && options.ci && !options.updateBaseline) {
+    console.error(`Baseline für ${machine} fehlt in ${BASELINE_PATH} (auf dieser Maschine mit --update-baseline anlegen und einchecken)`);
+    process.exit(2);
+  }
+
+  console.log(`Korpus: ${options.corpus}`);
+  console.log(`Maschine: ${machine}`);
+  console.log(baseline
+    ? `Baseline vom ${baseline.createdAt} (Node ${baseline.node}), Schwelle ${(options.threshold * 100).toFixed(0)} %`
+    : `Keine Baseline für diese Maschine vorhanden (--update-baseline legt eine an)${baselines ? `; vorhanden: ${Object.keys(baselines.machines).join(", ")}` : ""}`);
+  if (baseline && baseline.node !== process.versions.node) {
+    console.log(`Hinweis: Baseline mit Node ${baseline.node} gemessen, dieser Lauf mit Node ${process.versions.node}`);
+  }
+  if (!(globalThis as any).gc) console.log("Ohne --expose-gc gestartet: Allokationen werden nicht gemessen");
+  console.log("");
+
+  gcObserver.observe({ entryTypes: ["gc"] });
+
+  const results: BenchResult[] = [];
+  const regressions: string[] = [];
+
+  for (const benchCase of cases) {
+    if (options.filter && !benchCase.name.includes(options.filter)) continue;
+
+    const result = await runCase(benchCase, options.corpus, options.minTime);
+    if (!result) continue;
+    results.push(result);
+
+    const previous = baseline?.results[result.name];
+    console.log(formatRow(result, previous));
+    if (previous && result.p50Ms > previous.p50Ms * (1 + options.threshold)) {
+      regressions.push(`${result.name}: p50 ${previous.p50Ms.toFixed(2)} ms -> ${result.p50Ms.toFixed(2)} ms`);
+    }
+  }
+
+  gcObserver.disconnect();
+
+  if (options.output) {
+    fs.writeFileSync(options.output, JSON.stringify({ createdAt: new Date().toISOString(), results }, null, 2));
+    console.log(`\nErgebnisse geschrieben: ${options.output}`);
+  }
+
+  if (options.updateBaseline) {
+    const next: MachineBaseline = {
+      createdAt: new Date().toISOString(),
+      node: process.versions.node,
+      platform: currentPlatform,
+      cpu: currentCpu,
+      // Fälle, die diesmal nicht liefen (Filter, fehlende Datei), aus der alten Baseline übernehmen
+      results: { ...(baseline?.results || {}), ...Object.fromEntries(results.map(result => [result.name, result])) }
+    };
+    // Baselines anderer Maschinen bleiben erhalten
+    const machines = { ...(baselines?.machines || {}), [machine]: next };
+    fs.writeFileSync(BASELINE_PATH, JSON.stringify({ machines }, null, 2) + "\n");
+    console.log(`\nBaseline für ${machine} aktualisiert: ${BASELINE_PATH}`);
+    return;
+  }
+
+  if (regressions.length > 0) {
+    console.error(`\nVerschlechterung über ${(options.threshold * 100).toFixed(0)} %:`);
+    regressions.forEach(line => console.error(`  ${line}`));
+    process.exit(1);
+  }
+};
+
+main().catch(error => {
+  console.error("Benchmark fehlgeschlagen:", error);
+  process.exit(2);
+});
@@ -0,0 +1,226 @@
+// Synthetischer Korpus für Lasttests (npm run bench:corpus)
+//
+// Vervielfacht die Ressourcendateien aus public/resource auf das 10-, 100- oder 1000-fache,
+// damit Parser, Indizes und Serialisierer mit 100k bis 1M Items getestet werden können:
+//   node scripts/bench/generateCorpus.cjs [--source=public/resource] [--out=.bench-corpus] [--scale=10,100,1000]
+// Ergebnis: <out>/x10, <out>/x100, ... (npm run bench -- --corpus=.bench-corpus/x100)
+//
+// Jede Kopie k (1 .. scale-1) übernimmt die Datensätze des Originals mit umbenannten Symbolen:
+//   II_NAME / MI_NAME          -> II_NAME_S<k> / MI_NAME_S<k> (nur in defineItem.h/defineObj.h definierte Namen)
+//   #define-Werte              -> Wert + k * Schrittweite (Zehnerpotenz über der größten ID)
+//   IDS_PROPITEM_TXT_<n>       -> IDS_PROPITEM_TXT_<n + k * Schrittweite>
+// Alle Querverweise (Spec_item -> defineItem.h/propItem.txt.txt, propMover.txt/propMoverEx.inc
+// -> defineObj.h/defineItem.h) zeigen damit wieder auf vorhandene Einträge. Texte der Mover
+// (IDS_PROPMOVER_TXT_, IDS_CHARACTER_INC_) teilen sich die Kopien mit dem Original.
+// Kodierung, BOM und Zeilenenden jeder Datei bleiben erhalten; geschrieben wird in Teilen,
+// auch die 1000-fache Spec_item.txt passt so nicht als ein String in den Speicher.
+const fs = require('fs');
+const path = require('path');
+const { readTextFile, encodeText } = require('../../public/main/textEncoding.cjs');
+
+const DEFINE_LINE = /^(\s*#define\s+)((?:II|MI)_[A-Za-z0-9_]+)(\s+)(\d+)(.*)$/;
+const SYMBOL = /\b(?:II|MI)_[A-Za-z0-9_]+\b/g;
+const PROPITEM_ID = /\bIDS_PROPITEM_TXT_(\d+)\b/g;
+
+const parseArgs = (argv) => {
+  const options = {};
+  for (const arg of argv) {
+    const match = arg.match(/^--([^=]+)(?:=(.*))?$/);
+    if (match) options[match[1]] = match[2] === undefined ? true : match[2];
+  }
+  return {
+    source: path.resolve(options.source || 'public/resource'),
+    out: path.resolve(options.out || '.bench-corpus'),
+    scales: String(options.scale || '10,100,1000').split(',').map(Number).filter(scale => scale >= 1)
+  };
+};
+
+// Kleinste Zehnerpotenz über dem größten Wert
+const strideFor = (max) => Math.pow(10, Math.max(1, Math.ceil(Math.log10(max + 1))));
+
+class CorpusContext {
+  constructor() {
+    this.symbols = new Set();
+    this.maxDefine = { II: 0, MI: 0 };
+    this.maxPropItemId = 0;
+  }
+
+  collectDefines(content) {
+    for (const line of content.split('\n')) {
+      const match = line.match(DEFINE_LINE);
+      if (!match) continue;
+      this.symbols.add(match[2]);
+      const kind = match[2].substring(0, 2);
+      this.maxDefine[kind] = Math.max(this.maxDefine[kind], Number(match[4]));
+    }
+  }
+
+  collectPropItemIds(content) {
+    for (const match of content.matchAll(PROPITEM_ID)) {
+      this.maxPropItemId = Math.max(this.maxPropItemId, Number(match[1]));
+    }
+  }
+
+  finish() {
+    this.defineStride = { II: strideFor(this.maxDefine.II), MI: strideFor(this.maxDefine.MI) };
+    this.propItemStride = strideFor(this.maxPropItemId);
+  }
+
+  // Text der Kopie k: Symbole und propItem-IDs umbenennen
+  rename(text, k) {
+    return text
+      .replace(SYMBOL, name => this.symbols.has(name) ? `${name}_S${k}` : name)
+      .replace(PROPITEM_ID, (match, id) =>
+        `IDS_PROPITEM_TXT_${String(Number(id) + k * this.propItemStride).padStart(id.length, '0')}`);
+  }
+
+  // #define-Zeilen der Kopie k (Name umbenannt, Wert verschoben, Ausrichtung beibehalten)
+  renameDefine(line, k) {
+    const match = line.match(DEFINE_LINE);
+    const name = `${match[2]}_S${k}`;
+    const value = String(Number(match[4]) + k * this.defineStride[match[2].substring(0, 2)]);
+    const gap = ' '.repeat(Math.max(1, match[3].length + match[2].length - name.length + match[4].length - value.length));
+    return `${match[1]}${name}${gap}${value}${match[5]}`;
+  }
+}
+
+// Zeilen und Zeilenende der Datei; endet das Original ohne Umbruch, bekommt es einen,
+// damit die erste Kopie nicht an die letzte Zeile angehängt wird
+const splitLines = (content) => {
+  const eol = content.includes('\r\n') ? '\r\n' : '\n';
+  const lines = content.split(/\r?\n/);
+  if (lines[lines.length - 1] === '') lines.pop();
+  return { eol, lines };
+};
+
+// Blöcke der Form "NAME ... { ... }" auf oberster Ebene (character.inc, propMoverEx.inc)
+const splitBlocks = (lines) => {
+  const blocks = [];
+  let depth = 0;
+  let start = -1;
+  let sawBrace = false;
+
+  lines.forEach((line, index) => {
+    const code = line.replace(/\/\/.*$/, '');
+    if (depth === 0 && start === -1 && /^[A-Za-z_][A-Za-z0-9_]*/.test(code.trim())) {
+      start = index;
+      sawBrace = false;
+    }
+    for (const char of code) {
+      if (char === '{') { depth++; sawBrace = true; }
+      else if (char === '}') depth = Math.max(0, depth - 1);
+    }
+    if (start !== -1 && depth === 0 && sawBrace) {
+      blocks.push(lines.slice(start, index + 1));
+      start = -1;
+    }
+  });
+  return blocks;
+};
+
+// Blocknamen (character.inc) eindeutig machen, Symbole wie üblich umbenennen
+const renameBlock = (context, block, k) => {
+  const renamed = block.map(line => context.rename(line, k));
+  renamed[0] = renamed[0].replace(/^(\s*)([A-Za-z_][A-Za-z0-9_]*)/, (match, indent, name) =>
+    context.symbols.has(name) ? match : `${indent}${name}_S${k}`);
+  return renamed;
+};
+
+// Datei in Teilen schreiben: Original, dann je Kopie die umbenannten Datensätze
+const writeScaled = async (targetPath, info, content, scale, copyFor) => {
+  const { eol, lines } = splitLines(content);
+  const handle = await fs.promises.open(targetPath, 'w');
+  try {
+    const write = (text, first) => handle.write(encodeText(text, { ...info, bom: first && info.bom }));
+    await write(lines.join(eol) + eol, true);
+    for (let k = 1; k < scale; k++) {
+      const copy = copyFor(lines, k);
+      if (copy.length > 0) await write(copy.join(eol) + eol, false);
+    }
+  } finally {
+    await handle.close();
+  }
+};
+
+const isDataRow = (line) => line.trim() !== '' && !line.trim().startsWith('//');
+
+const generators = {
+  'Spec_item.txt': (context) => (lines, k) =>
+    lines.slice(1).filter(isDataRow).map(line => context.rename(line, k)),
+  'propItem.txt.txt': (context) => (lines, k) =>
+    lines.filter(line => /^\s*IDS_PROPITEM_TXT_\d+/.test(line)).map(line => context.rename(line, k)),
+  'defineItem.h': (context) => (lines, k) =>
+    lines.filter(line => DEFINE_LINE.test(line) && line.match(DEFINE_LINE)[2].startsWith('II_')).map(line => context.renameDefine(line, k)),
+  'defineObj.h': (context) => (lines, k) =>
+    lines.filter(line => DEFINE_LINE.test(line) && line.match(DEFINE_LINE)[2].startsWith('MI_')).map(line => context.renameDefine(line, k)),
+  'propMover.txt': (context) => (lines, k) =>
+    lines.filter(line => /^\s*MI_/.test(line)).map(line => context.rename(line, k)),
+  'character.inc': (context) => {
+    let blocks = null;
+    return (lines, k) => {
+      blocks = blocks || splitBlocks(lines);
+      return blocks.flatMap(block => renameBlock(context, block, k));
+    };
+  },
+  'propMoverEx.inc': (context) => {
+    let blocks = null;
+    return (lines, k) => {
+      blocks = blocks || splitBlocks(lines);
+      return blocks.flatMap(block => block.map(line => context.rename(line, k)));
+    };
+  }
+};
+
+const main = async () => {
+  const options = parseArgs(process.argv.slice(2));
+  const files = Object.keys(generators);
+
+  // Quelldateien liegen teils im Ressourcenordner, teils unter NPC/ (wie in der App)
+  const findSource = (name) => [path.join(options.source, name), path.join(options.source, 'NPC', name)]
+    .find(candidate => fs.existsSync(candidate));
+
+  const sources = {};
+  for (const name of files) {
+    const sourcePath = findSource(name);
+    if (!sourcePath) {
+      console.warn(`${name} fehlt in ${options.source}, wird übersprungen`);
+      continue;
+    }
+    sources[name] = { path: sourcePath, ...(await readTextFile(sourcePath)) };
+  }
+
+  const context = new CorpusContext();
+  ['defineItem.h', 'defineObj.h'].forEach(name => sources[name] && context.collectDefines(sources[name].content));
+  ['Spec_item.txt', 'propItem.txt.txt'].forEach(name => sources[name] && context.collectPropItemIds(sources[name].content));
+  context.finish();
+  console.log(`Symbole: ${context.symbols.size}, Schrittweiten: II ${context.defineStride.II}, MI ${context.defineStride.MI}, IDS_PROPITEM_TXT ${context.propItemStride}`);
+
+  for (const scale of options.scales) {
+    const targetDir = path.join(options.out, `x${scale}`);
+    await fs.promises.mkdir(targetDir, { recursive: true });
+    const startTime = Date.now();
+
+    for (const [name, source] of Object.entries(sources)) {
+      const targetPath = path.join(targetDir, path.relative(options.source, source.path));
+      await fs.promises.mkdir(path.dirname(targetPath), { recursive: true });
+      await writeScaled(targetPath, source.info, source.content, scale, generators[name](context));
+    }
+
+    // Übrige Dateien (Texte der Mover, s.txt, ...) unverändert übernehmen
+    for (const entry of await fs.promises.readdir(options.source, { withFileTypes: true })) {
+      if (entry.isFile() && !sources[entry.name]) {
+        await fs.promises.copyFile(path.join(options.source, entry.name), path.join(targetDir, entry.name));
+      }
+    }
+
+    const sizes = await Promise.all(Object.values(sources).map(source =>
+      fs.promises.stat(path.join(targetDir, path.relative(options.source, source.path))).then(stat => stat.size)));
+    const totalMb = sizes.reduce((sum, size) => sum + size, 0) / (1024 * 1024);
+    console.log(`x${scale}: ${targetDir} (${totalMb.toFixed(1)} MB) in ${((Date.now() - startTime) / 1000).toFixed(1)}s`);
+  }
+};
+
+main().catch(error => {
+  console.error('Korpus konnte nicht erzeugt werden:', error);
+  process.exit(1);
+});
@@ -0,0 +1,11 @@
+// Ersatz für sonner im Benchmark (kein DOM, keine Toasts)
+const noop = (..._args: unknown[]) => undefined;
+
+export const toast = Object.assign(noop, {
+  success: noop,
+  error: noop,
+  info: noop,
+  warning: noop,
+  loading: noop,
+  dismiss: noop
+});
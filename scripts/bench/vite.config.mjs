@@ -0,0 +1,33 @@
+// Build des Benchmark-Runners für Node (npm run bench)
+// Bündelt scripts/bench/bench.ts samt der Parser aus src/ zu dist-bench/bench.mjs.
+import { defineConfig } from "vite";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const root = path.resolve(path.dirname(fileURLToPath(import.meta.url)), "../..");
+
+export default defineConfig({
+  root,
+  logLevel: "warn",
+  resolve: {
+    alias: {
+      "@": path.resolve(root, "src"),
+      // Toasts ohne UI: die Parser melden Fehler auch darüber
+      sonner: path.resolve(root, "scripts/bench/sonnerStub.ts")
+    },
+    extensions: [".ts", ".tsx", ".js", ".json"]
+  },
+  build: {
+    ssr: path.resolve(root, "scripts/bench/bench.ts"),
+    outDir: path.resolve(root, "dist-bench"),
+    emptyOutDir: true,
+    target: "node20",
+    minify: false,
+    rollupOptions: {
+      output: {
+        entryFileNames: "bench.mjs",
+        format: "es"
+      }
+    }
+  }
+});
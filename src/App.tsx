@@ -5,6 +5,8 @@ import { QueryClient, QueryClientProvider } from "@tanstack/react-query";
 import { BrowserRouter, Routes, Route } from "react-router-dom";
 import { useEffect } from "react";
 import { initFileEventListeners } from "./utils/file/fileEventHandlers";
+import { initResourceWatcher } from "./utils/file/resourceWatcher";
+import { initTraceExport } from "./utils/trace";
 import Index from "./pages/Index";
 import NotFound from "./pages/NotFound";
 
@@ -15,6 +17,8 @@ const App = () => {
   useEffect(() => {
     console.log("Initialisiere Datei-Event-Listener in App-Komponente");
     initFileEventListeners();
+    initResourceWatcher();
+    initTraceExport();
   }, []);
 
   return (
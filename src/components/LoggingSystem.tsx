@@ -5,6 +5,7 @@ import LogFilterSection from "./logging/LogFilterSection";
 import LogTableSection from "./logging/LogTableSection";
 import { RadioGroup, RadioGroupItem } from "@/components/ui/radio-group";
 import { Label } from "@/components/ui/label";
+import { CHANGE_JOURNAL_EVENT, getPendingLogEntries } from "../utils/file/changeJournal";
 
 interface LoggingSystemProps {
   isVisible: boolean;
@@ -19,6 +20,9 @@ const LoggingSystem = ({ isVisible, onClose, logEntries, onRestoreVersion }: Log
   const [filter, setFilter] = useState('');
   const [showAdvancedFilters, setShowAdvancedFilters] = useState(false);
   const [viewMode, setViewMode] = useState<'accordion' | 'list'>('list');
+  // History: gespeicherte Log-Einträge; pending: ungespeicherte Änderungen aus dem Änderungsjournal (ein Eintrag je Feld)
+  const [source, setSource] = useState<'history' | 'pending'>('history');
+  const [pendingEntries, setPendingEntries] = useState<LogEntry[]>([]);
   const [filterOptions, setFilterOptions] = useState({
     itemName: '',
     field: '',
@@ -36,9 +40,19 @@ const LoggingSystem = ({ isVisible, onClose, logEntries, onRestoreVersion }: Log
     }
   }, [isVisible]);
 
+  useEffect(() => {
+    if (!isVisible) return;
+    
+    const updatePendingEntries = () => setPendingEntries(getPendingLogEntries());
+    updatePendingEntries();
+    
+    window.addEventListener(CHANGE_JOURNAL_EVENT, updatePendingEntries);
+    return () => window.removeEventListener(CHANGE_JOURNAL_EVENT, updatePendingEntries);
+  }, [isVisible]);
+
   useEffect(() => {
     // Basic filter
-    let filtered = [...logEntries];
+    let filtered = source === 'pending' ? [...pendingEntries] : [...logEntries];
     
     if (filter) {
       filtered = filtered.filter(entry => 
@@ -89,7 +103,7 @@ const LoggingSystem = ({ isVisible, onClose, logEntries, onRestoreVersion }: Log
     });
     
     setFilteredEntries(filtered);
-  }, [logEntries, sortOrder, filter, filterOptions, showAdvancedFilters]);
+  }, [logEntries, pendingEntries, source, sortOrder, filter, filterOptions, showAdvancedFilters]);
 
   if (!isVisible) return null;
 
@@ -178,6 +192,22 @@ const LoggingSystem = ({ isVisible, onClose, logEntries, onRestoreVersion }: Log
               </div>
             </RadioGroup>
             
+            <Label className="text-gray-300">Show:</Label>
+            <RadioGroup 
+              defaultValue={source} 
+              onValueChange={(value) => setSource(value as 'history' | 'pending')} 
+              className="flex space-x-4"
+            >
+              <div className="flex items-center space-x-2">
+                <RadioGroupItem value="history" id="history" className="border-cyrus-blue text-cyrus-blue" />
+                <Label htmlFor="history" className="cursor-pointer text-gray-300 hover:text-white transition-colors">History</Label>
+              </div>
+              <div className="flex items-center space-x-2">
+                <RadioGroupItem value="pending" id="pending" className="border-cyrus-blue text-cyrus-blue" />
+                <Label htmlFor="pending" className="cursor-pointer text-gray-300 hover:text-white transition-colors">Unsaved ({pendingEntries.length})</Label>
+              </div>
+            </RadioGroup>
+            
             <div className="ml-auto text-xs text-gray-400">
               {filteredEntries.length} {filteredEntries.length === 1 ? 'entry' : 'entries'} found
             </div>
@@ -197,7 +227,7 @@ const LoggingSystem = ({ isVisible, onClose, logEntries, onRestoreVersion }: Log
         <LogTableSection 
           filteredEntries={filteredEntries}
           formatDate={formatDate}
-          onRestoreVersion={onRestoreVersion}
+          onRestoreVersion={source === 'pending' ? undefined : onRestoreVersion}
           viewMode={viewMode}
         />
       </div>
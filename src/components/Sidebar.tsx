@@ -4,6 +4,7 @@ import { ResourceItem } from "../types/fileTypes";
 import * as ScrollAreaPrimitive from "@radix-ui/react-scroll-area";
 import { Button } from "./ui/button";
 import { ChevronDown } from "lucide-react";
+import { recordTraceSpan } from "../utils/trace";
 
 interface SidebarProps {
   items: ResourceItem[];
@@ -21,8 +22,11 @@ const ITEMS_PER_PAGE = 200; // Maximale Anzahl der Items pro Seite
 let globalScrollPosition = 0;
 // Globaler Flag zum Verhindern des ersten Scrolls
 let isInitialRender = true;
+// Erster Render mit Items wurde als Trace-Span erfasst
+let firstRenderTraced = false;
 
 const Sidebar = ({ items, onSelectItem, selectedItem, darkMode = true }: SidebarProps) => {
+  const renderStart = performance.now();
   const [searchQuery, setSearchQuery] = useState("");
   const [displayedItemsCount, setDisplayedItemsCount] = useState(ITEMS_PER_PAGE);
   const viewportRef = useRef<HTMLDivElement>(null);
@@ -173,6 +177,14 @@ const Sidebar = ({ items, onSelectItem, selectedItem, darkMode = true }: Sidebar
     }
   };
   
+  // Ersten Render mit Items (bis einschließlich DOM-Update) als Trace-Span erfassen
+  useLayoutEffect(() => {
+    if (!firstRenderTraced && safeItems.length > 0) {
+      firstRenderTraced = true;
+      recordTraceSpan("Sidebar (erster Render)", "render", renderStart, performance.now(), { items: safeItems.length });
+    }
+  });
+  
   // Stelle sicher, dass die Scrollposition erhalten bleibt
   useLayoutEffect(() => {
     // Beim ersten Render nicht scrollen
@@ -205,6 +205,13 @@ Collecting_PremiumStatusItem
       return;
     }
     
+    // serializeCollectorData übernimmt unveränderte Zeilen byte-genau: gleicher Inhalt heißt nichts zu speichern
+    if (content === sContent) {
+      console.log("s.txt unverändert, Speichern übersprungen");
+      setUnsavedChanges(false);
+      return;
+    }
+    
     setIsSaving(true);
     
     try {
@@ -213,6 +220,7 @@ Collecting_PremiumStatusItem
       
       if (result.success) {
         toast.success("s.txt erfolgreich gespeichert");
+        setSContent(content);
         setUnsavedChanges(false);
       } else {
         toast.error(`Fehler beim Speichern: ${result.error}`);
@@ -5,7 +5,7 @@ import { itemKind1Options, itemKind2Options, itemKind3Options, jobOptions } from
 import { FormField } from "../ui/form-field";
 import { Textarea } from "../ui/textarea";
 import { Label } from "../ui/label";
-import { getItemIdFromDefine } from "../../utils/file/defineItemParser";
+import { createItemDefines, getItemIdFromDefine } from "../../utils/file/defineItemParser";
 import { getModelFileNameFromDefine, getModelNameFromDefine } from "../../utils/file/mdlDynaParser";
 import { getFileExtension, isSupportedImageFormat, getIconPath, loadImage } from "../../utils/imageLoaders";
 import { loadAndConvertDDS, getBestDDSRepresentation } from "../../utils/ddsLoader";
@@ -125,6 +125,9 @@ const GeneralSection = ({ localItem, editMode, handleDataChange }: GeneralSectio
   const [showImagePreview, setShowImagePreview] = useState(false);
   const [alternateFormatView, setAlternateFormatView] = useState(false);
   const [previewScale, setPreviewScale] = useState(1);
+  // Incremented after a define was created, so the ID is read again from defineItem.h
+  const [, setDefineVersion] = useState(0);
+  const [creatingDefine, setCreatingDefine] = useState(false);
   
   // Handle when a sensitive field is focused
   const handleSensitiveFieldFocus = (field: EditableField, currentValue: string) => {
@@ -471,6 +474,20 @@ const GeneralSection = ({ localItem, editMode, handleDataChange }: GeneralSectio
     }
   };
   
+  // Create the define in defineItem.h with the next free ID (IDs from defineItem.h and defineObj.h are taken)
+  const handleCreateDefine = async () => {
+    if (!editMode || !itemDefine || creatingDefine) return;
+    setCreatingDefine(true);
+    try {
+      const created = await createItemDefines([itemDefine]);
+      if (created) {
+        setDefineVersion(version => version + 1);
+      }
+    } finally {
+      setCreatingDefine(false);
+    }
+  };
+
   // Handle model filename change
   const handleModelFileNameChange = (e: React.ChangeEvent<HTMLInputElement>) => {
     if (editMode && approvedFields.has('modelFileName')) {
@@ -499,6 +516,17 @@ const GeneralSection = ({ localItem, editMode, handleDataChange }: GeneralSectio
             <AlertTriangle size={14} className="text-yellow-500" />
             <span>{itemId ? `ID from defineItem.h - Edit with caution` : 'No ID found in defineItem.h'}</span>
           </p>
+          {!itemId && itemDefine && editMode && (
+            <Button
+              variant="outline"
+              size="sm"
+              onClick={handleCreateDefine}
+              disabled={creatingDefine}
+              className="mt-1 h-7 border-gray-600 bg-gray-800 text-white hover:bg-gray-700"
+            >
+              Create define with free ID
+            </Button>
+          )}
         </div>
         
         <FormField
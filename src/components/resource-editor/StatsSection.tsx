@@ -1,5 +1,7 @@
 import { ResourceItem } from "../../types/fileTypes";
 import { effectTypes } from "../../utils/resourceEditorUtils";
+import { getRowViewSchema } from "../../utils/file/columnStore";
+import { getEffectSlots } from "../../utils/file/specItemSchema";
 import React, { useState, useEffect } from "react";
 import { Input } from "../ui/input";
 import { Info } from "lucide-react";
@@ -16,31 +18,25 @@ const StatsSection = ({ localItem, editMode, handleDataChange }: StatsSectionPro
     return value === "=" ? "" : String(value || "");
   };
 
-  // State for all 6 effects
-  const [effects, setEffects] = useState<Array<{type: string, value: string}>>([
-    { type: normalizeValue(localItem.data.dwDestParam1), value: normalizeValue(localItem.data.nAdjParamVal1) },
-    { type: normalizeValue(localItem.data.dwDestParam2), value: normalizeValue(localItem.data.nAdjParamVal2) },
-    { type: normalizeValue(localItem.data.dwDestParam3), value: normalizeValue(localItem.data.nAdjParamVal3) },
-    { type: normalizeValue(localItem.data.dwDestParam4), value: normalizeValue(localItem.data.nAdjParamVal4) },
-    { type: normalizeValue(localItem.data.dwDestParam5), value: normalizeValue(localItem.data.nAdjParamVal5) },
-    { type: normalizeValue(localItem.data.dwDestParam6), value: normalizeValue(localItem.data.nAdjParamVal6) }
-  ]);
+  // Effekt-Spalten aus dem Schema der Datei (ver6: dwDestParam1-6 / nAdjParamVal1-6);
+  // es werden genau so viele Slots angezeigt, wie die Kopfzeile hat
+  const slots = getEffectSlots(getRowViewSchema(localItem.data));
+  const readEffects = () => slots.map(slot => ({
+    type: normalizeValue(localItem.data[slot.typeKey]),
+    value: normalizeValue(localItem.data[slot.valueKey])
+  }));
+
+  // State for all effect slots
+  const [effects, setEffects] = useState<Array<{type: string, value: string}>>(readEffects);
 
   // Update state when item changes
   useEffect(() => {
-    setEffects([
-      { type: normalizeValue(localItem.data.dwDestParam1), value: normalizeValue(localItem.data.nAdjParamVal1) },
-      { type: normalizeValue(localItem.data.dwDestParam2), value: normalizeValue(localItem.data.nAdjParamVal2) },
-      { type: normalizeValue(localItem.data.dwDestParam3), value: normalizeValue(localItem.data.nAdjParamVal3) },
-      { type: normalizeValue(localItem.data.dwDestParam4), value: normalizeValue(localItem.data.nAdjParamVal4) },
-      { type: normalizeValue(localItem.data.dwDestParam5), value: normalizeValue(localItem.data.nAdjParamVal5) },
-      { type: normalizeValue(localItem.data.dwDestParam6), value: normalizeValue(localItem.data.nAdjParamVal6) }
-    ]);
+    setEffects(readEffects());
   }, [localItem]);
 
   // Handler for effect type changes
   const handleEffectTypeChange = (index: number, newType: string) => {
-    if (!editMode) return;
+    if (!editMode || !slots[index]) return;
 
     const newEffects = [...effects];
     newEffects[index] = {
@@ -51,12 +47,12 @@ const StatsSection = ({ localItem, editMode, handleDataChange }: StatsSectionPro
 
     // Update the corresponding dwDestParam field
     // Convert empty values back to "=" when saving
-    handleDataChange(`dwDestParam${index + 1}`, newType || "=");
+    handleDataChange(slots[index].typeKey, newType || "=");
   };
 
   // Handler for effect value changes
   const handleEffectValueChange = (index: number, newValue: string) => {
-    if (!editMode) return;
+    if (!editMode || !slots[index]) return;
 
     const newEffects = [...effects];
     newEffects[index] = {
@@ -67,7 +63,7 @@ const StatsSection = ({ localItem, editMode, handleDataChange }: StatsSectionPro
 
     // Update the corresponding nAdjParamVal field
     // Convert empty values back to "=" when saving
-    handleDataChange(`nAdjParamVal${index + 1}`, newValue || "=");
+    handleDataChange(slots[index].valueKey, newValue || "=");
   };
 
   return (
@@ -211,224 +207,53 @@ const StatsSection = ({ localItem, editMode, handleDataChange }: StatsSectionPro
         </div>
       </div>
       
-      {/* Row 1: Effect 1 | Value 1 | Effect 2 | Value 2 */}
-      <div className="grid grid-cols-4 gap-3 mb-3">
-        {/* Effect 1 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-type-1" className="text-sm font-medium mb-1 block">
-            Effect 1
-          </label>
-          <select
-            id="effect-type-1"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-            value={effects[0].type}
-            onChange={(e) => handleEffectTypeChange(0, e.target.value)}
-            disabled={!editMode}
-          >
-            <option value="">(no effect)</option>
-            {effectTypes.map(type => (
-              <option key={type} value={type}>{type}</option>
-            ))}
-          </select>
-        </div>
-        
-        {/* Value 1 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-value-1" className="text-sm font-medium mb-1 block">
-            &nbsp;
-          </label>
-          <Input
-            id="effect-value-1"
-            type="text"
-            value={effects[0].value}
-            onChange={(e) => handleEffectValueChange(0, e.target.value)}
-            disabled={!editMode || !effects[0].type}
-            placeholder="Value"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-          />
-        </div>
-        
-        {/* Effect 2 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-type-2" className="text-sm font-medium mb-1 block">
-            Effect 2
-          </label>
-          <select
-            id="effect-type-2"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-            value={effects[1].type}
-            onChange={(e) => handleEffectTypeChange(1, e.target.value)}
-            disabled={!editMode}
-          >
-            <option value="">(no effect)</option>
-            {effectTypes.map(type => (
-              <option key={type} value={type}>{type}</option>
-            ))}
-          </select>
-        </div>
-        
-        {/* Value 2 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-value-2" className="text-sm font-medium mb-1 block">
-            &nbsp;
-          </label>
-          <Input
-            id="effect-value-2"
-            type="text"
-            value={effects[1].value}
-            onChange={(e) => handleEffectValueChange(1, e.target.value)}
-            disabled={!editMode || !effects[1].type}
-            placeholder="Value"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-          />
-        </div>
-      </div>
-      
-      {/* Row 2: Effect 3 | Value 3 | Effect 4 | Value 4 */}
-      <div className="grid grid-cols-4 gap-3 mb-3">
-        {/* Effect 3 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-type-3" className="text-sm font-medium mb-1 block">
-            Effect 3
-          </label>
-          <select
-            id="effect-type-3"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-            value={effects[2].type}
-            onChange={(e) => handleEffectTypeChange(2, e.target.value)}
-            disabled={!editMode}
-          >
-            <option value="">(no effect)</option>
-            {effectTypes.map(type => (
-              <option key={type} value={type}>{type}</option>
-            ))}
-          </select>
-        </div>
-        
-        {/* Value 3 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-value-3" className="text-sm font-medium mb-1 block">
-            &nbsp;
-          </label>
-          <Input
-            id="effect-value-3"
-            type="text"
-            value={effects[2].value}
-            onChange={(e) => handleEffectValueChange(2, e.target.value)}
-            disabled={!editMode || !effects[2].type}
-            placeholder="Value"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-          />
-        </div>
-        
-        {/* Effect 4 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-type-4" className="text-sm font-medium mb-1 block">
-            Effect 4
-          </label>
-          <select
-            id="effect-type-4"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-            value={effects[3].type}
-            onChange={(e) => handleEffectTypeChange(3, e.target.value)}
-            disabled={!editMode}
-          >
-            <option value="">(no effect)</option>
-            {effectTypes.map(type => (
-              <option key={type} value={type}>{type}</option>
-            ))}
-          </select>
-        </div>
-        
-        {/* Value 4 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-value-4" className="text-sm font-medium mb-1 block">
-            &nbsp;
-          </label>
-          <Input
-            id="effect-value-4"
-            type="text"
-            value={effects[3].value}
-            onChange={(e) => handleEffectValueChange(3, e.target.value)}
-            disabled={!editMode || !effects[3].type}
-            placeholder="Value"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-          />
-        </div>
-      </div>
-      
-      {/* Row 3: Effect 5 | Value 5 | Effect 6 | Value 6 */}
-      <div className="grid grid-cols-4 gap-3">
-        {/* Effect 5 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-type-5" className="text-sm font-medium mb-1 block">
-            Effect 5
-          </label>
-          <select
-            id="effect-type-5"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-            value={effects[4].type}
-            onChange={(e) => handleEffectTypeChange(4, e.target.value)}
-            disabled={!editMode}
-          >
-            <option value="">(no effect)</option>
-            {effectTypes.map(type => (
-              <option key={type} value={type}>{type}</option>
-            ))}
-          </select>
-        </div>
-        
-        {/* Value 5 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-value-5" className="text-sm font-medium mb-1 block">
-            &nbsp;
-          </label>
-          <Input
-            id="effect-value-5"
-            type="text"
-            value={effects[4].value}
-            onChange={(e) => handleEffectValueChange(4, e.target.value)}
-            disabled={!editMode || !effects[4].type}
-            placeholder="Value"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-          />
-        </div>
-        
-        {/* Effect 6 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-type-6" className="text-sm font-medium mb-1 block">
-            Effect 6
-          </label>
-          <select
-            id="effect-type-6"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-            value={effects[5].type}
-            onChange={(e) => handleEffectTypeChange(5, e.target.value)}
-            disabled={!editMode}
-          >
-            <option value="">(no effect)</option>
-            {effectTypes.map(type => (
-              <option key={type} value={type}>{type}</option>
-            ))}
-          </select>
-        </div>
-        
-        {/* Value 6 */}
-        <div className="col-span-1">
-          <label htmlFor="effect-value-6" className="text-sm font-medium mb-1 block">
-            &nbsp;
-          </label>
-          <Input
-            id="effect-value-6"
-            type="text"
-            value={effects[5].value}
-            onChange={(e) => handleEffectValueChange(5, e.target.value)}
-            disabled={!editMode || !effects[5].type}
-            placeholder="Value"
-            className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-          />
+      {/* Effekte: je Zeile zwei Slots (Effect | Value | Effect | Value) */}
+      {Array.from({ length: Math.ceil(slots.length / 2) }, (_, row) => (
+        <div key={row} className={`grid grid-cols-4 gap-3${row < Math.ceil(slots.length / 2) - 1 ? " mb-3" : ""}`}>
+          {slots.slice(row * 2, row * 2 + 2).map((slot, offset) => {
+            const index = row * 2 + offset;
+            const effect = effects[index] || { type: "", value: "" };
+            return (
+              <React.Fragment key={slot.typeKey}>
+                {/* Effect */}
+                <div className="col-span-1">
+                  <label htmlFor={`effect-type-${index + 1}`} className="text-sm font-medium mb-1 block">
+                    Effect {index + 1}
+                  </label>
+                  <select
+                    id={`effect-type-${index + 1}`}
+                    className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
+                    value={effect.type}
+                    onChange={(e) => handleEffectTypeChange(index, e.target.value)}
+                    disabled={!editMode}
+                  >
+                    <option value="">(no effect)</option>
+                    {effectTypes.map(type => (
+                      <option key={type} value={type}>{type}</option>
+                    ))}
+                  </select>
+                </div>
+
+                {/* Value */}
+                <div className="col-span-1">
+                  <label htmlFor={`effect-value-${index + 1}`} className="text-sm font-medium mb-1 block">
+                    &nbsp;
+                  </label>
+                  <Input
+                    id={`effect-value-${index + 1}`}
+                    type="text"
+                    value={effect.value}
+                    onChange={(e) => handleEffectValueChange(index, e.target.value)}
+                    disabled={!editMode || !effect.type}
+                    placeholder="Value"
+                    className="w-full p-2 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
+                  />
+                </div>
+              </React.Fragment>
+            );
+          })}
         </div>
-      </div>
+      ))}
     </div>
   );
 };
@@ -1,11 +1,23 @@
 // Type definitions for Electron API in the renderer process
+import type { FileEncodingInfo, SaveEncodingOptions } from './utils/file/fileEncodings';
+import type { SaveStream } from './utils/file/saveStream';
+import type { ResourceFileDelta } from './utils/file/resourceWatcher';
 
 interface ElectronAPI {
   saveFile: (savePath: string, content: string) => Promise<any>;
-  saveAllFiles: (files: any[], savePath: string) => Promise<any>;
-  loadAllFiles: () => Promise<any>;
+  saveAllFiles: (files: any[], savePath?: string) => Promise<any>;
+  loadAllFiles: () => Promise<{ success: boolean; files?: Record<string, string>; encodings?: Record<string, FileEncodingInfo>; error?: string }>;
   getResourcePath: (subPath: string) => Promise<any>;
+  saveFileWithEncoding?: (fileName: string, content: string, savePath: string, options?: SaveEncodingOptions) => Promise<any>;
+  loadResourceFile?: (fileName: string, onChunk?: (text: string) => void, onReset?: () => void, withBytes?: boolean) => Promise<{ success: boolean; fileName?: string; content?: string; bytes?: Uint8Array; encoding?: FileEncodingInfo; hash?: string; error?: string }>;
+  onResourceFileChanged?: (callback: (delta: ResourceFileDelta) => void) => void;
   onSaveFileResponse: (callback: (data: any) => void) => void;
+  readSymbolTable?: (fileName: string) => Promise<{ success: boolean; data?: Uint8Array; error?: string }>;
+  writeSymbolTable?: (fileName: string, data: Uint8Array) => Promise<{ success: boolean; path?: string; error?: string }>;
+  readParseCache?: (key: string) => Promise<{ success: boolean; hit?: boolean; data?: any; error?: string }>;
+  writeParseCache?: (key: string, data: any) => Promise<{ success: boolean; size?: number; error?: string }>;
+  connectParser?: () => void;
+  openSaveStream?: (fileName: string, savePath: string, options?: SaveEncodingOptions) => SaveStream;
 }
 
 declare global {
@@ -1,11 +1,14 @@
-import { useState, useEffect } from "react";
+import { useState, useEffect, useRef } from "react";
 import { FileData, LogEntry, ResourceItem } from "../types/fileTypes";
-import { parseTextFile } from "../utils/file/parseUtils";
+import { parseTextFileParallel } from "../utils/file/specItemWorkerPool";
+import { cloneResourceItems } from "../utils/file/columnStore";
 import { parsePropItemFile } from "../utils/file/propItemUtils";
 import { loadDefineItemFile } from "../utils/file/defineItemParser";
 import { loadMdlDynaFile } from "../utils/file/mdlDynaParser";
 import { toast } from "sonner";
 import { parseSpecItemFile } from "../utils/file/specItemParser";
+import { type SpecItemsChangedDetail } from "../utils/file/resourceWatcher";
+import { getSpecItemCacheKey, isParseCacheAvailable, loadSpecItemCache, saveSpecItemCache } from "../utils/file/parseCache";
 
 // Definiere den LoadingStatus-Typ
 type LoadingStatus = 'idle' | 'loading' | 'partial' | 'complete' | 'error';
@@ -33,64 +36,14 @@ const emptyFileData: FileData = {
   items: []
 };
 
-// Konstanten für das Caching
-const CACHE_VERSION = '1.0.0';
-const CACHE_KEY_SPEC_ITEMS = 'cached_spec_items';
-const CACHE_KEY_PROP_ITEMS = 'cached_prop_items';
-const CACHE_MAX_AGE_MS = 24 * 60 * 60 * 1000; // 24 Stunden
+// Schlüssel des früheren localStorage-Caches (ersetzt durch den Parse-Cache in userData)
+const LEGACY_CACHE_KEYS = ['cached_spec_items', 'cached_spec_items_hash', 'cached_prop_items'];
 
-// Funktion zum Laden von Daten aus dem Cache
-const loadFromCache = (cacheKey: string): any | null => {
+const clearLegacyCache = (): void => {
   try {
-    const cachedDataStr = localStorage.getItem(cacheKey);
-    if (!cachedDataStr) return null;
-    
-    const cachedData = JSON.parse(cachedDataStr);
-    
-    // Prüfe, ob die Daten gültig sind (Version und Timestamp)
-    if (!cachedData.version || cachedData.version !== CACHE_VERSION) {
-      console.log(`Cache-Version ungültig: ${cachedData.version} vs. ${CACHE_VERSION}`);
-      return null;
-    }
-    
-    // Prüfe, ob die Daten nicht zu alt sind
-    if (!cachedData.timestamp || Date.now() - cachedData.timestamp > CACHE_MAX_AGE_MS) {
-      console.log('Cache-Daten sind veraltet, werden aktualisiert');
-      return null;
-    }
-    
-    console.log(`Erfolgreich aus Cache geladen: ${cacheKey}, ${cachedData.data?.items?.length || 0} Items`);
-    return cachedData.data;
+    LEGACY_CACHE_KEYS.forEach(key => localStorage.removeItem(key));
   } catch (error) {
-    console.warn(`Fehler beim Laden aus Cache (${cacheKey}):`, error);
-    return null;
-  }
-};
-
-// Funktion zum Speichern von Daten im Cache
-const saveToCache = (cacheKey: string, data: any): void => {
-  try {
-    const cacheData = {
-      version: CACHE_VERSION,
-      timestamp: Date.now(),
-      data
-    };
-    
-    localStorage.setItem(cacheKey, JSON.stringify(cacheData));
-    console.log(`Daten erfolgreich im Cache gespeichert: ${cacheKey}`);
-  } catch (error) {
-    console.warn(`Fehler beim Speichern im Cache (${cacheKey}):`, error);
-    // Bei Fehlern wie QuotaExceededError versuchen wir, Platz zu schaffen
-    if (error instanceof DOMException && error.name === 'QuotaExceededError') {
-      try {
-        // Versuche, alte Caches zu löschen
-        localStorage.removeItem(CACHE_KEY_SPEC_ITEMS);
-        localStorage.removeItem(CACHE_KEY_PROP_ITEMS);
-        console.log('Cache geleert, um Platz zu schaffen');
-      } catch (clearError) {
-        console.error('Konnte Cache nicht leeren:', clearError);
-      }
-    }
+    console.warn('Alter localStorage-Cache konnte nicht entfernt werden:', error);
   }
 };
 
@@ -98,12 +51,6 @@ export const useFileLoader = (
   settings: any = {},
   setLogEntries: React.Dispatch<React.SetStateAction<LogEntry[]>> = () => {}
 ) => {
-  // Konstanten für das Caching
-  const CACHE_VERSION = '1.0.0';
-  const CACHE_KEY_SPEC_ITEMS = 'cached_spec_items';
-  const CACHE_KEY_PROP_ITEMS = 'cached_prop_items';
-  const CACHE_MAX_AGE_MS = 24 * 60 * 60 * 1000; // 24 Stunden
-  
   const [fileData, setFileData] = useState<FileData | null>(null);
   const [loadingStatus, setLoadingStatus] = useState<LoadingStatus>('idle');
   const [loadProgress, setLoadProgress] = useState(0);
@@ -113,6 +60,8 @@ export const useFileLoader = (
   const [propItemFullyLoaded, setPropItemFullyLoaded] = useState(false);
   const [initialPropItemContent, setInitialPropItemContent] = useState<string | null>(null);
   const [isLoading, setIsLoading] = useState(false);
+  // Parse-Cache-Schlüssel der aktuell geladenen Datei
+  const cacheKeyRef = useRef<string | null>(null);
   
   // Load additional files when the component mounts
   useEffect(() => {
@@ -131,36 +80,6 @@ export const useFileLoader = (
     }
   };
   
-  // Hilfsfunktion für einfachen Hash zur Inhaltsvergleich
-  const computeSimpleHash = async (content: string): Promise<string> => {
-    try {
-      // Verwende nur einen Teil des Inhalts für Performance-Gründe
-      const sampleContent = content.substring(0, 5000) + 
-                          content.substring(content.length / 2, content.length / 2 + 5000) +
-                          content.substring(content.length - 5000);
-      
-      // Verwende SubtleCrypto API für den Hash
-      const encoder = new TextEncoder();
-      const data = encoder.encode(sampleContent);
-      const hashBuffer = await crypto.subtle.digest('SHA-1', data);
-      
-      // Konvertiere den Hash in einen Hex-String
-      const hashArray = Array.from(new Uint8Array(hashBuffer));
-      return hashArray.map(b => b.toString(16).padStart(2, '0')).join('');
-    } catch (error) {
-      // Fallback, wenn crypto nicht verfügbar ist
-      console.warn("Hash-Berechnung fehlgeschlagen, verwende Fallback:", error);
-      
-      // Einfacher Fallback-Hash
-      let hash = 0;
-      for (let i = 0; i < Math.min(content.length, 10000); i++) {
-        hash = ((hash << 5) - hash) + content.charCodeAt(i);
-        hash |= 0; // Konvertiere zu 32-bit Integer
-      }
-      return hash.toString(16);
-    }
-  };
-
   // Hilfsfunktion zum Abschließen der Verarbeitung
   const finishProcessing = (data: FileData, hasPropItem: boolean) => {
     // Vorverarbeitung der Daten
@@ -229,9 +148,10 @@ export const useFileLoader = (
     console.log("Setze Ladestatus auf 'complete' und aktualisiere Dateidaten mit", data.items.length, "Items");
     
     // Tiefer Klon der Daten erstellen, um Referenzprobleme zu vermeiden
+    // (Zeilensichten zeigen auf eine Copy-on-Write-Kopie des Spaltenspeichers, keine Rückwandlung in Objekte)
     const clonedData = {
       ...data,
-      items: JSON.parse(JSON.stringify(data.items))
+      items: cloneResourceItems(data.items)
     };
     
     // WICHTIG: ERST die Daten setzen, DANN den Ladestatus ändern!
@@ -242,8 +162,10 @@ export const useFileLoader = (
       // DANN den Ladestatus auf 'complete' setzen
       setLoadingStatus('complete');
       
-      // Speichere die verarbeiteten Daten im Cache für zukünftige Verwendung
-      saveToCache(CACHE_KEY_SPEC_ITEMS, clonedData);
+      // Speichere die verarbeiteten Daten im Parse-Cache für zukünftige Verwendung
+      if (cacheKeyRef.current) {
+        saveSpecItemCache(cacheKeyRef.current, clonedData);
+      }
       
       // Log-Eintrag erstellen
       if (settings.enableLogging) {
@@ -297,12 +219,12 @@ export const useFileLoader = (
           setLoadProgress(20);
           
           // Schritt 2: Tatsächliches Parsing in einem separaten Timer
-          setTimeout(() => {
+          setTimeout(async () => {
             try {
               setLoadProgress(40);
-              // Hauptdaten verarbeiten mit Fortschrittsanzeige
+              // Hauptdaten verarbeiten mit Fortschrittsanzeige (große Spec_item-Dateien parallel in Webworkern)
               console.log("Starting main data parsing...");
-              const parsedData = parseTextFile(content);
+              const parsedData = await parseTextFileParallel(content);
               console.log("Parsing complete");
               setLoadProgress(70);
               
@@ -448,6 +370,7 @@ export const useFileLoader = (
 
   // Hauptfunktion zum Laden der Datei mit Caching-Unterstützung
   const handleLoadFile = async (content: string, propItemContent?: string) => {
+    clearLegacyCache();
     setIsLoading(true);
     setLoadingStatus('loading');
     setLoadProgress(0);
@@ -479,20 +402,16 @@ export const useFileLoader = (
       // Den Prozess in einen nicht-blockierenden Kontext verlagern
       setTimeout(async () => {
         try {
-          // Prüfe zunächst, ob wir einen Cache haben
-          let cachedData = null;
+          // Prüfe zunächst, ob es für genau diesen Inhalt (und diese propItem-Datei) einen Cache-Eintrag gibt
+          let cachedData: FileData | null = null;
+          cacheKeyRef.current = null;
           
-          // Berechne einen Hash des Inhalts, um zu prüfen, ob die Datei sich geändert hat
-          const contentHash = await computeSimpleHash(content);
-          const currentCachedHash = localStorage.getItem(`${CACHE_KEY_SPEC_ITEMS}_hash`);
-          
-          // Wenn der Hash übereinstimmt, versuche den Cache zu verwenden
-          if (contentHash === currentCachedHash) {
-            console.log('Content-Hash stimmt überein, versuche Cache zu verwenden');
-            cachedData = loadFromCache(CACHE_KEY_SPEC_ITEMS);
-          } else {
-            console.log('Content hat sich geändert oder wurde noch nie gecacht');
-            localStorage.setItem(`${CACHE_KEY_SPEC_ITEMS}_hash`, contentHash);
+          if (isParseCacheAvailable()) {
+            cacheKeyRef.current = await getSpecItemCacheKey(content, propItemContent);
+            cachedData = await loadSpecItemCache(cacheKeyRef.current);
+            if (!cachedData) {
+              console.log('Kein Parse-Cache-Eintrag für diesen Inhalt');
+            }
           }
           
           if (cachedData) {
@@ -624,6 +543,49 @@ export const useFileLoader = (
     initialPropItemContent
   ]);
 
+  // Externe Änderungen an Spec_item.txt übernehmen (siehe utils/file/resourceWatcher.ts)
+  const fileDataRef = useRef<FileData | null>(null);
+  fileDataRef.current = fileData;
+  
+  useEffect(() => {
+    const handleSpecItemsChanged = async (event: Event) => {
+      const { items, removedIds, lineShift, content, fullReparse } = (event as CustomEvent<SpecItemsChangedDetail>).detail;
+      const current = fileDataRef.current;
+      if (!current || !current.header.includes('szName')) return;
+      
+      try {
+        // auto_-IDs hängen an der Zeilennummer: verschieben sich Zeilen, alles neu parsen
+        if (fullReparse || (lineShift !== 0 && current.items.some(item => item.id.startsWith('auto_')))) {
+          const parsedData = await parseTextFileParallel(content);
+          setFileData({ ...parsedData, items: cloneResourceItems(parsedData.items) });
+          console.log(`Spec_item.txt nach externer Änderung neu geparst: ${parsedData.items.length} Items`);
+          return;
+        }
+        
+        const changed = new Map(cloneResourceItems(items).map(item => [item.id, item]));
+        const removed = new Set(removedIds);
+        
+        setFileData(prev => {
+          if (!prev) return prev;
+          const existing = new Set(prev.items.map(item => item.id));
+          const nextItems = prev.items
+            .filter(item => !removed.has(item.id))
+            .map(item => changed.get(item.id) || item);
+          changed.forEach((item, id) => {
+            if (!existing.has(id)) nextItems.push(item);
+          });
+          return { ...prev, items: nextItems };
+        });
+        console.log(`Spec_item.txt extern geändert: ${changed.size} Items aktualisiert, ${removed.size} entfernt`);
+      } catch (error) {
+        console.error("Fehler beim Übernehmen der Änderungen an Spec_item.txt:", error);
+      }
+    };
+    
+    window.addEventListener('specItemsChanged', handleSpecItemsChanged);
+    return () => window.removeEventListener('specItemsChanged', handleSpecItemsChanged);
+  }, []);
+
   // Implementierung der loadDefaultFiles-Funktion
   const loadDefaultFiles = async () => {
     setIsLoading(true);
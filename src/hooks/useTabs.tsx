@@ -270,12 +270,20 @@ export const saveModifiedTabs = (tabs: any[], fileData: any): Promise<boolean> =
     ensurePropItemConsistency(fileData);
   }
   
+  // Nur einmal speichern; der Hinweis folgt demselben Vorgang
+  const saving = saveAllModifiedFiles().then(results => {
+    if (results.some(result => !result.endsWith(': SUCCESS'))) {
+      throw new Error(results.join(', '));
+    }
+    return true;
+  });
+  
   // Hinweis anzeigen
-  toast.promise(saveAllModifiedFiles(), {
+  toast.promise(saving, {
     loading: `Speichere ${modifiedTabs.length} modifizierte Tabs...`,
     success: `${modifiedTabs.length} Tabs erfolgreich gespeichert`,
     error: "Fehler beim Speichern der Tabs"
   });
   
-  return saveAllModifiedFiles();
+  return saving.catch(() => false);
 };
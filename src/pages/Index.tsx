@@ -12,7 +12,7 @@ import OpenTabs from "../components/main/OpenTabs";
 import ChangelogDialog from "../components/ChangelogDialog";
 import CollectingPage from "../components/collector/CollectingPage";
 import { ResourceItem, FileUploadConfig, LogEntry } from "../types/fileTypes";
-import { serializeToText, saveTextFile, saveAllModifiedFiles, getModifiedFiles, savePropItemChanges } from "../utils/file/fileOperations";
+import { saveTextFile, saveAllModifiedFiles, getModifiedFiles, savePropItemChanges, trackSpecItemFields, materializeJournalFile, saveSpecItemAs } from "../utils/file/fileOperations";
 import { toast } from "sonner";
 import { useResourceState } from "../hooks/useResourceState";
 import { tabs, getFilteredItems } from "../utils/tabUtils";
@@ -134,12 +134,13 @@ const Index = () => {
       console.log(`Saving the currently selected item (${selectedItem.id})`);
       await savePropItemChanges([itemToSave]);
       
-      // Speichere die Haupt-Datei
-      const content = serializeToText(fileData);
-      const savedToResource = await saveTextFile(content, "Spec_Item.txt");
+      // Änderungen des Items an seiner Zeile in Spec_Item.txt vormerken; gespeichert werden sie mit
+      // allen anderen vorgemerkten Änderungen, die übrigen Zeilen bleiben unverändert
+      trackSpecItemFields(itemToSave);
       
       // Speichere alle modifizierten Dateien
-      const allSaved = await saveAllModifiedFiles([]);
+      const results = await saveAllModifiedFiles();
+      const allSaved = results.every(result => result.endsWith(': SUCCESS'));
       
       // Log-Eintrag erstellen
       if (settings.enableLogging) {
@@ -154,7 +155,7 @@ const Index = () => {
         setLogEntries(prev => [newLogEntry, ...prev]);
       }
       
-      if (savedToResource && allSaved) {
+      if (allSaved) {
         toast.success(`Element "${selectedItem.name}" successfully saved`);
       } else {
         toast.warning(`Element "${selectedItem.name}" saved, but there were problems saving some files`);
@@ -183,12 +184,12 @@ const Index = () => {
       console.log(`Saving ${tabItems.length} items from open tabs`);
       await savePropItemChanges(tabItems);
       
-      // Speichere die Haupt-Datei
-      const content = serializeToText(fileData);
-      const savedToResource = await saveTextFile(content, "Spec_Item.txt");
+      // Änderungen der Items an ihren Zeilen in Spec_Item.txt vormerken
+      tabItems.forEach(item => trackSpecItemFields(item));
       
       // Speichere alle modifizierten Dateien
-      const allSaved = await saveAllModifiedFiles([]);
+      const results = await saveAllModifiedFiles();
+      const allSaved = results.every(result => result.endsWith(': SUCCESS'));
       
       // Log-Eintrag erstellen
       if (settings.enableLogging) {
@@ -203,7 +204,7 @@ const Index = () => {
         setLogEntries(prev => [newLogEntry, ...prev]);
       }
       
-      if (savedToResource && allSaved) {
+      if (allSaved) {
         toast.success(`All ${tabItems.length} tabs successfully saved`);
       } else {
         toast.warning(`Tabs saved, but there were problems saving some files`);
@@ -218,17 +219,27 @@ const Index = () => {
     if (!fileData) return;
     
     try {
-      const content = serializeToText(fileData);
-      
+      // Geladener Stand von Spec_Item.txt mit den vorgemerkten Änderungen (nicht aus den Items erzeugt)
       const isDownload = fileName.endsWith('.download');
       let actualFileName = fileName;
       let savedToResource = false;
       
       if (isDownload) {
         actualFileName = fileName.replace('.download', '');
+        const content = await materializeJournalFile("Spec_Item.txt");
+        if (!content) {
+          toast.error("Spec_Item.txt is not loaded, nothing to save");
+          return;
+        }
         await saveTextFile(content, actualFileName);
       } else {
-        savedToResource = await saveTextFile(content, fileName);
+        // Die Zeilen werden in Teilen geschrieben, ohne den ganzen Inhalt als String
+        const saved = await saveSpecItemAs(fileName);
+        if (saved === null) {
+          toast.error("Spec_Item.txt is not loaded, nothing to save");
+          return;
+        }
+        savedToResource = saved;
       }
       
       if (settings.enableLogging) {
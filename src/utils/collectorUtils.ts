@@ -1,4 +1,5 @@
 import { CollectorData, CollectingEnchant, CollectingItem, CollectorValidationResult } from "../types/collectorTypes";
+import { detectLineEnding, editLines } from "./file/roundTrip";
 
 /**
  * Parst die Collector-Daten aus der s.txt-Datei
@@ -152,11 +153,98 @@ export const parseCollectorData = (content: string): CollectorData => {
   return data;
 };
 
+// Datenzeilen wie in parseCollectorData erkennen (getrimmte Zeile)
+const isEnchantLine = (line: string): boolean => !!line && !line.startsWith('//') && /^\s*\d+/.test(line);
+const isItemLine = (line: string): boolean => !!line && !line.startsWith('//') && line.includes('II_');
+
+// Chance einer Enchant-Zeile ersetzen (erste Zahl), Tabs und Kommentar bleiben
+const updateEnchantLine = (line: string, enchant: CollectingEnchant): string | undefined => {
+  const current = parseInt(line.trim(), 10);
+  if (current === enchant.chance) return undefined;
+  return line.replace(/\d+/, String(enchant.chance));
+};
+
+// ItemID (erstes Wort) und Wahrscheinlichkeit (letzte Zahl vor dem Kommentar) einer Item-Zeile ersetzen
+const updateItemLine = (line: string, item: CollectingItem): string | undefined => {
+  const commentStart = line.indexOf('//');
+  const codeEnd = commentStart === -1 ? line.length : commentStart;
+  let code = line.slice(0, codeEnd);
+  const parts = code.trim().split(/\s+/);
+  const itemId = parts[0];
+  const probability = parseInt(parts[parts.length - 1], 10);
+  if (itemId === item.itemId && probability === item.probability) return undefined;
+  
+  if (probability !== item.probability) {
+    code = code.replace(/\d+(\s*)$/, `${item.probability}$1`);
+  }
+  if (itemId !== item.itemId) {
+    const idStart = code.indexOf(itemId);
+    code = code.slice(0, idStart) + item.itemId + code.slice(idStart + itemId.length);
+  }
+  return code + line.slice(codeEnd);
+};
+
+/**
+ * Überträgt geänderte Werte byte-genau in einen Abschnitt: nur Zeilen mit geänderten Werten werden
+ * angefasst, Kommentare, Einrückung, Tabs am Zeilenende und Zeilenenden bleiben erhalten
+ * @returns Der neue Abschnittsinhalt oder null, wenn Einträge hinzugekommen oder entfernt worden sind
+ */
+const updateSectionValues = <T>(
+  body: string,
+  values: T[],
+  isDataLine: (line: string) => boolean,
+  updateLine: (line: string, value: T) => string | undefined
+): string | null => {
+  const count = body.split('\n').filter(line => isDataLine(line.trim())).length;
+  if (count !== values.length) return null;
+  
+  let index = 0;
+  return editLines(body, line => isDataLine(line.trim()) ? updateLine(line, values[index++]) : undefined);
+};
+
+// Abschnitte in der Reihenfolge von parseCollectorData
+const COLLECTOR_SECTIONS: { pattern: RegExp; values: (data: CollectorData) => any[]; isDataLine: (line: string) => boolean; updateLine: (line: string, value: any) => string | undefined }[] = [
+  { pattern: /([Cc]ollecting_[Ee]nchant[^{]*{)([^}]*)(})/s, values: data => data.enchant, isDataLine: isEnchantLine, updateLine: updateEnchantLine },
+  { pattern: /([Cc]ollecting_[Ii]tem(?!\s*_)[^{]*{)([^}]*)(})/s, values: data => data.items, isDataLine: isItemLine, updateLine: updateItemLine },
+  { pattern: /([Cc]ollecting_[Pp]remium[Ii]tem[^{]*{)([^}]*)(})/s, values: data => data.premiumItems, isDataLine: isItemLine, updateLine: updateItemLine },
+  { pattern: /([Cc]ollecting_[Pp]remium[Ss]tatus[Ii]tem[^{]*{)([^}]*)(})/s, values: data => data.premiumStatusItems, isDataLine: isItemLine, updateLine: updateItemLine }
+];
+
+/**
+ * Byte-genaues Zurückschreiben: geänderte Werte in den Zeilen von originalContent ersetzen
+ * @returns Der neue Inhalt (originalContent selbst ohne Änderungen) oder null, wenn sich die Zahl
+ *          der Einträge eines Abschnitts geändert hat
+ */
+const updateCollectorValues = (data: CollectorData, originalContent: string): string | null => {
+  let newContent = originalContent;
+  
+  for (const section of COLLECTOR_SECTIONS) {
+    const values = section.values(data);
+    if (values.length === 0) continue;
+    
+    const match = originalContent.match(section.pattern);
+    if (!match) continue;
+    
+    const body = updateSectionValues(match[2], values, section.isDataLine, section.updateLine);
+    if (body === null) return null;
+    if (body !== match[2]) {
+      newContent = newContent.replace(match[0], () => `${match[1]}${body}${match[3]}`);
+    }
+  }
+  
+  return newContent;
+};
+
 /**
  * Serialisiert die Collector-Daten zurück in das s.txt-Format
+ * Unveränderte Zeilen bleiben byte-genau erhalten; nur wenn Einträge hinzugefügt oder entfernt
+ * wurden, werden die betroffenen Abschnitte neu geschrieben (im Zeilenende der Datei).
  */
 export const serializeCollectorData = (data: CollectorData, originalContent: string): string => {
   try {
+    const updated = updateCollectorValues(data, originalContent);
+    if (updated !== null) return updated;
+    
     let newContent = originalContent;
     
     // Enchantment-Bereich aktualisieren
@@ -274,7 +362,8 @@ export const serializeCollectorData = (data: CollectorData, originalContent: str
       }
     }
     
-    return newContent;
+    // Neu erzeugte Abschnitte im Zeilenende der Datei
+    return detectLineEnding(originalContent) === '\r\n' ? newContent.replace(/\r?\n/g, '\r\n') : newContent;
   } catch (error) {
     console.error("Error serializing collector data:", error);
     return originalContent;
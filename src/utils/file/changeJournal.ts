@@ -0,0 +1,322 @@
+/**
+ * Änderungsjournal: ungespeicherte Änderungen als einzelne Felder
+ *
+ * Statt für jede geänderte Datei ihren vollständigen Inhalt vorzuhalten, wird jede Änderung
+ * als (Datei, Zeilenschlüssel, Spalte, alter Wert, neuer Wert) gemerkt, z.B.
+ * ("Spec_Item.txt", "II_WEA_AXE_RODNEY", "dwAbilityMin", "10", "12"). Mehrfache Änderungen
+ * desselben Felds werden zusammengefasst: der alte Wert bleibt der aus der Datei, der neue ist
+ * der zuletzt gesetzte; bekommt ein Feld wieder seinen alten Wert, verschwindet der Eintrag.
+ *
+ * Beim Speichern setzt fileOperations.ts (materializeJournalFile) nur die betroffenen Zeilen
+ * neu zusammen; die Anzeige (LoggingSystem) liest die Einträge als Feld-Diff.
+ *
+ * Wird eine Datei mit vorgemerkten Änderungen extern geändert, gleicht rebaseChanges die
+ * Einträge mit dem neuen Stand ab (resourceWatcher.ts). Felder, die extern anders geändert
+ * wurden, sind Konflikte: die Datei wird erst wieder gespeichert, wenn sie aufgelöst sind.
+ */
+import { LogEntry } from "../../types/fileTypes";
+
+export interface FieldChange {
+  file: string;
+  rowKey: string;
+  column: string;
+  // Wert in der Datei (vor der ersten Änderung) und zuletzt gesetzter Wert
+  oldValue: string;
+  newValue: string;
+  // Zeitpunkt der letzten Änderung
+  timestamp: number;
+  // Anzeigename der Zeile (z.B. Item-Name), nur für die Anzeige
+  label?: string;
+  // Wert nach einer externen Änderung der Datei, der weder der alte noch der neue ist (Konflikt)
+  externalValue?: string;
+}
+
+// Ausgelöst (auf window), wenn sich das Journal geändert hat; detail: { files }
+export const CHANGE_JOURNAL_EVENT = 'changeJournalUpdated';
+
+interface FileJournal {
+  fileName: string;
+  // Zeilenschlüssel -> Spalte -> Eintrag (in der Reihenfolge der ersten Änderung)
+  rows: Map<string, Map<string, FieldChange>>;
+  // Datei wurde extern geändert und die Änderungen ließen sich nicht feldweise abgleichen
+  externalConflict?: boolean;
+}
+
+const journals = new Map<string, FileJournal>();
+
+// Beobachter verworfener Einträge (clearJournal), z.B. um dafür vergebene IDs wieder freizugeben
+type DiscardListener = (fileName: string, discarded: FieldChange[]) => void;
+const discardListeners = new Set<DiscardListener>();
+
+const normalizeName = (fileName: string): string =>
+  fileName.split(/[\\/]/).pop()!.toLowerCase();
+
+// Mehrere Änderungen in einem Durchlauf (z.B. alle Items eines Tabs) lösen nur ein Event aus
+const changedFiles = new Set<string>();
+let notifyQueued = false;
+
+const notify = (fileName: string): void => {
+  changedFiles.add(fileName);
+  if (notifyQueued || typeof window === 'undefined') return;
+  notifyQueued = true;
+  queueMicrotask(() => {
+    notifyQueued = false;
+    const files = [...changedFiles];
+    changedFiles.clear();
+    window.dispatchEvent(new CustomEvent(CHANGE_JOURNAL_EVENT, { detail: { files } }));
+  });
+};
+
+const removeEntry = (journal: FileJournal, rowKey: string, column: string): void => {
+  const row = journal.rows.get(rowKey);
+  if (!row) return;
+  row.delete(column);
+  if (row.size === 0) journal.rows.delete(rowKey);
+  if (journal.rows.size === 0) journals.delete(normalizeName(journal.fileName));
+};
+
+/**
+ * Merkt die Änderung eines Felds vor
+ * @param oldValue Wert in der Datei; wird ignoriert, wenn das Feld bereits geändert ist
+ * @param label Anzeigename der Zeile
+ * @returns true, wenn das Feld danach eine ungespeicherte Änderung hat
+ */
+export const recordChange = (
+  fileName: string,
+  rowKey: string,
+  column: string,
+  oldValue: string,
+  newValue: string,
+  label?: string
+): boolean => {
+  const key = normalizeName(fileName);
+  const journal = journals.get(key);
+  const entry = journal?.rows.get(rowKey)?.get(column);
+
+  if (entry) {
+    if (entry.newValue === newValue && (label === undefined || entry.label === label)) return true;
+    if (newValue === entry.oldValue) {
+      removeEntry(journal!, rowKey, column);
+      notify(fileName);
+      return false;
+    }
+    entry.newValue = newValue;
+    entry.timestamp = Date.now();
+    if (label !== undefined) entry.label = label;
+    notify(fileName);
+    return true;
+  }
+
+  if (newValue === oldValue) return false;
+
+  let target = journal;
+  if (!target) {
+    target = { fileName, rows: new Map() };
+    journals.set(key, target);
+  }
+  let row = target.rows.get(rowKey);
+  if (!row) {
+    row = new Map();
+    target.rows.set(rowKey, row);
+  }
+  row.set(column, { file: target.fileName, rowKey, column, oldValue, newValue, timestamp: Date.now(), label });
+  notify(fileName);
+  return true;
+};
+
+/**
+ * Ungespeicherte Änderungen (Kopien der Einträge), ohne fileName für alle Dateien
+ */
+export const getPendingChanges = (fileName?: string): FieldChange[] => {
+  const result: FieldChange[] = [];
+  const collect = (journal: FileJournal) =>
+    journal.rows.forEach(row => row.forEach(entry => result.push({ ...entry })));
+
+  if (fileName === undefined) {
+    journals.forEach(collect);
+  } else {
+    const journal = journals.get(normalizeName(fileName));
+    if (journal) collect(journal);
+  }
+  return result;
+};
+
+/**
+ * Neue Werte einer Zeile (Spalte -> Wert) oder undefined, wenn die Zeile unverändert ist
+ */
+export const getPendingRow = (fileName: string, rowKey: string): Map<string, string> | undefined => {
+  const row = journals.get(normalizeName(fileName))?.rows.get(rowKey);
+  if (!row) return undefined;
+  const values = new Map<string, string>();
+  row.forEach((entry, column) => values.set(column, entry.newValue));
+  return values;
+};
+
+/**
+ * Neue Werte aller geänderten Zeilen einer Datei (Zeilenschlüssel -> Spalte -> Wert)
+ */
+export const getPendingRows = (fileName: string): Map<string, Map<string, string>> => {
+  const rows = new Map<string, Map<string, string>>();
+  journals.get(normalizeName(fileName))?.rows.forEach((_, rowKey) => {
+    rows.set(rowKey, getPendingRow(fileName, rowKey)!);
+  });
+  return rows;
+};
+
+export const hasPendingChanges = (fileName?: string): boolean =>
+  fileName === undefined ? journals.size > 0 : journals.has(normalizeName(fileName));
+
+/**
+ * Dateien mit ungespeicherten Änderungen (Namen wie bei der ersten Änderung angegeben)
+ */
+export const getJournalFiles = (): string[] =>
+  [...journals.values()].map(journal => journal.fileName);
+
+/**
+ * Übernimmt gespeicherte Werte: Einträge, deren neuer Wert geschrieben wurde, entfallen;
+ * wurde ein Feld während des Speicherns erneut geändert, gilt der gespeicherte Wert als neuer alter Wert
+ * @param saved Die vor dem Speichern gelesenen Einträge (getPendingChanges)
+ */
+export const commitChanges = (
+  fileName: string,
+  saved: Pick<FieldChange, 'rowKey' | 'column' | 'newValue'>[]
+): void => {
+  const journal = journals.get(normalizeName(fileName));
+  if (!journal) return;
+
+  for (const { rowKey, column, newValue } of saved) {
+    const entry = journal.rows.get(rowKey)?.get(column);
+    if (!entry) continue;
+    if (entry.newValue === newValue) {
+      removeEntry(journal, rowKey, column);
+    } else {
+      entry.oldValue = newValue;
+    }
+  }
+  notify(fileName);
+};
+
+/**
+ * Gleicht die vorgemerkten Änderungen einer Datei mit ihrem extern geänderten Stand ab
+ * Felder mit unverändertem Wert bleiben vorgemerkt, extern bereits gesetzte Werte entfallen;
+ * Felder mit einem anderen Wert werden als Konflikt markiert (externalValue).
+ * @param readValue Wert eines Felds im neuen Stand (getrimmt); undefined, wenn es die Zeile nicht mehr gibt
+ * @returns Konflikte und die verworfenen Einträge von Zeilen, die es nicht mehr gibt
+ */
+export const rebaseChanges = (
+  fileName: string,
+  readValue: (rowKey: string, column: string) => string | undefined
+): { conflicts: FieldChange[]; discarded: FieldChange[] } => {
+  const conflicts: FieldChange[] = [];
+  const discarded: FieldChange[] = [];
+  const journal = journals.get(normalizeName(fileName));
+  if (!journal) return { conflicts, discarded };
+
+  getPendingChanges(fileName).forEach(change => {
+    const entry = journal.rows.get(change.rowKey)!.get(change.column)!;
+    const value = readValue(change.rowKey, change.column);
+    if (value === undefined) {
+      removeEntry(journal, change.rowKey, change.column);
+      discarded.push(change);
+    } else if (value === entry.newValue.trim()) {
+      removeEntry(journal, change.rowKey, change.column);
+    } else if (value !== entry.oldValue.trim()) {
+      entry.externalValue = value;
+      conflicts.push({ ...entry });
+    } else {
+      delete entry.externalValue;
+    }
+  });
+  notify(fileName);
+  return { conflicts, discarded };
+};
+
+/**
+ * Sperrt das Speichern einer Datei, deren externe Änderung sich nicht feldweise abgleichen ließ
+ */
+export const markExternalConflict = (fileName: string): void => {
+  const journal = journals.get(normalizeName(fileName));
+  if (!journal) return;
+  journal.externalConflict = true;
+  notify(fileName);
+};
+
+/**
+ * Hat die Datei nicht aufgelöste Konflikte mit einer externen Änderung?
+ */
+export const hasJournalConflicts = (fileName: string): boolean => {
+  const journal = journals.get(normalizeName(fileName));
+  if (!journal) return false;
+  if (journal.externalConflict) return true;
+  for (const row of journal.rows.values()) {
+    for (const entry of row.values()) {
+      if (entry.externalValue !== undefined) return true;
+    }
+  }
+  return false;
+};
+
+/**
+ * Löst die Konflikte einer Datei auf
+ * @param keepMine true: die eigenen Werte bleiben vorgemerkt und überschreiben beim Speichern die
+ * externen; false: die Einträge mit Konflikt entfallen, es gilt der externe Wert
+ * @returns Die Einträge, die einen Konflikt hatten
+ */
+export const resolveJournalConflicts = (fileName: string, keepMine: boolean): FieldChange[] => {
+  const journal = journals.get(normalizeName(fileName));
+  if (!journal) return [];
+
+  const resolved: FieldChange[] = [];
+  getPendingChanges(fileName).forEach(change => {
+    if (change.externalValue === undefined) return;
+    resolved.push(change);
+    const entry = journal.rows.get(change.rowKey)!.get(change.column)!;
+    delete entry.externalValue;
+    if (!keepMine || entry.newValue === change.externalValue) {
+      removeEntry(journal, change.rowKey, change.column);
+    } else {
+      entry.oldValue = change.externalValue;
+    }
+  });
+  journal.externalConflict = false;
+  notify(fileName);
+  return resolved;
+};
+
+/**
+ * Verwirft ungespeicherte Änderungen einer Datei (ohne fileName: aller Dateien)
+ */
+export const clearJournal = (fileName?: string): void => {
+  const cleared = fileName === undefined
+    ? [...journals.values()]
+    : [journals.get(normalizeName(fileName))].filter((journal): journal is FileJournal => !!journal);
+
+  cleared.forEach(journal => {
+    const discarded = getPendingChanges(journal.fileName);
+    journals.delete(normalizeName(journal.fileName));
+    discardListeners.forEach(listener => listener(journal.fileName, discarded));
+    notify(journal.fileName);
+  });
+};
+
+/**
+ * Meldet die von clearJournal verworfenen Einträge je Datei
+ * @returns Funktion zum Abmelden
+ */
+export const onJournalDiscard = (listener: DiscardListener): (() => void) => {
+  discardListeners.add(listener);
+  return () => { discardListeners.delete(listener); };
+};
+
+/**
+ * Ungespeicherte Änderungen als Log-Einträge für die Anzeige (ein Eintrag je Feld)
+ */
+export const getPendingLogEntries = (): LogEntry[] =>
+  getPendingChanges().map(change => ({
+    timestamp: change.timestamp,
+    itemId: change.rowKey,
+    itemName: change.label || change.rowKey,
+    field: `${change.file}: ${change.column}`,
+    oldValue: change.oldValue,
+    newValue: change.newValue
+  }));
@@ -0,0 +1,558 @@
+/**
+ * Spaltenorientierter Speicher für tabellarische Ressourcendateien (Spec_item.txt)
+ *
+ * Statt eines Objekts mit ~200 Eigenschaften pro Zeile wird jede Header-Spalte
+ * einmal gespeichert:
+ *  - int:  rein numerische Spalten als Int32Array ("=" und fehlende Werte als Sentinel)
+ *  - dict: Spalten mit wenigen verschiedenen Werten (IK1_*, DST_*, ...) als Codes + Wörterbuch
+ *  - text: alle übrigen Spalten als String-Array
+ * ResourceItem.data ist eine leichtgewichtige Sicht (Proxy) auf eine Zeile und verhält
+ * sich für lesenden und schreibenden Code wie das bisherige ItemData-Objekt.
+ */
+import { ItemData } from "../../types/fileTypes";
+import { type TabTable } from "./tabScanner";
+import { type SpecItemSchema, getSpecItemSchema } from "./specItemSchema";
+
+export type ColumnKind = 'int' | 'dict' | 'text';
+
+interface Column {
+  kind: ColumnKind;
+  ints?: Int32Array;
+  codes?: Uint16Array | Uint32Array;
+  dictionary?: (string | undefined)[];
+  dictionaryIndex?: Map<string, number>;
+  texts?: (string | undefined)[];
+}
+
+// Serialisierbare Form (z.B. für die Übertragung aus einem Webworker oder den Parse-Cache)
+export interface ColumnStoreSnapshot {
+  header: string[];
+  rowCount: number;
+  columns: Column[];
+  // Zusätzliche Eigenschaften je Zeile (nur wenn vorhanden)
+  overflow?: [number, Record<string, any>][];
+}
+
+const INT_EQUALS = -0x80000000; // "="
+const INT_ABSENT = -0x7fffffff; // Zeile hat diese Spalte nicht
+const MAX_DICTIONARY_SIZE = 0xffff;
+
+const isCanonicalInt = (value: string): boolean => {
+  const length = value.length;
+  if (length === 0 || length > 11) return false;
+
+  let i = value.charCodeAt(0) === 45 ? 1 : 0; // '-'
+  if (i === length) return false;
+  // Führende Nullen ("007") oder "-0" würden beim Zurückschreiben verloren gehen
+  if (value.charCodeAt(i) === 48 && (length - i > 1 || i === 1)) return false;
+
+  for (; i < length; i++) {
+    const code = value.charCodeAt(i);
+    if (code < 48 || code > 57) return false;
+  }
+
+  const number = Number(value);
+  return number > INT_ABSENT && number <= 0x7fffffff;
+};
+
+const chooseKind = (values: (string | undefined)[]): ColumnKind => {
+  let allInt = true;
+  const distinct = new Set<string>();
+
+  for (const value of values) {
+    if (value === undefined) continue;
+    if (allInt && value !== '=' && !isCanonicalInt(value)) allInt = false;
+    if (distinct.size <= MAX_DICTIONARY_SIZE) distinct.add(value);
+  }
+
+  if (allInt) return 'int';
+  // Wörterbuch lohnt sich nur, wenn sich Werte tatsächlich wiederholen
+  if (distinct.size <= MAX_DICTIONARY_SIZE && distinct.size * 2 <= values.length) return 'dict';
+  return 'text';
+};
+
+const encodeColumn = (kind: ColumnKind, values: (string | undefined)[]): Column => {
+  const rowCount = values.length;
+
+  if (kind === 'int') {
+    const ints = new Int32Array(rowCount);
+    for (let i = 0; i < rowCount; i++) {
+      const value = values[i];
+      ints[i] = value === undefined ? INT_ABSENT : value === '=' ? INT_EQUALS : Number(value);
+    }
+    return { kind, ints };
+  }
+
+  if (kind === 'dict') {
+    // Code 0 steht für "Spalte fehlt"
+    const dictionary: (string | undefined)[] = [undefined];
+    const dictionaryIndex = new Map<string, number>();
+    const codes = new Uint16Array(rowCount);
+    for (let i = 0; i < rowCount; i++) {
+      const value = values[i];
+      if (value === undefined) continue;
+      let code = dictionaryIndex.get(value);
+      if (code === undefined) {
+        code = dictionary.length;
+        dictionary.push(value);
+        dictionaryIndex.set(value, code);
+      }
+      codes[i] = code;
+    }
+    return { kind, codes, dictionary, dictionaryIndex };
+  }
+
+  return { kind: 'text', texts: values.slice() };
+};
+
+const decodeValue = (column: Column, row: number): string | undefined => {
+  switch (column.kind) {
+    case 'int': {
+      const value = column.ints![row];
+      return value === INT_ABSENT ? undefined : value === INT_EQUALS ? '=' : String(value);
+    }
+    case 'dict':
+      return column.dictionary![column.codes![row]];
+    default:
+      return column.texts![row];
+  }
+};
+
+export class ColumnStore {
+  readonly header: string[];
+  // Kompiliertes Schema der Kopfzeile (Spaltenname -> Index, geteilt mit Parser und Serialisierer)
+  readonly schema: SpecItemSchema;
+  private rows: number;
+  private readonly columns: Column[];
+  // 1 = Spalte wird noch mit einem per fork() verbundenen Speicher geteilt (Kopie beim ersten Schreiben)
+  private readonly sharedColumns: Uint8Array;
+  // Zusätzliche, nicht im Header enthaltene Eigenschaften je Zeile
+  private readonly overflow = new Map<number, Record<string, any>>();
+  // Zeilen, in die seit dem Laden geschrieben wurde (set); alle anderen haben noch die Werte der Datei
+  private readonly writtenRows = new Set<number>();
+
+  private constructor(header: string[], rowCount: number, columns: Column[]) {
+    this.header = header;
+    this.schema = getSpecItemSchema(header);
+    this.rows = rowCount;
+    this.columns = columns;
+    this.sharedColumns = new Uint8Array(columns.length);
+  }
+
+  /**
+   * Erstellt den Speicher direkt aus einer gescannten Tabelle (tabScanner.ts)
+   * Numerische Spalten werden aus den Bytes gelesen, ohne Strings zu erzeugen.
+   * @param header Spaltennamen
+   * @param table Gescannte Zeilen
+   * @param rows Zeilen der Tabelle, die in den Speicher übernommen werden (in Reihenfolge)
+   * Text- und Wörterbuchwerte gehen über den String-Pool der Tabelle (TabTable.setIntern).
+   */
+  static fromTable(header: string[], table: TabTable, rows: ArrayLike<number>): ColumnStore {
+    const rowCount = rows.length;
+    const columnCount = header.length;
+    const ints: (Int32Array | null)[] = header.map(() => new Int32Array(rowCount));
+
+    // Zeilenweise lesen (die Zellen einer Zeile liegen im Puffer hintereinander)
+    for (let i = 0; i < rowCount; i++) {
+      const row = rows[i];
+      const cells = table.cellCount(row);
+      for (let j = 0; j < columnCount; j++) {
+        const target = ints[j];
+        if (!target) continue;
+        if (j >= cells) {
+          target[i] = INT_ABSENT;
+          continue;
+        }
+        const value = table.getIntCell(row, j);
+        if (value > INT_ABSENT) {
+          target[i] = value;
+        } else if (table.cellIsChar(row, j, 61)) { // '='
+          target[i] = INT_EQUALS;
+        } else {
+          ints[j] = null;
+        }
+      }
+    }
+
+    // Nicht-numerische Spalten in einem zweiten Durchlauf dekodieren
+    const textColumns: number[] = [];
+    const values: (string | undefined)[][] = [];
+    for (let j = 0; j < columnCount; j++) {
+      if (!ints[j]) {
+        textColumns.push(j);
+        values.push(new Array(rowCount));
+      }
+    }
+
+    for (let i = 0; i < rowCount; i++) {
+      const row = rows[i];
+      for (let k = 0; k < textColumns.length; k++) {
+        values[k][i] = table.getCell(row, textColumns[k]);
+      }
+    }
+
+    const columns: Column[] = ints.map(column => ({ kind: 'int', ints: column! }));
+    textColumns.forEach((j, k) => {
+      columns[j] = encodeColumn(chooseKind(values[k]), values[k]);
+    });
+
+    return new ColumnStore(header, rowCount, columns);
+  }
+
+  static fromSnapshot(snapshot: ColumnStoreSnapshot): ColumnStore {
+    const columns = snapshot.columns.map(column => {
+      if (column.kind !== 'dict') return column;
+      // Der Index wird nicht übertragen, sondern aus dem Wörterbuch neu aufgebaut
+      const dictionaryIndex = new Map<string, number>();
+      column.dictionary!.forEach((value, code) => {
+        if (value !== undefined) dictionaryIndex.set(value, code);
+      });
+      return { ...column, dictionaryIndex };
+    });
+    const store = new ColumnStore(snapshot.header, snapshot.rowCount, columns);
+    snapshot.overflow?.forEach(([row, extra]) => store.overflow.set(row, extra));
+    return store;
+  }
+
+  /**
+   * Hängt mehrere Speicher mit gleichem Header in Reihenfolge aneinander
+   * (z.B. die Ergebnisse der Worker-Abschnitte)
+   * @param intern Optionale Funktion des String-Pools für Text- und Wörterbuchwerte
+   */
+  static concat(stores: ColumnStore[], intern?: (value: string) => string): ColumnStore {
+    if (stores.length === 1) return stores[0];
+
+    const header = stores[0].header;
+    const rowCount = stores.reduce((sum, store) => sum + store.rowCount, 0);
+    const columns: Column[] = new Array(header.length);
+
+    for (let j = 0; j < header.length; j++) {
+      if (stores.every(store => store.columns[j].kind === 'int')) {
+        // Numerische Spalten direkt zusammenkopieren
+        const ints = new Int32Array(rowCount);
+        let offset = 0;
+        stores.forEach(store => {
+          ints.set(store.columns[j].ints!, offset);
+          offset += store.rowCount;
+        });
+        columns[j] = { kind: 'int', ints };
+        continue;
+      }
+
+      const values: (string | undefined)[] = new Array(rowCount);
+      let offset = 0;
+      stores.forEach(store => {
+        // Wörterbuchspalten liefern je Wert dieselbe Instanz; jede nur einmal durch den Pool
+        const pooled = new Map<string, string>();
+        for (let row = 0; row < store.rowCount; row++) {
+          let value = store.get(row, j);
+          if (intern && value !== undefined) {
+            const known = pooled.get(value);
+            if (known === undefined) {
+              const shared = intern(value);
+              pooled.set(value, shared);
+              value = shared;
+            } else {
+              value = known;
+            }
+          }
+          values[offset + row] = value;
+        }
+        offset += store.rowCount;
+      });
+      columns[j] = encodeColumn(chooseKind(values), values);
+    }
+
+    const merged = new ColumnStore(header, rowCount, columns);
+    let offset = 0;
+    stores.forEach(store => {
+      store.overflow.forEach((extra, row) => merged.overflow.set(row + offset, { ...extra }));
+      offset += store.rowCount;
+    });
+    return merged;
+  }
+
+  /**
+   * Serialisierbare Form ohne Maps (Typed Arrays können übertragen werden)
+   */
+  toSnapshot(): { snapshot: ColumnStoreSnapshot; transfer: ArrayBuffer[] } {
+    const transfer: ArrayBuffer[] = [];
+    const columns = this.columns.map(column => {
+      if (column.ints) transfer.push(column.ints.buffer as ArrayBuffer);
+      if (column.codes) transfer.push(column.codes.buffer as ArrayBuffer);
+      return { kind: column.kind, ints: column.ints, codes: column.codes, dictionary: column.dictionary, texts: column.texts };
+    });
+    const snapshot: ColumnStoreSnapshot = { header: this.header, rowCount: this.rows, columns };
+    if (this.overflow.size > 0) {
+      snapshot.overflow = Array.from(this.overflow, ([row, extra]) => [row, { ...extra }] as [number, Record<string, any>]);
+    }
+    return { snapshot, transfer };
+  }
+
+  get rowCount(): number {
+    return this.rows;
+  }
+
+  getColumnIndex(name: string): number {
+    return this.schema.indexOf(name);
+  }
+
+  getColumnKind(column: number): ColumnKind {
+    return this.columns[column].kind;
+  }
+
+  get(row: number, column: number): string | undefined {
+    return decodeValue(this.columns[column], row);
+  }
+
+  /**
+   * Unabhängige Kopie mit Copy-on-Write: beide Speicher teilen sich die Spalten, bis einer von
+   * ihnen in eine Spalte schreibt; erst dann wird diese eine Spalte kopiert
+   */
+  fork(): ColumnStore {
+    const copy = new ColumnStore(this.header, this.rows, this.columns.slice());
+    copy.sharedColumns.fill(1);
+    this.sharedColumns.fill(1);
+    this.overflow.forEach((extra, row) => copy.overflow.set(row, JSON.parse(JSON.stringify(extra))));
+    this.writtenRows.forEach(row => copy.writtenRows.add(row));
+    return copy;
+  }
+
+  // Spalte zum Schreiben; eine noch geteilte Spalte wird vorher kopiert
+  private writableColumn(column: number): Column {
+    if (this.sharedColumns[column]) {
+      const source = this.columns[column];
+      this.columns[column] = {
+        kind: source.kind,
+        ints: source.ints?.slice(),
+        codes: source.codes?.slice(),
+        dictionary: source.dictionary?.slice(),
+        dictionaryIndex: source.dictionaryIndex && new Map(source.dictionaryIndex),
+        texts: source.texts?.slice()
+      };
+      this.sharedColumns[column] = 0;
+    }
+    return this.columns[column];
+  }
+
+  /**
+   * Wurde seit dem Laden in die Zeile geschrieben?
+   */
+  isRowWritten(row: number): boolean {
+    return this.writtenRows.has(row);
+  }
+
+  set(row: number, column: number, value: string | undefined): void {
+    const target = this.writableColumn(column);
+    this.writtenRows.add(row);
+
+    if (target.kind === 'int' && (value === undefined || value === '=' || isCanonicalInt(value))) {
+      target.ints![row] = value === undefined ? INT_ABSENT : value === '=' ? INT_EQUALS : Number(value);
+      return;
+    }
+
+    if (target.kind === 'dict' && value !== undefined) {
+      let code = target.dictionaryIndex!.get(value);
+      if (code === undefined && target.dictionary!.length <= MAX_DICTIONARY_SIZE) {
+        code = target.dictionary!.length;
+        target.dictionary!.push(value);
+        target.dictionaryIndex!.set(value, code);
+      }
+      if (code !== undefined) {
+        target.codes![row] = code;
+        return;
+      }
+    } else if (target.kind === 'dict') {
+      target.codes![row] = 0;
+      return;
+    }
+
+    if (target.kind === 'text') {
+      target.texts![row] = value;
+      return;
+    }
+
+    // Wert passt nicht zur Kodierung: Spalte als Text umschreiben
+    const texts: (string | undefined)[] = new Array(this.rows);
+    for (let i = 0; i < this.rows; i++) texts[i] = decodeValue(target, i);
+    texts[row] = value;
+    this.columns[column] = { kind: 'text', texts };
+  }
+
+  /**
+   * Liefert die Zeile als ItemData-kompatible Sicht
+   */
+  rowView(row: number): ItemData {
+    return new Proxy({ row, store: this } as RowTarget, rowViewHandler) as unknown as ItemData;
+  }
+
+  /**
+   * Kopiert eine Zeile in ein normales Objekt
+   */
+  rowToObject(row: number): ItemData {
+    const data: ItemData = {};
+    rowKeys(this, row).forEach(key => {
+      data[key] = readKey(this, row, key);
+    });
+    return data;
+  }
+
+  /** @internal */
+  _keys(): string[] {
+    return this.schema.keys;
+  }
+
+  /** @internal */
+  _overflow(row: number, create: boolean): Record<string, any> | undefined {
+    let extra = this.overflow.get(row);
+    if (!extra && create) {
+      extra = {};
+      this.overflow.set(row, extra);
+    }
+    return extra;
+  }
+
+  /** @internal */
+  _hasIdAlias(): boolean {
+    return this.schema.hasIdAlias;
+  }
+}
+
+const columnViewMarker = Symbol.for('columnStore.rowView');
+const rowTargetKey = Symbol('columnStore.rowTarget');
+
+interface RowTarget {
+  row: number;
+  store: ColumnStore;
+}
+
+const readKey = (store: ColumnStore, row: number, key: string): any => {
+  const extra = store._overflow(row, false);
+  if (extra && key in extra) return extra[key];
+
+  const column = store.getColumnIndex(key);
+  if (column !== -1) return store.get(row, column);
+
+  if (key === 'dwID' && store._hasIdAlias()) {
+    return store.get(row, store.getColumnIndex('//dwID'));
+  }
+  return undefined;
+};
+
+const rowKeys = (store: ColumnStore, row: number): string[] => {
+  const keys: string[] = [];
+  const extra = store._overflow(row, false);
+
+  store._keys().forEach(key => {
+    if (readKey(store, row, key) !== undefined || (extra && key in extra)) keys.push(key);
+  });
+
+  if (extra) {
+    Object.keys(extra).forEach(key => {
+      if (store.getColumnIndex(key) === -1 && !(key === 'dwID' && store._hasIdAlias())) keys.push(key);
+    });
+  }
+  return keys;
+};
+
+const rowViewHandler: ProxyHandler<RowTarget> = {
+  get(target, key) {
+    if (key === columnViewMarker) return true;
+    if (key === rowTargetKey) return target;
+    if (typeof key !== 'string') return undefined;
+    if (key === 'toJSON') return undefined;
+    return readKey(target.store, target.row, key);
+  },
+
+  set(target, key, value) {
+    if (typeof key !== 'string') return false;
+    const { store, row } = target;
+    const column = store.getColumnIndex(key);
+
+    // Header-Spalten mit Stringwerten landen in der Spalte, alles andere in den Zusatzfeldern
+    if (column !== -1 && (typeof value === 'string' || value === undefined)) {
+      const extra = store._overflow(row, false);
+      if (extra) delete extra[key];
+      store.set(row, column, value);
+    } else {
+      store._overflow(row, true)![key] = value;
+    }
+    return true;
+  },
+
+  has(target, key) {
+    if (typeof key !== 'string') return false;
+    return readKey(target.store, target.row, key) !== undefined ||
+      !!target.store._overflow(target.row, false)?.hasOwnProperty(key);
+  },
+
+  deleteProperty(target, key) {
+    if (typeof key !== 'string') return true;
+    const { store, row } = target;
+    const extra = store._overflow(row, false);
+    if (extra) delete extra[key];
+
+    const column = store.getColumnIndex(key);
+    if (column !== -1) store.set(row, column, undefined);
+    return true;
+  },
+
+  ownKeys(target) {
+    return rowKeys(target.store, target.row);
+  },
+
+  getOwnPropertyDescriptor(target, key) {
+    if (typeof key !== 'string') return undefined;
+    const value = readKey(target.store, target.row, key);
+    const extra = target.store._overflow(target.row, false);
+    if (value === undefined && !(extra && key in extra)) return undefined;
+    return { value, writable: true, enumerable: true, configurable: true };
+  },
+
+  defineProperty(target, key, descriptor) {
+    if (typeof key !== 'string') return false;
+    return rowViewHandler.set!(target, key, descriptor.value, target);
+  }
+};
+
+/**
+ * Prüft, ob ein ItemData-Objekt eine Sicht auf einen ColumnStore ist
+ */
+export const isColumnRowView = (data: any): boolean => {
+  return !!data && typeof data === 'object' && data[columnViewMarker] === true;
+};
+
+/**
+ * Speicher und Zeile hinter einer Zeilensicht (null bei normalen Objekten)
+ */
+export const getRowViewTarget = (data: any): { store: ColumnStore; row: number } | null => {
+  return isColumnRowView(data) ? data[rowTargetKey] : null;
+};
+
+/**
+ * Schema der Datei hinter einer Zeilensicht (null bei normalen Objekten)
+ */
+export const getRowViewSchema = (data: any): SpecItemSchema | null => {
+  return getRowViewTarget(data)?.store.schema ?? null;
+};
+
+/**
+ * Klont Items für den State. Zeilensichten zeigen danach auf eine Copy-on-Write-Kopie
+ * ihres Speichers (ColumnStore.fork, einmal je Speicher), normale Datenobjekte werden
+ * wie bisher tief kopiert. Änderungen am Klon wirken sich nicht auf die Quelle aus und umgekehrt.
+ */
+export const cloneResourceItems = <T extends { data: any; effects?: any }>(items: T[]): T[] => {
+  const forks = new Map<ColumnStore, ColumnStore>();
+  return items.map(item => {
+    const target = getRowViewTarget(item.data);
+    if (!target) return JSON.parse(JSON.stringify(item));
+
+    let store = forks.get(target.store);
+    if (!store) {
+      store = target.store.fork();
+      forks.set(target.store, store);
+    }
+    const { data, ...rest } = item;
+    return { ...JSON.parse(JSON.stringify(rest)), data: store.rowView(target.row) };
+  });
+};
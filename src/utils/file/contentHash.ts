@@ -0,0 +1,45 @@
+/**
+ * Inhalts-Hashes für Ressourcendateien
+ * Der Hash wird über die UTF-8-Bytes des Inhalts gebildet, damit Renderer und
+ * Hauptprozess (crypto.createHash) für denselben Text denselben Wert erhalten.
+ */
+
+const textEncoder = new TextEncoder();
+
+const toHex = (buffer: ArrayBuffer): string => {
+  const bytes = new Uint8Array(buffer);
+  let hex = '';
+  for (let i = 0; i < bytes.length; i++) {
+    hex += bytes[i].toString(16).padStart(2, '0');
+  }
+  return hex;
+};
+
+/**
+ * Einfacher FNV-1a Hash als Fallback, falls SubtleCrypto nicht verfügbar ist
+ */
+const fnv1aHex = (bytes: Uint8Array): string => {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < bytes.length; i++) {
+    hash ^= bytes[i];
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return `fnv-${(hash >>> 0).toString(16).padStart(8, '0')}`;
+};
+
+/**
+ * Berechnet den SHA-1-Hash des vollständigen Inhalts als Hex-String
+ * @param content Textinhalt oder Rohdaten der Datei
+ * @returns Hex-kodierter Hash
+ */
+export const computeContentHash = async (content: string | Uint8Array): Promise<string> => {
+  const bytes = typeof content === 'string' ? textEncoder.encode(content) : content;
+
+  try {
+    const hashBuffer = await crypto.subtle.digest('SHA-1', bytes);
+    return toHex(hashBuffer);
+  } catch (error) {
+    console.warn("SHA-1 über SubtleCrypto nicht verfügbar, verwende FNV-1a:", error);
+    return fnv1aHex(bytes);
+  }
+};
@@ -0,0 +1,195 @@
+/**
+ * Bidirektionaler Index für Define-Header
+ * Hält Name -> ID und ID -> Namen gleichzeitig aktuell, damit ID-Kollisionen
+ * beim Bearbeiten in O(1) erkannt werden und ein Kollisionsbericht in einem
+ * einzigen linearen Durchlauf entsteht.
+ */
+
+export interface DefineCollision {
+  id: number;
+  names: string[];
+}
+
+export interface DuplicateDefine {
+  name: string;
+  values: number[];
+}
+
+export interface DefineCollisionReport {
+  totalDefines: number;
+  uniqueNames: number;
+  sharedIds: DefineCollision[];
+  duplicateNames: DuplicateDefine[];
+  maxId: number;
+  maxIdName: string;
+  declaredLastId: number | null;
+  lastIdOutdated: boolean;
+}
+
+export class DefineIndex {
+  private readonly nameToId = new Map<string, number>();
+  // Jede Define-Zeile belegt ihre ID, auch wenn der Name später erneut definiert wird
+  private readonly idToNames = new Map<number, string[]>();
+  private readonly redefinitions = new Map<string, number[]>();
+  private defineCount = 0;
+  declaredLastId: number | null = null;
+
+  /**
+   * Registriert eine Define-Zeile (wird während des Parse-Durchlaufs aufgerufen)
+   */
+  add(name: string, id: number): void {
+    const previousId = this.nameToId.get(name);
+    if (previousId !== undefined) {
+      const values = this.redefinitions.get(name);
+      if (values) {
+        values.push(id);
+      } else {
+        this.redefinitions.set(name, [previousId, id]);
+      }
+    }
+
+    this.nameToId.set(name, id);
+    this.addIdName(id, name);
+    this.defineCount++;
+  }
+
+  /**
+   * Entfernt eine Define-Zeile wieder (Gegenstück zu add, z.B. wenn die Zeile extern gelöscht wurde).
+   * Bei mehrfach definierten Namen gilt danach wieder die zuletzt registrierte verbleibende Zeile.
+   */
+  remove(name: string, id: number): void {
+    const values = this.redefinitions.get(name);
+    if (values) {
+      const index = values.lastIndexOf(id);
+      if (index === -1) return;
+      values.splice(index, 1);
+      if (values.length === 1) this.redefinitions.delete(name);
+      this.nameToId.set(name, values[values.length - 1]);
+    } else {
+      if (this.nameToId.get(name) !== id) return;
+      this.nameToId.delete(name);
+    }
+
+    this.removeIdName(id, name);
+    this.defineCount--;
+  }
+
+  getId(name: string): number | undefined {
+    return this.nameToId.get(name);
+  }
+
+  getNames(id: number): string[] {
+    return this.idToNames.get(id) || [];
+  }
+
+  has(name: string): boolean {
+    return this.nameToId.has(name);
+  }
+
+  get size(): number {
+    return this.nameToId.size;
+  }
+
+  /**
+   * Alle IDs, die von mindestens einer Define-Zeile belegt sind
+   */
+  getUsedIds(): number[] {
+    return Array.from(this.idToNames.keys());
+  }
+
+  /**
+   * Prüft, ob eine ID bereits von einem anderen Define belegt ist
+   * @param id Zu prüfende ID
+   * @param exceptName Define, das die ID behalten darf (z.B. beim Umbenennen auf sich selbst)
+   */
+  isIdTaken(id: number, exceptName?: string): boolean {
+    const names = this.idToNames.get(id);
+    if (!names) return false;
+    return names.some(name => name !== exceptName);
+  }
+
+  /**
+   * Weist einem Define eine neue ID zu und aktualisiert beide Richtungen.
+   * Wie beim Umschreiben des Headers erhalten alle Zeilen dieses Namens die neue ID.
+   */
+  setId(name: string, newId: number): void {
+    const oldId = this.nameToId.get(name);
+    if (oldId === undefined) {
+      this.add(name, newId);
+      return;
+    }
+
+    const lineIds = this.redefinitions.get(name) || [oldId];
+    lineIds.forEach(id => this.removeIdName(id, name));
+    lineIds.forEach(() => this.addIdName(newId, name));
+
+    if (this.redefinitions.has(name)) {
+      this.redefinitions.set(name, lineIds.map(() => newId));
+    }
+    this.nameToId.set(name, newId);
+  }
+
+  /**
+   * Erstellt den Kollisionsbericht über den gesamten Header (ein Durchlauf über den Index)
+   */
+  buildCollisionReport(): DefineCollisionReport {
+    const sharedIds: DefineCollision[] = [];
+    let maxId = -1;
+    let maxIdName = '';
+
+    this.idToNames.forEach((names, id) => {
+      // Ein mehrfach definierter Name mit gleicher ID ist keine Kollision, sondern ein Duplikat
+      if (names.length > 1 && names.some(name => name !== names[0])) {
+        sharedIds.push({ id, names: [...new Set(names)] });
+      }
+      if (id > maxId) {
+        maxId = id;
+        maxIdName = names[names.length - 1];
+      }
+    });
+
+    sharedIds.sort((a, b) => a.id - b.id);
+
+    const duplicateNames: DuplicateDefine[] = [];
+    this.redefinitions.forEach((values, name) => {
+      duplicateNames.push({ name, values: [...values] });
+    });
+
+    return {
+      totalDefines: this.defineCount,
+      uniqueNames: this.nameToId.size,
+      sharedIds,
+      duplicateNames,
+      maxId,
+      maxIdName,
+      declaredLastId: this.declaredLastId,
+      lastIdOutdated: this.declaredLastId !== null && maxId > this.declaredLastId
+    };
+  }
+
+  private addIdName(id: number, name: string): void {
+    const names = this.idToNames.get(id);
+    if (names) {
+      names.push(name);
+    } else {
+      this.idToNames.set(id, [name]);
+    }
+  }
+
+  private removeIdName(id: number, name: string): void {
+    const names = this.idToNames.get(id);
+    if (!names) return;
+
+    const index = names.indexOf(name);
+    if (index !== -1) names.splice(index, 1);
+    if (names.length === 0) this.idToNames.delete(id);
+  }
+}
+
+/**
+ * Liest den "LAST ID = ..." Kommentar aus dem Kopf eines Define-Headers
+ */
+export const parseDeclaredLastId = (content: string): number | null => {
+  const match = /LAST ID\s*=\s*(\d+)/.exec(content);
+  return match ? parseInt(match[1], 10) : null;
+};
@@ -1,5 +1,17 @@
 import { toast } from "sonner";
-import { trackModifiedFile } from "./fileOperations";
+import { type FieldChange, getPendingChanges, onJournalDiscard, recordChange } from "./changeJournal";
+import { type DefineSymbol, DefineSymbolTable, loadOrCompileSymbolTable } from "./defineSymbolTable";
+import { DefineIndex, type DefineCollisionReport, parseDeclaredLastId } from "./defineIndex";
+import { LineDocument } from "./lineDocument";
+import { DEFINE_PREFIXES, getLexedDefineHeader, lexDefineHeader, toDefineSymbols } from "./defineLexer";
+import { IdAllocator, type IdRange, collectUsedIds } from "./idAllocator";
+import { detectLineEnding } from "./roundTrip";
+import { loadResourceFile } from "./resourceStream";
+import { type LineHunk } from "./filePatch";
+import { traceAsync, traceBegin, traceEnd, traceSync } from "../trace";
+
+// Version des defineItem.h-Parsers - bei Änderungen am Parser erhöhen, damit alte .symtab-Dateien verworfen werden
+const DEFINE_ITEM_PARSER_VERSION = "defineItem-3";
 
 // Interface for storing item define mappings
 interface ItemDefineMapping {
@@ -8,46 +20,164 @@ interface ItemDefineMapping {
 
 // Global cache for item define mappings
 let itemDefineMappings: ItemDefineMapping = {};
+// Bidirectional index (name -> id, id -> names) for collision checks
+let itemDefineIndex = new DefineIndex();
+// Free-ID allocator over all used item IDs (created on first use)
+let itemIdAllocator: IdAllocator | null = null;
+// IDs of all defines in defineObj.h; new items never get one of them (loaded with the allocator)
+let defineObjUsedIds: number[] | null = null;
 // Store the original file content so we can modify it correctly
 let originalDefineItemContent = "";
+// Position of a define's value token in the LineDocument (columns [start, end) of the line)
+interface DefineValueSpan {
+  line: number;
+  start: number;
+  end: number;
+}
+
+// Editable document over the original content and the value token of each define (created on first edit)
+let defineItemDocument: LineDocument | null = null;
+let defineItemLines: Map<string, DefineValueSpan[]> | null = null;
+
+// Extract all II_ defines from defineItem.h content
+export const extractItemDefines = (content: string): DefineSymbol[] => {
+  const header = getLexedDefineHeader(content);
+
+  if (header.commentedOut > 0) {
+    console.log(`defineItem.h: ${header.commentedOut} defines inside block comments were skipped`);
+  }
+  if (header.openConditionals > 0) {
+    console.warn(`defineItem.h: ${header.openConditionals} #if/#ifndef blocks are not closed`);
+  }
+
+  return toDefineSymbols(header.tables.II);
+};
+
+// Fill the global cache and the id index from a compiled symbol table
+const applyItemDefineTable = (table: DefineSymbolTable, content: string): void => {
+  const mappings: ItemDefineMapping = {};
+  const index = new DefineIndex();
+  index.declaredLastId = parseDeclaredLastId(content);
+
+  for (let i = 0; i < table.count; i++) {
+    const name = table.nameAt(i);
+    const value = table.valueAt(i);
+    mappings[name] = String(value);
+    index.add(name, value);
+  }
+
+  itemDefineMappings = mappings;
+  itemDefineIndex = index;
+  // Open reservations survive the reload
+  itemIdAllocator?.reset(getAllocatorSeed());
+  console.log(`Successfully loaded ${table.count} item definitions from defineItem.h`);
+  logItemDefineCollisions(index.buildCollisionReport());
+  toast.success(`Loaded ${table.count} item definitions from defineItem.h`);
+};
+
+// Log duplicate names, shared IDs and an outdated LAST ID banner
+const logItemDefineCollisions = (report: DefineCollisionReport): void => {
+  if (report.sharedIds.length > 0) {
+    console.warn(`defineItem.h: ${report.sharedIds.length} IDs are used by more than one define`, report.sharedIds.slice(0, 10));
+  }
+  if (report.duplicateNames.length > 0) {
+    console.warn(`defineItem.h: ${report.duplicateNames.length} defines are defined more than once`, report.duplicateNames.slice(0, 10));
+  }
+  if (report.lastIdOutdated) {
+    console.warn(`defineItem.h: LAST ID banner says ${report.declaredLastId}, but ${report.maxIdName} uses ${report.maxId}`);
+  }
+};
 
 // Parse defineItem.h file content
 export const parseDefineItemFile = (content: string): void => {
   // Store the original content
   originalDefineItemContent = content;
+  defineItemDocument = null;
+  defineItemLines = null;
   try {
     console.log("Parsing defineItem.h file...");
     
-    const defineRegex = /\#define\s+(II_[A-Z0-9_]+)\s+(\d+)/g;
-    const mappings: ItemDefineMapping = {};
-    
-    let match;
-    let count = 0;
-    
-    while ((match = defineRegex.exec(content)) !== null) {
-      const defineName = match[1];
-      const defineValue = match[2];
-      
-      mappings[defineName] = defineValue;
-      count++;
-      
-      if (count <= 5) {
-        console.log(`Parsed define: ${defineName} = ${defineValue}`);
-      }
-    }
-    
-    console.log(`Successfully parsed ${count} item definitions from defineItem.h`);
-    
-    // Store in global cache
-    itemDefineMappings = mappings;
-    
-    toast.success(`Loaded ${count} item definitions from defineItem.h`);
+    applyItemDefineTable(DefineSymbolTable.fromSymbols(extractItemDefines(content)), content);
   } catch (error) {
     console.error("Error parsing defineItem.h:", error);
     toast.error("Failed to parse defineItem.h file");
   }
 };
 
+// Load defineItem.h content via its compiled symbol table (only reparses if the header changed)
+export const loadDefineItemContent = async (content: string): Promise<void> => {
+  originalDefineItemContent = content;
+  defineItemDocument = null;
+  defineItemLines = null;
+  try {
+    const table = await traceAsync("defineItem.h", "parse", () =>
+      loadOrCompileSymbolTable("defineItem.h", content, DEFINE_ITEM_PARSER_VERSION, extractItemDefines)
+    );
+    traceSync("defineItem.h", "index", () => applyItemDefineTable(table, content));
+  } catch (error) {
+    console.error("Error loading symbol table for defineItem.h, falling back to parser:", error);
+    parseDefineItemFile(content);
+  }
+};
+
+// A define whose ID changed through an external edit (id null = removed)
+export interface ItemDefineChange {
+  name: string;
+  id: string | null;
+}
+
+// Block comments and #if blocks affect lines outside the changed range
+const CONTEXT_DEPENDENT = /\/\*|\*\/|^[ \t]*#[ \t]*(if|ifdef|ifndef|elif|else|endif)\b/m;
+
+// Apply externally changed line ranges of defineItem.h without reparsing the whole header
+// @param baseTexts Previous text of each hunk (same order as hunks)
+// @returns The changed defines, or null if the header has to be parsed again completely
+export const applyDefineItemDelta = (content: string, hunks: LineHunk[], baseTexts: string[]): ItemDefineChange[] | null => {
+  if (!originalDefineItemContent || defineItemDocument?.isModified() || getCreatedDefines().length > 0) return null;
+  if (originalDefineItemContent.includes("/*")) return null;
+  if (hunks.some((hunk, i) => CONTEXT_DEPENDENT.test(hunk.text) || CONTEXT_DEPENDENT.test(baseTexts[i]))) return null;
+
+  const removed = baseTexts.map(text => lexDefineHeader(text));
+  const added = hunks.map(hunk => lexDefineHeader(hunk.text));
+
+  // References like "#define II_A II_B" can only be resolved with the whole header
+  const hasReference = (header: ReturnType<typeof lexDefineHeader>) =>
+    header.unresolved.some(entry => entry.name.startsWith("II_"));
+  if (removed.some(hasReference) || added.some(hasReference)) return null;
+
+  const touched = new Set<string>();
+  removed.forEach(header => header.tables.II.forEach(entry => {
+    itemDefineIndex.remove(entry.name, entry.value);
+    touched.add(entry.name);
+  }));
+  added.forEach(header => header.tables.II.forEach(entry => {
+    itemDefineIndex.add(entry.name, entry.value);
+    touched.add(entry.name);
+  }));
+  itemDefineIndex.declaredLastId = parseDeclaredLastId(content);
+
+  const changes: ItemDefineChange[] = [];
+  touched.forEach(name => {
+    const id = itemDefineIndex.getId(name);
+    const previousId = itemDefineMappings[name];
+    if (id === undefined) {
+      delete itemDefineMappings[name];
+      if (previousId !== undefined) changes.push({ name, id: null });
+    } else if (String(id) !== previousId) {
+      itemDefineMappings[name] = String(id);
+      changes.push({ name, id: String(id) });
+    }
+  });
+
+  itemIdAllocator?.reset(getAllocatorSeed());
+  originalDefineItemContent = content;
+  defineItemDocument = null;
+  defineItemLines = null;
+
+  console.log(`defineItem.h: ${hunks.length} changed ranges applied, ${changes.length} defines changed`);
+  return changes;
+};
+
 // Get item ID from define name
 export const getItemIdFromDefine = (defineName: string): string => {
   if (!defineName) return '';
@@ -72,46 +202,275 @@ export const getItemDefineMappings = (): ItemDefineMapping => {
   return itemDefineMappings;
 };
 
-// Update an item ID in the defineItem.h file
-export const updateItemIdInDefine = (defineName: string, newId: string): boolean => {
-  if (!defineName || !newId || !originalDefineItemContent) {
+// Get all define names that use the given item ID
+export const getItemDefinesById = (itemId: string | number): string[] => {
+  return itemDefineIndex.getNames(Number(itemId));
+};
+
+// Check whether an item ID is already used by another define
+export const isItemIdTaken = (itemId: string | number, exceptDefineName?: string): boolean => {
+  return itemDefineIndex.isIdTaken(Number(itemId), exceptDefineName);
+};
+
+// Used IDs the allocator starts from: all II_ IDs of defineItem.h plus all IDs of defineObj.h
+const getAllocatorSeed = (): number[] =>
+  itemDefineIndex.getUsedIds().concat(defineObjUsedIds || []);
+
+// Read the IDs of defineObj.h once (Electron stream, otherwise from the public folder)
+const loadDefineObjUsedIds = async (): Promise<number[]> => {
+  if (defineObjUsedIds) return defineObjUsedIds;
+
+  let content: string | null = null;
+  try {
+    if ((window as any).electronAPI) {
+      content = await loadResourceFile("defineObj.h");
+    }
+    if (!content) {
+      const response = await fetch('/resource/defineObj.h');
+      if (response.ok) content = await response.text();
+    }
+  } catch (error) {
+    console.warn("defineObj.h could not be loaded, new item IDs are only checked against defineItem.h:", error);
+  }
+
+  defineObjUsedIds = content ? collectUsedIds([content], [...DEFINE_PREFIXES]) : [];
+  return defineObjUsedIds;
+};
+
+// Get the allocator for free item IDs (reservations via (await getItemIdAllocator()).begin())
+export const getItemIdAllocator = async (): Promise<IdAllocator> => {
+  if (!itemIdAllocator) {
+    await loadDefineObjUsedIds();
+    // Another caller may have created it while defineObj.h was loading
+    if (!itemIdAllocator) itemIdAllocator = new IdAllocator(getAllocatorSeed());
+  }
+  return itemIdAllocator;
+};
+
+// Create new item defines with free IDs; all IDs are reserved in one transaction and
+// released again if any define cannot be created
+// @param block Optional ID range the new IDs have to come from
+// @returns The created defines with their IDs, or null if nothing was created
+export const createItemDefines = async (
+  defineNames: string[],
+  block?: IdRange
+): Promise<{ defineName: string; id: string }[] | null> => {
+  if (!originalDefineItemContent) {
+    console.error("defineItem.h is not loaded, cannot create defines");
+    return null;
+  }
+
+  const names = defineNames.map(name => name.replace(/^"+|"+$/g, '').trim());
+  const invalid = names.find((name, i) =>
+    !/^II_[A-Za-z0-9_]+$/.test(name) || name in itemDefineMappings || names.indexOf(name) !== i
+  );
+  if (invalid !== undefined) {
+    console.error(`Cannot create define ${invalid}: invalid name or already defined`);
+    toast.error(`Define ${invalid} is invalid or already exists`);
+    return null;
+  }
+  if (names.length === 0) return null;
+
+  const allocator = await getItemIdAllocator();
+  const transaction = allocator.begin();
+  try {
+    const ids = transaction.reserve(names.length, block);
+    if (!ids) {
+      transaction.rollback();
+      toast.error(`Not enough free item IDs for ${names.length} new defines`);
+      return null;
+    }
+
+    const created = names.map((defineName, i) => ({ defineName, id: String(ids[i]) }));
+    created.forEach(({ defineName, id }) => {
+      itemDefineMappings[defineName] = id;
+      itemDefineIndex.add(defineName, Number(id));
+      recordChange("defineItem.h", defineName, "id", "", id);
+    });
+    transaction.commit();
+
+    console.log(`defineItem.h: ${created.length} defines created (${created.map(entry => entry.id).join(", ")})`);
+    toast.success(`Created ${created.map(entry => `${entry.defineName} = ${entry.id}`).join(", ")}`);
+    return created;
+  } catch (error) {
+    console.error("Error creating item defines:", error);
+    transaction.rollback();
+    return null;
+  }
+};
+
+// Defines created since the last save: pending journal entries without a value in the file
+const getCreatedDefines = (): FieldChange[] =>
+  getPendingChanges("defineItem.h").filter(change => change.column === "id" && change.oldValue === "");
+
+// Insert the created defines in front of the closing #endif (or at the end)
+const insertCreatedDefines = (content: string, created: FieldChange[]): string => {
+  const eol = detectLineEnding(content);
+  const block = created.map(({ rowKey, newValue }) => `#define\t${rowKey}\t${newValue}${eol}`).join("");
+
+  let insertAt = -1;
+  const endif = /^[ \t]*#[ \t]*endif\b/gm;
+  for (let match = endif.exec(content); match; match = endif.exec(content)) insertAt = match.index;
+
+  if (insertAt === -1) {
+    const separator = content.length > 0 && !content.endsWith("\n") ? eol : "";
+    return content + separator + block;
+  }
+  return content.substring(0, insertAt) + block + content.substring(insertAt);
+};
+
+// Build the duplicate/collision report for the loaded defineItem.h
+export const getItemDefineCollisionReport = (): DefineCollisionReport => {
+  return itemDefineIndex.buildCollisionReport();
+};
+
+// Create the editable document and the define -> line index on first use
+const getDefineItemDocument = (): LineDocument => {
+  if (!defineItemDocument || !defineItemLines) {
+    const lineDocument = new LineDocument(originalDefineItemContent);
+    const lines = new Map<string, DefineValueSpan[]>();
+
+    // Reuses the tokens of the load if the symbol table had to be compiled
+    getLexedDefineHeader(originalDefineItemContent).tables.II.forEach(entry => {
+      const span = { line: entry.valueLine, start: entry.valueStart, end: entry.valueEnd };
+      const existing = lines.get(entry.name);
+      if (existing) {
+        existing.push(span);
+      } else {
+        lines.set(entry.name, [span]);
+      }
+    });
+
+    defineItemDocument = lineDocument;
+    defineItemLines = lines;
+  }
+  return defineItemDocument;
+};
+
+// Format a new ID like the value it replaces (hex values stay hex with the same case and width)
+const formatDefineValue = (oldToken: string, newId: string): string => {
+  const hex = /^0([xX])([0-9A-Fa-f]+)$/.exec(oldToken);
+  if (!hex) return newId;
+
+  let digits = Number(newId).toString(16).padStart(hex[2].length, "0");
+  if (/[A-F]/.test(hex[2]) || (hex[1] === "X" && !/[a-f]/.test(hex[2]))) digits = digits.toUpperCase();
+  return `0${hex[1]}${digits}`;
+};
+
+// Replace the lexed value token of a define; parentheses, comments and alignment stay untouched.
+// An alias value (e.g. "II_A II_B") becomes the literal ID.
+const replaceDefineValue = (line: string, span: DefineValueSpan, newId: string): string => {
+  const value = formatDefineValue(line.substring(span.start, span.end), newId);
+  return line.substring(0, span.start) + value + line.substring(span.end);
+};
+
+// Write a new ID into all lines of a define
+// @returns The number of changed lines
+const writeDefineValue = (lineDocument: LineDocument, spans: DefineValueSpan[], newId: string): number => {
+  let changed = 0;
+  spans.forEach(span => {
+    const text = lineDocument.getLine(span.line);
+    const updated = replaceDefineValue(text, span, newId);
+    if (updated !== text) {
+      lineDocument.setLine(span.line, updated);
+      // The token now ends after the new value; later edits of the same define use the new span
+      span.end += updated.length - text.length;
+      changed++;
+    }
+  });
+  return changed;
+};
+
+// Update several item IDs in the defineItem.h file at once
+export const updateItemIdsInDefine = (updates: { defineName: string; newId: string }[]): boolean => {
+  if (!updates || updates.length === 0 || !originalDefineItemContent) {
     console.error("Missing data for updating defineItem.h");
     return false;
   }
 
   try {
-    // Clean the input from any quotes
-    const cleanDefineName = defineName.replace(/^"+|"+$/g, '');
-    
-    // Check if this define exists in our mappings
-    if (!(cleanDefineName in itemDefineMappings)) {
-      console.error(`Define name ${cleanDefineName} not found in defineItem.h`);
-      return false;
+    const cleanUpdates = updates.map(update => ({
+      defineName: update.defineName.replace(/^"+|"+$/g, ''),
+      newId: String(update.newId)
+    }));
+    const renamedDefines = new Set(cleanUpdates.map(update => update.defineName));
+    const targetIds = new Map<string, string>();
+
+    // Validate the whole batch before touching the lineDocument
+    for (const { defineName, newId } of cleanUpdates) {
+      if (!(defineName in itemDefineMappings)) {
+        console.error(`Define name ${defineName} not found in defineItem.h`);
+        return false;
+      }
+      if (!/^\d+$/.test(newId)) {
+        console.error(`Invalid item ID ${newId} for ${defineName}`);
+        return false;
+      }
+      // IDs held by an open reservation (e.g. a running bulk create) are not available
+      if (itemIdAllocator?.isReserved(Number(newId))) {
+        console.error(`Item ID ${newId} is reserved`);
+        toast.error(`ID ${newId} is reserved for a define that is being created`);
+        return false;
+      }
+
+      // Defines that are renumbered in the same batch free their old IDs
+      const usedBy = itemDefineIndex.getNames(Number(newId)).filter(name => !renamedDefines.has(name));
+      const claimedBy = targetIds.get(newId);
+      if (usedBy.length > 0 || (claimedBy && claimedBy !== defineName)) {
+        const owner = usedBy[0] || claimedBy;
+        console.error(`Item ID ${newId} is already used by ${owner}`);
+        toast.error(`ID ${newId} is already used by ${owner}`);
+        return false;
+      }
+      targetIds.set(newId, defineName);
+    }
+
+    const lineDocument = getDefineItemDocument();
+    let changedLines = 0;
+
+    for (const { defineName, newId } of cleanUpdates) {
+      const spans = defineItemLines!.get(defineName) || [];
+      const oldId = itemDefineMappings[defineName];
+
+      console.log(`Updating item ID for ${defineName}: ${oldId} → ${newId}`);
+
+      let defineChanged = false;
+      // Created defines have no line yet, it is generated from the journal when saving
+      if (spans.length === 0 && oldId !== newId) {
+        changedLines++;
+        defineChanged = true;
+      }
+      const written = writeDefineValue(lineDocument, spans, newId);
+      if (written > 0) {
+        changedLines += written;
+        defineChanged = true;
+      }
+
+      // The change journal only holds the field; the lines are assembled from the LineDocument when saving
+      if (defineChanged) {
+        recordChange("defineItem.h", defineName, "id", String(oldId ?? ""), String(newId));
+      }
+
+      itemDefineMappings[defineName] = newId;
+      itemDefineIndex.setId(defineName, Number(newId));
+
+      // Keep the allocator in sync: the new ID is used, the old one is free if no other define uses it
+      if (itemIdAllocator) {
+        itemIdAllocator.markUsed(Number(newId));
+        if (oldId !== undefined && itemDefineIndex.getNames(Number(oldId)).length === 0) {
+          itemIdAllocator.release(Number(oldId));
+        }
+      }
     }
 
-    // Update the mapping in memory
-    const oldId = itemDefineMappings[cleanDefineName];
-    itemDefineMappings[cleanDefineName] = newId;
-    
-    console.log(`Updating item ID for ${cleanDefineName}: ${oldId} → ${newId}`);
-    
-    // Update the file content - we need to replace the exact define line
-    const defineRegex = new RegExp(`(#define\\s+${cleanDefineName}\\s+)\\d+`, 'g');
-    const updatedContent = originalDefineItemContent.replace(defineRegex, `$1${newId}`);
-    
     // Check if the content was actually changed
-    if (updatedContent === originalDefineItemContent) {
-      console.warn(`No changes were made to defineItem.h for ${cleanDefineName}`);
+    if (changedLines === 0) {
+      console.warn("No changes were made to defineItem.h");
       return false;
     }
-    
-    // Track the modified file to be saved
-    trackModifiedFile("defineItem.h", updatedContent);
-    console.log(`defineItem.h modified: ${cleanDefineName} ID updated to ${newId}`);
-    
-    // Update our original content to reflect the changes
-    originalDefineItemContent = updatedContent;
-    
+
+    console.log(`defineItem.h modified: ${cleanUpdates.length} IDs updated (${lineDocument.editCount} changed lines)`);
+
     return true;
   } catch (error) {
     console.error("Error updating defineItem.h:", error);
@@ -119,8 +478,60 @@ export const updateItemIdInDefine = (defineName: string, newId: string): boolean
   }
 };
 
+// Update an item ID in the defineItem.h file
+export const updateItemIdInDefine = (defineName: string, newId: string): boolean => {
+  if (!defineName || !newId) {
+    console.error("Missing data for updating defineItem.h");
+    return false;
+  }
+
+  return updateItemIdsInDefine([{ defineName, newId }]);
+};
+
+// Current content of defineItem.h including unsaved ID changes and created defines
+export const getDefineItemContent = (): string => {
+  const content = defineItemDocument ? defineItemDocument.toString() : originalDefineItemContent;
+  const created = getCreatedDefines();
+  return created.length > 0 ? insertCreatedDefines(content, created) : content;
+};
+
+// Take the saved content as the new state of defineItem.h; IDs changed while saving stay pending
+// and are written into the new document again
+export const rebaseDefineItemContent = (content: string): void => {
+  originalDefineItemContent = content;
+  defineItemDocument = null;
+  defineItemLines = null;
+
+  const pending = getPendingChanges("defineItem.h").filter(change => change.column === "id" && change.oldValue !== "");
+  if (pending.length === 0) return;
+  const lineDocument = getDefineItemDocument();
+  pending.forEach(({ rowKey, newValue }) => writeDefineValue(lineDocument, defineItemLines!.get(rowKey) || [], newValue));
+};
+
+// Discarded changes of defineItem.h: created defines disappear and release their IDs,
+// changed IDs get their value from the file again
+onJournalDiscard((fileName, discarded) => {
+  if (fileName.toLowerCase() !== "defineitem.h") return;
+
+  discarded.forEach(({ rowKey, column, oldValue, newValue }) => {
+    if (column !== "id") return;
+    if (oldValue === "") {
+      itemDefineIndex.remove(rowKey, Number(newValue));
+      delete itemDefineMappings[rowKey];
+    } else {
+      itemDefineIndex.setId(rowKey, Number(oldValue));
+      itemDefineMappings[rowKey] = oldValue;
+    }
+  });
+
+  defineItemDocument = null;
+  defineItemLines = null;
+  itemIdAllocator?.reset(getAllocatorSeed());
+});
+
 // Function to load defineItem.h from public folder
 export const loadDefineItemFile = async (): Promise<void> => {
+  const span = traceBegin("loadDefineItemFile", "load");
   try {
     console.log("Loading defineItem.h file from public folder...");
     
@@ -135,6 +546,7 @@ export const loadDefineItemFile = async (): Promise<void> => {
     
     let content = null;
     let loadedPath = null;
+    const fetchSpan = traceBegin("defineItem.h", "fetch");
     
     // Versuche alle Pfade nacheinander
     for (const path of paths) {
@@ -160,11 +572,11 @@ export const loadDefineItemFile = async (): Promise<void> => {
       if ((window as any).electronAPI) {
         try {
           console.log("Versuche Laden über Electron API");
-          const result = await (window as any).electronAPI.loadAllFiles();
+          const fileContent = await loadResourceFile("defineItem.h");
           
-          if (result.success && result.files && result.files["defineItem.h"]) {
+          if (fileContent) {
             console.log("defineItem.h über Electron API geladen");
-            content = result.files["defineItem.h"];
+            content = fileContent;
             loadedPath = "electron-api";
           }
         } catch (electronError) {
@@ -173,15 +585,19 @@ export const loadDefineItemFile = async (): Promise<void> => {
       }
     }
     
+    traceEnd(fetchSpan, { source: loadedPath });
+    
     if (!content) {
       throw new Error(`Konnte defineItem.h über keinen Pfad laden`);
     }
     
     console.log(`defineItem.h erfolgreich von ${loadedPath} geladen, Inhaltslänge:`, content.length);
     
-    parseDefineItemFile(content);
+    await loadDefineItemContent(content);
   } catch (error) {
     console.error("Error loading defineItem.h file:", error);
     toast.error("Fehler beim Laden der defineItem.h Datei");
+  } finally {
+    traceEnd(span);
   }
 };
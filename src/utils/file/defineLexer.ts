@@ -0,0 +1,330 @@
+/**
+ * Präprozessor-bewusster Lexer für Define-Header (defineItem.h, defineObj.h)
+ *
+ * Liest den Header in einem einzigen Durchlauf und sortiert jedes #define nach
+ * seinem Präfix (II_, MI_, CI_, XI_, RI_, OI_) in eigene Tabellen.
+ * Berücksichtigt werden:
+ *  - Einrückung und Ausrichtung mit Tabs und Leerzeichen
+ *  - Zeilenkommentare (//) und Blockkommentare, auch über mehrere Zeilen
+ *    (auskommentierte Defines werden übersprungen)
+ *  - dezimale und hexadezimale Werte sowie Verweise auf zuvor definierte Namen
+ *  - Include-Guards und #if/#endif-Schachtelung; ein "#endif" innerhalb eines
+ *    Kommentars (defineItem.h, "Shiny Gengar#endif") wird nicht als Direktive gewertet
+ *  - Zeilenfortsetzungen mit "\" am Zeilenende
+ *
+ * getLexedDefineHeader merkt sich die zuletzt gelesenen Header, damit Laden, Symboltabelle,
+ * Bearbeiten und ID-Vergabe denselben Durchlauf teilen.
+ */
+
+export const DEFINE_PREFIXES = ['II', 'MI', 'CI', 'XI', 'RI', 'OI'] as const;
+export type DefinePrefix = typeof DEFINE_PREFIXES[number];
+
+export interface DefineEntry {
+  name: string;
+  value: number;
+  // 0-basierte Zeilennummer im Header
+  line: number;
+  // Lage des Wert-Tokens (ohne Klammern): Zeile und Spalten [valueStart, valueEnd) in dieser Zeile
+  valueLine: number;
+  valueStart: number;
+  valueEnd: number;
+}
+
+export interface LexedDefineHeader {
+  tables: Record<DefinePrefix, DefineEntry[]>;
+  // Defines mit anderen Präfixen (z.B. __DEFINE_ITEM oder Hilfskonstanten)
+  other: DefineEntry[];
+  guards: string[];
+  // Defines ohne auswertbaren Wert (z.B. Include-Guards oder Makros)
+  unresolved: { name: string; value: string; line: number }[];
+  // Defines, die in Blockkommentaren stehen
+  commentedOut: number;
+  // Offene #if-Ebenen am Dateiende (0 bei korrekt geschlossenen Guards)
+  openConditionals: number;
+  lineCount: number;
+}
+
+const CHAR_TAB = 9;
+const CHAR_LF = 10;
+const CHAR_CR = 13;
+const CHAR_SPACE = 32;
+const CHAR_HASH = 35;
+const CHAR_LPAREN = 40;
+const CHAR_RPAREN = 41;
+const CHAR_STAR = 42;
+const CHAR_SLASH = 47;
+const CHAR_BACKSLASH = 92;
+
+const isBlank = (code: number): boolean => code === CHAR_SPACE || code === CHAR_TAB || code === CHAR_CR;
+
+const isIdentifierChar = (code: number): boolean =>
+  (code >= 48 && code <= 57) || // 0-9
+  (code >= 65 && code <= 90) || // A-Z
+  (code >= 97 && code <= 122) || // a-z
+  code === 95; // _
+
+const prefixTable = new Map<string, DefinePrefix>(DEFINE_PREFIXES.map(prefix => [prefix, prefix]));
+
+/**
+ * Zerlegt einen Define-Header in typisierte Tabellen
+ * @param content Inhalt des Headers
+ * @returns Tabellen je Präfix mit Name, Wert und Zeilennummer
+ */
+export const lexDefineHeader = (content: string): LexedDefineHeader => {
+  const tables = {} as Record<DefinePrefix, DefineEntry[]>;
+  DEFINE_PREFIXES.forEach(prefix => { tables[prefix] = []; });
+
+  const result: LexedDefineHeader = {
+    tables,
+    other: [],
+    guards: [],
+    unresolved: [],
+    commentedOut: 0,
+    openConditionals: 0,
+    lineCount: 0
+  };
+
+  // Bereits gelesene Werte, um Verweise wie "#define II_A II_B" aufzulösen
+  const knownValues = new Map<string, number>();
+  const length = content.length;
+  let pos = 0;
+  let line = 0;
+  let lineStart = 0;
+  let atLineStart = true;
+  let depth = 0;
+
+  // Länge einer Zeilenfortsetzung ("\" + Zeilenumbruch) ab at, sonst 0
+  const continuationLength = (at: number): number => {
+    if (content.charCodeAt(at) !== CHAR_BACKSLASH) return 0;
+    if (content.charCodeAt(at + 1) === CHAR_LF) return 2;
+    if (content.charCodeAt(at + 1) === CHAR_CR && content.charCodeAt(at + 2) === CHAR_LF) return 3;
+    return 0;
+  };
+
+  // Überspringt Leerraum innerhalb einer Direktive, einschließlich Zeilenfortsetzungen
+  const skipBlanks = () => {
+    while (pos < length) {
+      if (isBlank(content.charCodeAt(pos))) {
+        pos++;
+        continue;
+      }
+      const continuation = continuationLength(pos);
+      if (continuation === 0) break;
+      pos += continuation;
+      line++;
+      lineStart = pos;
+    }
+  };
+
+  const readIdentifier = (): string => {
+    const start = pos;
+    while (pos < length && isIdentifierChar(content.charCodeAt(pos))) pos++;
+    return content.substring(start, pos);
+  };
+
+  const skipBlockComment = () => {
+    const end = content.indexOf('*/', pos);
+    const stop = end === -1 ? length : end;
+
+    // Auskommentierte Defines zählen und Zeilennummern weiterführen
+    for (let i = content.indexOf('\n', pos); i !== -1 && i < stop; i = content.indexOf('\n', i + 1)) {
+      line++;
+      lineStart = i + 1;
+    }
+    for (let i = content.indexOf('#define', pos); i !== -1 && i < stop; i = content.indexOf('#define', i + 7)) {
+      result.commentedOut++;
+    }
+
+    pos = end === -1 ? length : end + 2;
+  };
+
+  const parseValue = (token: string): number | undefined => {
+    if (token.length === 0) return undefined;
+
+    const first = token.charCodeAt(0);
+    if (first === 48 && (token[1] === 'x' || token[1] === 'X')) {
+      const hex = parseInt(token.substring(2), 16);
+      return isNaN(hex) ? undefined : hex;
+    }
+    if ((first >= 48 && first <= 57) || first === 45) {
+      const decimal = Number(token);
+      return Number.isInteger(decimal) ? decimal : undefined;
+    }
+    return knownValues.get(token);
+  };
+
+  const readDefine = () => {
+    skipBlanks();
+    const nameLine = line;
+    const name = readIdentifier();
+    if (!name) return;
+
+    skipBlanks();
+
+    // Wert bis zum nächsten Leerzeichen oder Kommentar, Klammern um den Wert werden entfernt
+    let valueStart = pos;
+    let valueEnd = pos;
+    if (pos < length && content.charCodeAt(pos) === CHAR_LPAREN) {
+      const close = content.indexOf(')', pos);
+      const lineEnd = content.indexOf('\n', pos);
+      if (close !== -1 && (lineEnd === -1 || close < lineEnd)) {
+        valueStart = pos + 1;
+        valueEnd = close;
+        pos = close + 1;
+      }
+    } else {
+      while (pos < length) {
+        const code = content.charCodeAt(pos);
+        if (isBlank(code) || code === CHAR_LF) break;
+        if (code === CHAR_SLASH && (content.charCodeAt(pos + 1) === CHAR_SLASH || content.charCodeAt(pos + 1) === CHAR_STAR)) break;
+        if (code === CHAR_RPAREN || continuationLength(pos) > 0) break;
+        pos++;
+      }
+      valueEnd = pos;
+    }
+
+    const rawToken = content.substring(valueStart, valueEnd);
+    const token = rawToken.trim();
+    const value = parseValue(token);
+
+    if (value === undefined) {
+      result.unresolved.push({ name, value: token, line: nameLine });
+      return;
+    }
+
+    knownValues.set(name, value);
+    const tokenStart = valueStart - lineStart + (rawToken.length - rawToken.trimStart().length);
+    const entry: DefineEntry = {
+      name,
+      value,
+      line: nameLine,
+      valueLine: line,
+      valueStart: tokenStart,
+      valueEnd: tokenStart + token.length
+    };
+    const separator = name.indexOf('_');
+    const prefix = separator > 0 ? prefixTable.get(name.substring(0, separator)) : undefined;
+
+    if (prefix) {
+      tables[prefix].push(entry);
+    } else {
+      result.other.push(entry);
+    }
+  };
+
+  const readDirective = () => {
+    pos++; // '#'
+    skipBlanks();
+    const directive = readIdentifier();
+
+    switch (directive) {
+      case 'define':
+        readDefine();
+        break;
+      case 'ifndef':
+      case 'ifdef':
+      case 'if':
+        if (directive === 'ifndef' && depth === 0) {
+          skipBlanks();
+          const guard = readIdentifier();
+          if (guard) result.guards.push(guard);
+        }
+        depth++;
+        break;
+      case 'endif':
+        if (depth > 0) depth--;
+        break;
+      default:
+        // #else, #elif, #pragma, #include ... ändern die Tabellen nicht
+        break;
+    }
+  };
+
+  while (pos < length) {
+    const code = content.charCodeAt(pos);
+
+    if (code === CHAR_LF) {
+      line++;
+      pos++;
+      lineStart = pos;
+      atLineStart = true;
+      continue;
+    }
+
+    // Fortgesetzte Zeile: die nächste Zeile gehört noch zur aktuellen (kein Zeilenanfang)
+    const continuation = continuationLength(pos);
+    if (continuation > 0) {
+      pos += continuation;
+      line++;
+      lineStart = pos;
+      continue;
+    }
+
+    if (isBlank(code)) {
+      pos++;
+      continue;
+    }
+
+    if (code === CHAR_SLASH) {
+      const next = content.charCodeAt(pos + 1);
+      if (next === CHAR_SLASH) {
+        const lineEnd = content.indexOf('\n', pos);
+        pos = lineEnd === -1 ? length : lineEnd;
+        continue;
+      }
+      if (next === CHAR_STAR) {
+        pos += 2;
+        skipBlockComment();
+        continue;
+      }
+    }
+
+    if (code === CHAR_HASH && atLineStart) {
+      atLineStart = false;
+      readDirective();
+      continue;
+    }
+
+    // Sonstiger Text: bis zum nächsten Trennzeichen überspringen
+    atLineStart = false;
+    pos++;
+    while (pos < length) {
+      const c = content.charCodeAt(pos);
+      if (isBlank(c) || c === CHAR_LF || c === CHAR_SLASH || c === CHAR_BACKSLASH) break;
+      pos++;
+    }
+  }
+
+  result.openConditionals = depth;
+  result.lineCount = line + 1;
+  return result;
+};
+
+// Zuletzt gelesene Header (z.B. defineItem.h und defineObj.h)
+const LEXED_CACHE_SIZE = 2;
+const lexedCache: { content: string; header: LexedDefineHeader }[] = [];
+
+/**
+ * Wie lexDefineHeader, liefert für denselben Inhalt aber das Ergebnis des letzten Durchlaufs.
+ * Das Ergebnis wird geteilt und darf nicht verändert werden.
+ */
+export const getLexedDefineHeader = (content: string): LexedDefineHeader => {
+  const index = lexedCache.findIndex(entry => entry.content === content);
+  if (index !== -1) {
+    const [entry] = lexedCache.splice(index, 1);
+    lexedCache.unshift(entry);
+    return entry.header;
+  }
+
+  const header = lexDefineHeader(content);
+  lexedCache.unshift({ content, header });
+  if (lexedCache.length > LEXED_CACHE_SIZE) lexedCache.pop();
+  return header;
+};
+
+/**
+ * Wandelt Tabellen-Einträge in Name/Wert-Paare um (z.B. für die Symboltabelle)
+ */
+export const toDefineSymbols = (entries: DefineEntry[]): { name: string; value: number }[] => {
+  return entries.map(entry => ({ name: entry.name, value: entry.value }));
+};
@@ -0,0 +1,300 @@
+/**
+ * Kompilierte Symboltabelle für Define-Header (defineItem.h, defineObj.h)
+ *
+ * Die Tabelle wird als versioniertes Binärformat in userData/symtab abgelegt
+ * (z.B. defineItem.h.symtab) und ist an den Inhalts-Hash des Headers gebunden.
+ * Beim Warmstart werden nur die Typed-Array-Sektionen eingeblendet und der
+ * Namens-Blob einmal dekodiert - ein erneutes Parsen findet nur statt, wenn sich
+ * der Header tatsächlich geändert hat.
+ *
+ * Layout (little endian, alle Sektionen 4-Byte-ausgerichtet):
+ *   Header   magic "CDST", Version, Anzahl, Namenslänge (UTF-16), Blob-Bytes, Schlüssel-Bytes, reserviert
+ *   Schlüssel  ASCII `${parserVersion}:${contentHash}`
+ *   NAME     Int32 values[n] und Uint32 nameOffsets[n + 1], sortiert nach Name
+ *   ID       Uint32 order[n], Eintragsindizes sortiert nach Wert
+ *   Blob     alle Namen hintereinander, UTF-8
+ */
+import { computeContentHash } from './contentHash';
+
+export interface DefineSymbol {
+  name: string;
+  value: number;
+}
+
+const SYMTAB_MAGIC = 0x54534443; // "CDST"
+const SYMTAB_FORMAT_VERSION = 1;
+const HEADER_BYTES = 28;
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder('utf-8');
+
+const align4 = (value: number): number => (value + 3) & ~3;
+
+export class DefineSymbolTable {
+  readonly count: number;
+  private readonly blob: string;
+  private readonly values: Int32Array;
+  private readonly nameOffsets: Uint32Array;
+  private readonly idOrder: Uint32Array;
+
+  constructor(blob: string, values: Int32Array, nameOffsets: Uint32Array, idOrder: Uint32Array) {
+    this.count = values.length;
+    this.blob = blob;
+    this.values = values;
+    this.nameOffsets = nameOffsets;
+    this.idOrder = idOrder;
+  }
+
+  /**
+   * Baut eine Tabelle aus geparsten Defines auf (Kaltstart)
+   */
+  static fromSymbols(symbols: DefineSymbol[]): DefineSymbolTable {
+    const count = symbols.length;
+
+    // Stabile Sortierung nach Name, damit bei doppelten Namen die Quellreihenfolge erhalten bleibt
+    const byName = Array.from({ length: count }, (_, i) => i);
+    byName.sort((a, b) => {
+      const nameA = symbols[a].name;
+      const nameB = symbols[b].name;
+      return nameA < nameB ? -1 : nameA > nameB ? 1 : a - b;
+    });
+
+    const values = new Int32Array(count);
+    const nameOffsets = new Uint32Array(count + 1);
+    const names: string[] = new Array(count);
+    let offset = 0;
+
+    for (let i = 0; i < count; i++) {
+      const symbol = symbols[byName[i]];
+      values[i] = symbol.value;
+      names[i] = symbol.name;
+      nameOffsets[i] = offset;
+      offset += symbol.name.length;
+    }
+    nameOffsets[count] = offset;
+
+    const idOrder = new Uint32Array(count);
+    for (let i = 0; i < count; i++) idOrder[i] = i;
+    idOrder.sort((a, b) => values[a] - values[b] || a - b);
+
+    return new DefineSymbolTable(names.join(''), values, nameOffsets, idOrder);
+  }
+
+  nameAt(index: number): string {
+    return this.blob.substring(this.nameOffsets[index], this.nameOffsets[index + 1]);
+  }
+
+  valueAt(index: number): number {
+    return this.values[index];
+  }
+
+  /**
+   * Sucht den Wert eines Defines (Binärsuche über die Namenssektion).
+   * Bei mehrfach definierten Namen gewinnt - wie beim Präprozessor - die letzte Definition.
+   */
+  getValue(name: string): number | undefined {
+    let low = 0;
+    let high = this.count;
+
+    // Obere Grenze: erster Index mit nameAt(index) > name
+    while (low < high) {
+      const mid = (low + high) >>> 1;
+      if (this.nameAt(mid) <= name) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+
+    if (low === 0 || this.nameAt(low - 1) !== name) return undefined;
+    return this.values[low - 1];
+  }
+
+  has(name: string): boolean {
+    return this.getValue(name) !== undefined;
+  }
+
+  /**
+   * Liefert alle Namen, die auf den angegebenen Wert definiert sind (ID-Sektion)
+   */
+  getNames(value: number): string[] {
+    let low = 0;
+    let high = this.count;
+
+    while (low < high) {
+      const mid = (low + high) >>> 1;
+      if (this.values[this.idOrder[mid]] < value) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+
+    const names: string[] = [];
+    for (let i = low; i < this.count && this.values[this.idOrder[i]] === value; i++) {
+      names.push(this.nameAt(this.idOrder[i]));
+    }
+    return names;
+  }
+
+  /**
+   * Wandelt die Tabelle in ein einfaches Objekt-Mapping (Name -> Wert) um
+   */
+  toRecord(): Record<string, number> {
+    const record: Record<string, number> = {};
+    for (let i = 0; i < this.count; i++) {
+      record[this.nameAt(i)] = this.values[i];
+    }
+    return record;
+  }
+
+  /**
+   * Serialisiert die Tabelle in das Binärformat
+   * @param key Schlüssel aus Parser-Version und Inhalts-Hash
+   */
+  serialize(key: string): Uint8Array {
+    const keyBytes = textEncoder.encode(key);
+    const blobBytes = textEncoder.encode(this.blob);
+    const count = this.count;
+
+    const keyOffset = HEADER_BYTES;
+    const valuesOffset = align4(keyOffset + keyBytes.length);
+    const offsetsOffset = valuesOffset + count * 4;
+    const orderOffset = offsetsOffset + (count + 1) * 4;
+    const blobOffset = orderOffset + count * 4;
+    const totalBytes = blobOffset + blobBytes.length;
+
+    const buffer = new ArrayBuffer(totalBytes);
+    const view = new DataView(buffer);
+    view.setUint32(0, SYMTAB_MAGIC, true);
+    view.setUint32(4, SYMTAB_FORMAT_VERSION, true);
+    view.setUint32(8, count, true);
+    view.setUint32(12, this.blob.length, true);
+    view.setUint32(16, blobBytes.length, true);
+    view.setUint32(20, keyBytes.length, true);
+    view.setUint32(24, 0, true);
+
+    const bytes = new Uint8Array(buffer);
+    bytes.set(keyBytes, keyOffset);
+    new Int32Array(buffer, valuesOffset, count).set(this.values);
+    new Uint32Array(buffer, offsetsOffset, count + 1).set(this.nameOffsets);
+    new Uint32Array(buffer, orderOffset, count).set(this.idOrder);
+    bytes.set(blobBytes, blobOffset);
+
+    return bytes;
+  }
+
+  /**
+   * Liest eine serialisierte Tabelle ein
+   * @param data Rohdaten der .symtab-Datei
+   * @param expectedKey Erwarteter Schlüssel; bei Abweichung wird null zurückgegeben
+   * @returns Die Tabelle oder null, wenn die Daten veraltet oder ungültig sind
+   */
+  static deserialize(data: Uint8Array, expectedKey: string): DefineSymbolTable | null {
+    if (!data || data.byteLength < HEADER_BYTES) return null;
+
+    // Typed-Array-Views benötigen eine 4-Byte-ausgerichtete Basis
+    const bytes = data.byteOffset % 4 === 0 ? data : data.slice();
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+
+    if (view.getUint32(0, true) !== SYMTAB_MAGIC || view.getUint32(4, true) !== SYMTAB_FORMAT_VERSION) {
+      return null;
+    }
+
+    const count = view.getUint32(8, true);
+    const blobLength = view.getUint32(12, true);
+    const blobByteLength = view.getUint32(16, true);
+    const keyByteLength = view.getUint32(20, true);
+
+    const keyOffset = HEADER_BYTES;
+    const valuesOffset = align4(keyOffset + keyByteLength);
+    const offsetsOffset = valuesOffset + count * 4;
+    const orderOffset = offsetsOffset + (count + 1) * 4;
+    const blobOffset = orderOffset + count * 4;
+
+    if (blobOffset + blobByteLength !== bytes.byteLength) return null;
+
+    const key = textDecoder.decode(bytes.subarray(keyOffset, keyOffset + keyByteLength));
+    if (key !== expectedKey) return null;
+
+    const base = bytes.byteOffset;
+    const values = new Int32Array(bytes.buffer, base + valuesOffset, count);
+    const nameOffsets = new Uint32Array(bytes.buffer, base + offsetsOffset, count + 1);
+    const idOrder = new Uint32Array(bytes.buffer, base + orderOffset, count);
+    const blob = textDecoder.decode(bytes.subarray(blobOffset, blobOffset + blobByteLength));
+
+    if (blob.length !== blobLength || nameOffsets[count] !== blobLength) return null;
+
+    return new DefineSymbolTable(blob, values, nameOffsets, idOrder);
+  }
+}
+
+/**
+ * Lädt eine gespeicherte Symboltabelle aus userData (nur in Electron möglich)
+ */
+const readStoredSymbolTable = async (symtabName: string): Promise<Uint8Array | null> => {
+  try {
+    if (!window.electronAPI?.readSymbolTable) return null;
+
+    const result = await window.electronAPI.readSymbolTable(symtabName);
+    if (result?.success && result.data) {
+      return new Uint8Array(result.data);
+    }
+    return null;
+  } catch (error) {
+    console.warn(`Symboltabelle ${symtabName} konnte nicht gelesen werden:`, error);
+    return null;
+  }
+};
+
+/**
+ * Speichert eine Symboltabelle in userData (nur in Electron möglich)
+ */
+const writeStoredSymbolTable = async (symtabName: string, data: Uint8Array): Promise<void> => {
+  try {
+    if (!window.electronAPI?.writeSymbolTable) return;
+
+    const result = await window.electronAPI.writeSymbolTable(symtabName, data);
+    if (!result?.success) {
+      console.warn(`Symboltabelle ${symtabName} konnte nicht gespeichert werden:`, result?.error);
+    }
+  } catch (error) {
+    console.warn(`Fehler beim Speichern der Symboltabelle ${symtabName}:`, error);
+  }
+};
+
+/**
+ * Liefert die Symboltabelle für einen Define-Header.
+ * Ist eine passende .symtab-Datei vorhanden, wird sie eingelesen, andernfalls wird
+ * der Header geparst und die neu kompilierte Tabelle für den nächsten Start abgelegt.
+ * @param fileName Name des Headers relativ zum Ressourcenordner (z.B. "defineItem.h")
+ * @param content Inhalt des Headers
+ * @param parserVersion Version des Parsers; eine Änderung invalidiert alle Tabellen
+ * @param parse Parser, der die Defines aus dem Header extrahiert
+ */
+export const loadOrCompileSymbolTable = async (
+  fileName: string,
+  content: string,
+  parserVersion: string,
+  parse: (content: string) => DefineSymbol[]
+): Promise<DefineSymbolTable> => {
+  const symtabName = `${fileName}.symtab`;
+  const startTime = performance.now();
+  const key = `${parserVersion}:${await computeContentHash(content)}`;
+
+  const stored = await readStoredSymbolTable(symtabName);
+  if (stored) {
+    const table = DefineSymbolTable.deserialize(stored, key);
+    if (table) {
+      console.log(`Symboltabelle ${symtabName} geladen: ${table.count} Einträge in ${(performance.now() - startTime).toFixed(1)} ms`);
+      return table;
+    }
+    console.log(`Symboltabelle ${symtabName} ist veraltet, ${fileName} wird neu geparst`);
+  }
+
+  const table = DefineSymbolTable.fromSymbols(parse(content));
+  console.log(`Symboltabelle für ${fileName} kompiliert: ${table.count} Einträge in ${(performance.now() - startTime).toFixed(1)} ms`);
+
+  await writeStoredSymbolTable(symtabName, table.serialize(key));
+  return table;
+};
@@ -0,0 +1,49 @@
+/**
+ * Beim Laden erkannte Kodierungen der Ressourcendateien (Renderer-Seite)
+ *
+ * Der Main-Prozess erkennt die Kodierung jeder Datei (BOM/Heuristik), dekodiert sie einmal
+ * und liefert sie mit loadAllFiles bzw. loadResourceFile zurück. Beim Speichern wird
+ * dieselbe Kodierung wieder mitgegeben, damit unveränderte Dateien byte-genau
+ * zurückgeschrieben werden.
+ */
+
+export interface FileEncodingInfo {
+  // WHATWG-Label: "utf-8", "utf-16le", "utf-16be", "windows-1252" oder "euc-kr"
+  encoding: string;
+  bom: boolean;
+  lineEnding: '\r\n' | '\n' | null;
+}
+
+export interface SaveEncodingOptions {
+  encoding?: string;
+  useANSI?: boolean;
+  bom?: boolean;
+  // Erzwingt die angegebene Kodierung statt der beim Laden erkannten
+  forceEncoding?: boolean;
+}
+
+const encodingsByFile = new Map<string, FileEncodingInfo>();
+
+const normalizeName = (fileName: string): string =>
+  fileName.split(/[\\/]/).pop()!.toLowerCase();
+
+/**
+ * Übernimmt die Kodierungen aus einem loadAllFiles-Ergebnis
+ */
+export const setFileEncodings = (encodings: Record<string, FileEncodingInfo> | undefined): void => {
+  if (!encodings) return;
+  for (const [fileName, info] of Object.entries(encodings)) {
+    encodingsByFile.set(normalizeName(fileName), info);
+  }
+};
+
+export const getFileEncoding = (fileName: string): FileEncodingInfo | undefined =>
+  encodingsByFile.get(normalizeName(fileName));
+
+/**
+ * Optionen für saveFileWithEncoding: die erkannte Kodierung, sonst der Fallback des Aufrufers
+ */
+export const getSaveEncodingOptions = (fileName: string, fallback: SaveEncodingOptions): SaveEncodingOptions => {
+  const info = getFileEncoding(fileName);
+  return info ? { encoding: info.encoding, bom: info.bom } : fallback;
+};
@@ -1,8 +1,25 @@
-import { serializeWithNameReplacement, serializePropItems } from './serializeUtils';
+import { toast } from "sonner";
+import { serializeWithNameReplacement, serializePropItems, applyCellsToRow, applyPropItemEntries, applySpecItemCells, collectPropItemEntries, diffItemCells, readPropItemEntries, writeSpecItemCells } from './serializeUtils';
 import { ResourceItem } from "../../types/fileTypes";
+import { getSaveEncodingOptions } from './fileEncodings';
+import { type LineHunk, applyLineHunks, getPatchBase, matchesPatchBase, replaceLineHunk, setPatchBase } from './filePatch';
+import { STREAM_SAVE_THRESHOLD, isSaveStreamAvailable, saveTextStream, writeTextChunks } from './saveStream';
+import { getDefineItemContent, rebaseDefineItemContent } from './defineItemParser';
+import { getMdlDynaContent } from './mdlDynaParser';
+import { getSpecItemRowIndex } from './specItemRowIndex';
+import { isSpecItemHeader } from './parseUtils';
+import { editLines, forEachLine } from './roundTrip';
+import { type FieldChange, clearJournal, commitChanges, getJournalFiles, getPendingChanges, getPendingRow, getPendingRows, hasJournalConflicts, hasPendingChanges, recordChange } from './changeJournal';
+import { showExternalConflict } from './resourceWatcher';
 
-// Track modified files that need to be saved
-export let modifiedFiles: { name: string; content: string; lastModified?: number; metadata?: any }[] = [];
+// Ungespeicherte Änderungen stehen als einzelne Felder im Änderungsjournal (changeJournal.ts)
+const SPEC_ITEM_FILE = "Spec_Item.txt";
+const PROP_ITEM_FILE = "propItem.txt.txt";
+const MDL_DYNA_FILE = "mdlDyna.inc";
+// Spalte der Texte in propItem.txt.txt
+const PROP_ITEM_TEXT_COLUMN = "text";
+// Spalte zeilenweise vorgemerkter Änderungen (trackModifiedFile)
+const LINE_COLUMN = "line";
 
 /**
  * Generiert PropItem-Inhalt für die angegebenen Items
@@ -57,12 +74,6 @@ export const getPropItemIdFromItem = (itemId: string, itemName: string): string
     return itemId;
   }
   
-  // Versuche, die ID aus den vorhandenen modifizierten Dateien zu ermitteln
-  const propItemFile = modifiedFiles.find(file => file.name === "propItem.txt.txt");
-  if (propItemFile && propItemFile.metadata && propItemFile.metadata.propItemId) {
-    return propItemFile.metadata.propItemId;
-  }
-  
   // Als Fallback können wir die ID aus dem Namen oder einer anderen Quelle ableiten
   // Dies ist nur ein Beispiel und sollte an die tatsächliche Anwendungslogik angepasst werden
   
@@ -70,8 +81,20 @@ export const getPropItemIdFromItem = (itemId: string, itemName: string): string
   return "IDS_PROPITEM_TXT_000124"; // Rodney Axe
 };
 
-// Track modified files
-export const trackModifiedFile = (fileName: string, content: string, metadata?: any): void => {
+// Vollständige neue Inhalte, die sich nicht zeilenweise vormerken lassen (Dateiname klein ->
+// Name und Inhalt); sie werden mit den vorgemerkten Änderungen gespeichert (saveJournalFiles)
+const queuedContents = new Map<string, { fileName: string; content: string }>();
+
+const queueKey = (fileName: string): string => fileName.split(/[\\/]/).pop()!.toLowerCase();
+
+/**
+ * Merkt die Änderungen eines vollständigen neuen Inhalts zeilenweise im Änderungsjournal vor
+ * (Zeilennummer -> Zeile). Gehalten werden nur die geänderten Zeilen, nicht der Inhalt selbst.
+ * Ändert sich die Zahl der Zeilen oder ist der Stand der Datei nicht bekannt, lässt sich der
+ * Inhalt nicht als Feldänderungen ausdrücken; er wird dann als Ganzes vorgemerkt.
+ * Gespeichert wird hier nie, sondern erst mit saveJournalFile / saveAllModifiedFiles.
+ */
+export const trackModifiedFile = async (fileName: string, content: string, metadata?: any): Promise<void> => {
   try {
     console.log(`Tracking geänderte Datei: ${fileName}`);
     
@@ -80,132 +103,387 @@ export const trackModifiedFile = (fileName: string, content: string, metadata?:
       return;
     }
     
-    // Spezielle Behandlung für Spec_Item.txt - Stelle sicher, dass Item Icons korrekt formatiert sind
-    if (fileName.toLowerCase().includes('spec_item.txt')) {
-      // Check if we need to format item icons
-      if (metadata?.fields?.specItem?.itemIcon || 
-          metadata?.specItem?.itemIcon || 
-          (metadata?.fields && metadata.fields.specItem && metadata.fields.specItem.itemIcon) ||
-          (metadata?.specItem && metadata.specItem.itemIcon)) {
-        
-        // Finde den Wert des Item Icons
-        let itemIcon = metadata?.fields?.specItem?.itemIcon || 
-                      metadata?.specItem?.itemIcon || 
-                      (metadata?.fields && metadata.fields.specItem && metadata.fields.specItem.itemIcon) ||
-                      (metadata?.specItem && metadata.specItem.itemIcon);
-        
-        if (itemIcon) {
-          console.log(`Item Icon vor Formatierung: "${itemIcon}"`);
-          // Formatiere das Icon mit der Hilfsfunktion
-          const formattedIcon = formatItemIconValue(itemIcon);
-          console.log(`Item Icon nach Formatierung: "${formattedIcon}"`);
-          
-          // Aktualisiere das Icon im Metadata-Objekt
-          if (metadata?.fields?.specItem) {
-            metadata.fields.specItem.itemIcon = formattedIcon;
-          } else if (metadata?.specItem) {
-            metadata.specItem.itemIcon = formattedIcon;
-          }
-          
-          // Aktualisiere auch das Icon im Content, falls es als JSON gespeichert ist
-          try {
-            const contentObj = JSON.parse(content);
-            if (contentObj.item && contentObj.item.itemIcon) {
-              contentObj.item.itemIcon = formattedIcon;
-            } else if (contentObj.item && contentObj.item.fields && contentObj.item.fields.specItem && contentObj.item.fields.specItem.itemIcon) {
-              contentObj.item.fields.specItem.itemIcon = formattedIcon;
-            } else if (contentObj.fields && contentObj.fields.specItem && contentObj.fields.specItem.itemIcon) {
-              contentObj.fields.specItem.itemIcon = formattedIcon;
-            }
-            content = JSON.stringify(contentObj);
-          } catch (e) {
-            // Ignoriere JSON-Parse-Fehler, das bedeutet, dass der Inhalt kein JSON ist
-          }
-        }
+    const base = getPatchBase(fileName)?.content;
+    const baseLines = base !== undefined ? base.split('\n') : null;
+    const lines = content.split('\n');
+    
+    if (!baseLines || baseLines.length !== lines.length || queuedContents.has(queueKey(fileName))) {
+      console.log(`${fileName}: Zeilen hinzugefügt/entfernt oder Stand unbekannt, Inhalt als Ganzes vorgemerkt`);
+      // Die zeilenweisen Einträge beziehen sich auf den alten Stand und gehen im neuen Inhalt auf
+      clearJournal(fileName);
+      if (content === base) {
+        queuedContents.delete(queueKey(fileName));
+      } else {
+        queuedContents.set(queueKey(fileName), { fileName, content });
       }
+      return;
     }
     
-    // Erweitere die Metadaten um zusätzliche Informationen
-    const extendedMetadata = {
-      ...metadata,
-      lastModified: Date.now(),
-      fileName: metadata?.fields?.mdlDyna?.fileName || metadata?.modelFile,
-      type: fileName.toLowerCase().includes('propitem') ? 'propItem' : 
-            fileName.toLowerCase().includes('spec_item') ? 'specItem' : 
-            fileName.toLowerCase().includes('defineitem') ? 'defineItem' : 
-            fileName.toLowerCase().includes('mdldyna') ? 'mdlDyna' : 'unknown'
-    };
-    
-    // Prüfe, ob die Datei bereits als modifiziert markiert ist
-    const existingIndex = modifiedFiles.findIndex(file => file.name === fileName);
-    
-    if (existingIndex !== -1) {
-      console.log(`Datei ${fileName} ist bereits als modifiziert markiert, aktualisiere Inhalt`);
-      modifiedFiles[existingIndex].content = content;
-      modifiedFiles[existingIndex].metadata = extendedMetadata;
-    } else {
-      console.log(`Füge ${fileName} zu modifizierten Dateien hinzu`);
-      modifiedFiles.push({
-        name: fileName,
-        content,
-        metadata: extendedMetadata
-      });
+    const stripCR = (line: string) => line.endsWith('\r') ? line.slice(0, -1) : line;
+    let changedLines = 0;
+    for (let i = 0; i < lines.length; i++) {
+      if (lines[i] === baseLines[i] && !getPendingRow(fileName, String(i + 1))) continue;
+      if (recordChange(fileName, String(i + 1), LINE_COLUMN, stripCR(baseLines[i]), stripCR(lines[i]))) changedLines++;
     }
+    console.log(`${fileName}: ${changedLines} geänderte Zeilen vorgemerkt`);
     
-    // Debug-Logging für bessere Nachvollziehbarkeit
-    console.log(`Metadata für ${fileName}:`, extendedMetadata);
-    
-    // Datei sofort speichern, wenn die Einstellung gesetzt ist
-    const fileType = fileName.toLowerCase();
-    
-    if (metadata?.shouldSaveImmediately || 
-        metadata?.saveDirect || 
-        (fileType.includes('propitem') && metadata?.savePropItemImmediate) || 
-        (fileType.includes('spec_item') && metadata?.saveSpecItemImmediate) || 
-        (fileType.includes('define') && metadata?.saveDefineItemImmediate) || 
-        (fileType.includes('mdldyna') && metadata?.saveMdlDynaImmediate)) {
-      
-      console.log(`Speichere Änderungen für ${fileName} sofort`);
-      
-      if (fileType.includes('propitem.txt.txt')) {
-        // Verwende die spezialisierte Funktion für propItem.txt.txt
-        savePropItemChanges(metadata?.itemsToSave || []);
-      } else if (fileType.includes('spec_item.txt')) {
-        // Verwende spezialisierte Funktion für Spec_Item.txt mit korrekter Formatierung für Item Icons
-        // Stelle sicher, dass alle Icons in den Items korrekt formatiert sind
-        if (metadata.itemsToSave) {
-          metadata.itemsToSave.forEach((item: any) => {
-            if (item?.fields?.specItem?.itemIcon) {
-              item.fields.specItem.itemIcon = formatItemIconValue(item.fields.specItem.itemIcon);
-              console.log(`Item Icon für ${item.id || 'unbekannt'} formatiert: ${item.fields.specItem.itemIcon}`);
-            }
-          });
+    if (metadata?.shouldSaveImmediately || metadata?.saveDirect) {
+      console.log(`${fileName}: wird mit den übrigen Änderungen gespeichert`);
+    }
+  } catch (error) {
+    console.error(`Fehler beim Tracking der Datei ${fileName}:`, error);
+  }
+};
+
+/**
+ * Merkt die Änderungen eines Items an seiner Zeile in Spec_Item.txt als Felder vor
+ * Verglichen wird mit dem geladenen Stand der Datei (filePatch.ts); nur abweichende Zellen
+ * landen im Journal.
+ * @returns true, wenn die Zeile des Items danach ungespeicherte Änderungen hat
+ */
+export const trackSpecItemFields = (item: any): boolean => {
+  const base = getPatchBase(SPEC_ITEM_FILE)?.content;
+  const rowIndex = base ? getSpecItemRowIndex(base) : null;
+  if (!rowIndex) {
+    console.warn(`${SPEC_ITEM_FILE} ist nicht geladen, Änderungen an ${item?.id} können nicht vorgemerkt werden`);
+    return false;
+  }
+  
+  const changes = diffItemCells(item, rowIndex, getPendingRow(SPEC_ITEM_FILE, item.id));
+  if (!changes) {
+    console.warn(`Item ${item?.id} nicht in ${SPEC_ITEM_FILE} gefunden, Änderungen werden nicht vorgemerkt`);
+    return false;
+  }
+  
+  const label = item.displayName || item.name || item.id;
+  let pending = false;
+  for (const change of changes) {
+    if (recordChange(SPEC_ITEM_FILE, item.id, change.column, change.oldValue, change.newValue, label)) pending = true;
+  }
+  return pending;
+};
+
+/**
+ * Merkt Anzeigenamen und Beschreibungen der Items als Einträge von propItem.txt.txt vor
+ * @returns Zahl der Einträge mit ungespeicherten Änderungen
+ */
+export const trackPropItemTexts = (items: any[]): number => {
+  const base = getPatchBase(PROP_ITEM_FILE)?.content ?? "";
+  const entries = items.map(item => ({ item, texts: collectPropItemEntries([item]) }));
+  const ids = new Set<string>();
+  entries.forEach(({ texts }) => texts.forEach((_, id) => ids.add(id)));
+  const oldValues = readPropItemEntries(base, ids);
+  let pending = 0;
+  
+  for (const { item, texts } of entries) {
+    texts.forEach((text, id) => {
+      // Fehlt der Eintrag in der Datei, wird er beim Speichern angehängt
+      const oldValue = oldValues.get(id) ?? "";
+      const newValue = text.trim() === oldValue ? oldValue : text;
+      if (recordChange(PROP_ITEM_FILE, id, PROP_ITEM_TEXT_COLUMN, oldValue, newValue, item.name)) pending++;
+    });
+  }
+  
+  return pending;
+};
+
+/**
+ * Stand einer Datei, auf den die vorgemerkten Änderungen angewendet werden
+ * (der beim Laden gemerkte Inhalt, sonst die Datei direkt laden)
+ */
+const loadJournalBase = async (fileName: string): Promise<string | null> => {
+  const base = getPatchBase(fileName)?.content;
+  if (base !== undefined) return base;
+  
+  try {
+    const response = await fetch(`/resource/${fileName}?t=${Date.now()}`);
+    if (response.ok) return await response.text();
+    console.warn(`Konnte ${fileName} nicht laden, Statuscode: ${response.status}`);
+  } catch (error) {
+    console.error(`Fehler beim Laden von ${fileName}:`, error);
+  }
+  // Neue propItem.txt.txt entsteht aus den Einträgen allein
+  return fileName.toLowerCase() === PROP_ITEM_FILE.toLowerCase() ? "" : null;
+};
+
+// Vorgemerkte Texte von propItem.txt.txt (ID -> Text)
+const getPropItemTexts = (rows: Map<string, Map<string, string>>): Map<string, string> => {
+  const entries = new Map<string, string>();
+  rows.forEach((cells, id) => {
+    const text = cells.get(PROP_ITEM_TEXT_COLUMN);
+    if (text !== undefined) entries.set(id, text);
+  });
+  return entries;
+};
+
+/**
+ * Setzt den neuen Inhalt einer Datei aus ihrem Stand und den vorgemerkten Änderungen zusammen
+ * Neu geschrieben werden nur die betroffenen Zeilen; defineItem.h und mdlDyna.inc halten ihre
+ * Zeilen selbst (LineDocument bzw. Parser-Inhalt), das Journal enthält dort nur die Felder.
+ * @returns null, wenn der Stand der Datei nicht bekannt ist
+ */
+export const materializeJournalFile = async (fileName: string): Promise<string | null> => {
+  const name = fileName.toLowerCase();
+  if (name.includes('defineitem.h')) return getDefineItemContent() || null;
+  if (name.includes('mdldyna.inc')) return getMdlDynaContent() || null;
+  
+  const base = await loadJournalBase(fileName);
+  if (base === null) return null;
+  const rows = getPendingRows(fileName);
+  
+  if (name.includes('spec_item.txt')) {
+    return applySpecItemCells(rows, base);
+  }
+  
+  if (name.includes('propitem.txt.txt')) {
+    const { content, changed, added } = applyPropItemEntries(base, getPropItemTexts(rows));
+    console.log(`${fileName}: ${changed} Einträge geändert, ${added} angehängt`);
+    return content;
+  }
+  
+  return editLines(base, (_, index) => rows.get(String(index + 1))?.get(LINE_COLUMN));
+};
+
+/**
+ * Hunks für die vorgemerkten Änderungen einer Datei, bezogen auf ihren gemerkten Stand
+ * Hunks entstehen nur für die Zeilen der geänderten Einträge (wie materializeJournalFile sie
+ * ändert); der Stand wird dafür nicht in Zeilen zerlegt.
+ * propItem.txt.txt wird nicht als Patch, sondern als Einträge gespeichert (siehe saveJournalFiles).
+ * @returns null für Dateien, deren Zeilen nicht im Journal stehen (defineItem.h, mdlDyna.inc, propItem.txt.txt)
+ */
+export const buildJournalPatch = (fileName: string, base: string): { hunks: LineHunk[]; baseLineCount: number } | null => {
+  const name = fileName.toLowerCase();
+  if (name.includes('defineitem.h') || name.includes('mdldyna.inc') || name.includes('propitem.txt.txt')) return null;
+  
+  const rows = getPendingRows(fileName);
+  const hunks: LineHunk[] = [];
+  
+  if (name.includes('spec_item.txt')) {
+    const rowIndex = getSpecItemRowIndex(base);
+    if (!rowIndex) return null;
+    rows.forEach((cells, itemId) => {
+      const span = rowIndex.find(itemId);
+      if (!span) return;
+      const oldText = base.slice(span.start, span.end);
+      const text = applyCellsToRow(oldText, cells, rowIndex.schema);
+      if (text !== oldText) hunks.push(replaceLineHunk(base, span.line, span.end, text));
+    });
+    hunks.sort((a, b) => a.start - b.start);
+    return { hunks, baseLineCount: rowIndex.lineCount };
+  }
+  
+  const lineCount = forEachLine(base, (line, start, end) => {
+    const text = rows.get(String(line + 1))?.get(LINE_COLUMN);
+    if (text !== undefined && text !== base.slice(start, end)) hunks.push(replaceLineHunk(base, line, end, text));
+  });
+  return { hunks, baseLineCount: lineCount };
+};
+
+/**
+ * Meldet, dass eine Datei seit dem Laden außerhalb des Editors geändert wurde
+ * Gespeichert wird dann nicht; die Änderungen bleiben vorgemerkt.
+ */
+const reportSaveConflict = (fileName: string): void => {
+  console.warn(`${fileName} wurde außerhalb des Editors geändert, Speichern abgebrochen`);
+  toast.error(`${fileName} wurde außerhalb des Editors geändert`, {
+    description: "Nicht gespeichert, die Änderungen bleiben vorgemerkt. Bitte die Datei neu laden."
+  });
+};
+
+// Eine Datei für save-all-files: request geht an den Main-Prozess; content bzw. hunks
+// ergeben danach den neuen gemerkten Stand (hunks bezogen auf den bisherigen)
+interface PreparedJournalSave {
+  fileName: string;
+  changes: FieldChange[];
+  request: { name: string; content?: string; patch?: { hunks: LineHunk[]; baseLineCount: number }; entries?: [string, string][]; baseHash?: string };
+  content?: string;
+  hunks?: LineHunk[];
+  // Der neue Inhalt entspricht dem geladenen Stand: nichts zu schreiben
+  unchanged?: boolean;
+}
+
+/**
+ * Bereitet die vorgemerkten Änderungen einer Datei für save-all-files vor
+ * propItem.txt.txt geht als geänderte Einträge an den Main-Prozess, der sie über seinen
+ * Zeilenindex übernimmt (public/main/propItemIndex.cjs); ist der Stand einer anderen Datei
+ * bekannt, werden nur die Zeilen der Änderungen als Patch übertragen, sonst der ganze Inhalt.
+ * Ergäben die Änderungen genau den geladenen Stand, ist die Datei als unchanged markiert.
+ * @returns null, wenn der Stand der Datei nicht bekannt ist
+ */
+const prepareJournalSave = async (fileName: string): Promise<PreparedJournalSave | null> => {
+  const changes = getPendingChanges(fileName);
+  const base = getPatchBase(fileName);
+  
+  const queued = queuedContents.get(queueKey(fileName));
+  if (queued) {
+    const { content } = queued;
+    return { fileName, changes, request: { name: fileName, content, baseHash: base?.hash }, content, unchanged: matchesPatchBase(fileName, content) };
+  }
+  
+  if (fileName.toLowerCase().includes('propitem.txt.txt')) {
+    const texts = getPropItemTexts(getPendingRows(fileName));
+    // Stehen alle Texte schon so in der Datei, ergäbe der Merge den geladenen Stand
+    const current = base ? readPropItemEntries(base.content, new Set(texts.keys())) : null;
+    const unchanged = !!current && [...texts].every(([id, text]) => current.get(id) === text.trim());
+    return { fileName, changes, request: { name: fileName, entries: [...texts], baseHash: base?.hash }, unchanged };
+  }
+  
+  const patch = base ? buildJournalPatch(fileName, base.content) : null;
+  if (patch) {
+    return { fileName, changes, request: { name: fileName, patch, baseHash: base!.hash }, hunks: patch.hunks, unchanged: patch.hunks.length === 0 };
+  }
+  
+  const content = await materializeJournalFile(fileName);
+  if (!content) return null;
+  return { fileName, changes, request: { name: fileName, content, baseHash: base?.hash }, content, unchanged: matchesPatchBase(fileName, content) };
+};
+
+/**
+ * Speichert die vorgemerkten Änderungen mehrerer Dateien in einem Vorgang (save-all-files,
+ * public/main/atomicSave.cjs): entweder alle oder keine.
+ * Gespeicherte Felder werden aus dem Journal entfernt; während des Speicherns erneut geänderte
+ * Felder bleiben vorgemerkt.
+ * @returns Ergebnis je Datei: SUCCESS, ERROR, CONFLICT oder PENDING (siehe saveAllModifiedFiles)
+ */
+const saveJournalFiles = async (files: string[]): Promise<string[]> => {
+  const results: string[] = [];
+  const prepared: PreparedJournalSave[] = [];
+  
+  for (const fileName of files) {
+    // Nach einer externen Änderung erst speichern, wenn der Konflikt aufgelöst ist
+    if (hasJournalConflicts(fileName)) {
+      console.warn(`${fileName}: Konflikt mit einer externen Änderung, nicht gespeichert`);
+      showExternalConflict(fileName);
+      results.push(`${fileName}: CONFLICT`);
+      continue;
+    }
+    const save = await prepareJournalSave(fileName);
+    if (!save) {
+      console.warn(`${fileName}: Stand der Datei unbekannt, ${getPendingChanges(fileName).length} Änderungen bleiben vorgemerkt`);
+      results.push(`${fileName}: ERROR`);
+      continue;
+    }
+    if (save.unchanged) {
+      console.log(`${fileName} unverändert, Speichern übersprungen`);
+      commitChanges(fileName, save.changes);
+      commitQueuedContent(fileName, save.content);
+      results.push(`${fileName}: SUCCESS`);
+      continue;
+    }
+    console.log(`Speichere ${save.changes.length} geänderte Felder in ${fileName}`);
+    prepared.push(save);
+  }
+  if (prepared.length === 0) return results;
+  
+  try {
+    // baseHash: der Main-Prozess bricht ab, wenn eine Datei nicht mehr dem geladenen Stand entspricht
+    const response = await window.electronAPI!.saveAllFiles(prepared.map(save => save.request));
+    
+    prepared.forEach(({ fileName, changes, content, hunks }, index) => {
+      const result = response?.results?.[index];
+      if (result?.success) {
+        commitChanges(fileName, changes);
+        commitQueuedContent(fileName, content);
+        const base = getPatchBase(fileName);
+        const applied = hunks ?? result.hunks;
+        if (content !== undefined) {
+          setPatchBase(fileName, content, result.hash);
+        } else if (base && applied) {
+          setPatchBase(fileName, applyLineHunks(base.content, applied), result.hash);
         }
-        
-        // Erstelle gesammelten Content mit formatierten Icons
-        const specItemContent = serializeWithNameReplacement({
-          items: metadata.itemsToSave || [],
-          isSpecItemFile: true
-        }, content);
-        
-        // Direktes Nachbearbeiten des Inhalts, um sicherzustellen, dass alle Icons korrekt formatiert sind
-        const fixedContent = fixItemIcons(specItemContent);
-        
-        saveTextFile(fixedContent, "Spec_Item.txt", "public/resource/Spec_Item.txt");
-      } else if (fileType.includes('defineitem.h')) {
-        // Spezielle Behandlung für defineItem.h
-        saveDefineItemChanges(metadata?.itemsToSave || []);
-      } else if (fileType.includes('mdldyna.inc')) {
-        // Spezielle Behandlung für mdlDyna.inc
-        saveMdlDynaChanges(metadata?.itemsToSave || []);
+        results.push(`${fileName}: SUCCESS`);
+      } else if (result?.committed) {
+        console.warn(`${fileName}: ${result.error}`);
+        results.push(`${fileName}: PENDING`);
+      } else if (result?.conflict) {
+        reportSaveConflict(fileName);
+        results.push(`${fileName}: CONFLICT`);
       } else {
-        // Für andere Dateitypen verwende die Standard-Speichermethode
-        saveTextFile(content, fileName);
+        console.error(`Fehler beim Speichern von ${fileName}: ${result?.error || response?.error}`);
+        results.push(`${fileName}: ERROR`);
       }
-    }
+    });
   } catch (error) {
-    console.error(`Fehler beim Tracking der Datei ${fileName}:`, error);
+    console.error('Fehler beim Speichern der Dateien:', error);
+    prepared.forEach(({ fileName }) => results.push(`${fileName}: ERROR`));
+  }
+  
+  return results;
+};
+
+/**
+ * Speichert die vorgemerkten Änderungen einer Datei
+ * In Electron über saveJournalFiles, sonst als vollständiger Inhalt über saveTextFile.
+ */
+export const saveJournalFile = async (fileName: string): Promise<boolean> => {
+  const changes = getPendingChanges(fileName);
+  const queued = queuedContents.get(queueKey(fileName))?.content;
+  if (changes.length === 0 && queued === undefined) return true;
+  
+  if (window.electronAPI?.saveAllFiles) {
+    const [result] = await saveJournalFiles([fileName]);
+    return result.endsWith(': SUCCESS');
+  }
+  
+  const content = queued ?? await materializeJournalFile(fileName);
+  if (!content) {
+    console.warn(`${fileName}: Stand der Datei unbekannt, ${changes.length} Änderungen bleiben vorgemerkt`);
+    return false;
+  }
+  
+  console.log(`Speichere ${changes.length} geänderte Felder in ${fileName}`);
+  if (matchesPatchBase(fileName, content)) {
+    console.log(`${fileName} unverändert, Speichern übersprungen`);
+    commitChanges(fileName, changes);
+    commitQueuedContent(fileName, content);
+    return true;
   }
+  
+  const success = await saveTextFile(content, fileName);
+  if (success) {
+    commitChanges(fileName, changes);
+    commitQueuedContent(fileName, content);
+  }
+  return success;
+};
+
+/**
+ * Speichert Spec_Item.txt mit den vorgemerkten Änderungen unter einem anderen Namen
+ * In Electron werden die Zeilen in Teilen erzeugt und geschrieben (writeSpecItemCells), ohne den
+ * ganzen Inhalt als einen String zusammenzusetzen. Stand und Journal von Spec_Item.txt bleiben
+ * unverändert; für Spec_Item.txt selbst wird wie bisher der vollständige Inhalt gespeichert.
+ * @returns null, wenn der Stand von Spec_Item.txt nicht bekannt ist
+ */
+export const saveSpecItemAs = async (fileName: string): Promise<boolean | null> => {
+  const base = await loadJournalBase(SPEC_ITEM_FILE);
+  if (!base) return null;
+  const rows = getPendingRows(SPEC_ITEM_FILE);
+  
+  if (queueKey(fileName) !== queueKey(SPEC_ITEM_FILE) && isSaveStreamAvailable()) {
+    const result = await saveTextStream(fileName, `public/resource/${fileName}`, write => writeSpecItemCells(rows, base, write));
+    if (result.success) return true;
+    console.log(`Gestreamtes Speichern fehlgeschlagen, versuche saveTextFile...`);
+  }
+  
+  return saveTextFile(applySpecItemCells(rows, base), fileName);
+};
+
+// Gespeicherten vorgemerkten Inhalt entfernen (nicht, wenn er während des Speicherns ersetzt wurde)
+const commitQueuedContent = (fileName: string, content: string | undefined): void => {
+  const key = queueKey(fileName);
+  if (content !== undefined && queuedContents.get(key)?.content === content) queuedContents.delete(key);
+  // Der Parser von defineItem.h setzt seinen Inhalt auf den gespeicherten Stand (angelegte Defines stehen danach darin)
+  if (content !== undefined && key === 'defineitem.h') rebaseDefineItemContent(content);
+};
+
+// Dateien mit vorgemerkten Änderungen oder vorgemerktem Inhalt
+const getFilesToSave = (): string[] => {
+  const files = getJournalFiles();
+  const names = new Set(files.map(queueKey));
+  queuedContents.forEach(({ fileName }, key) => {
+    if (!names.has(key)) files.push(fileName);
+  });
+  return files;
 };
 
 /**
@@ -241,15 +519,15 @@ export const formatItemIconValue = (value: string): string => {
 };
 
 // Method to serialize the file data back to text format
+// Spec_Item.txt wird nicht neu erzeugt: die Änderungen der Items gehen in den geladenen Stand der
+// Datei (bzw. originalContent), alle anderen Zeilen bleiben byte-genau
 export const serializeToText = (fileData: any, originalContent?: string): string => {
-  // If we have the original content and this is a spec_item.txt file, preserve the original format
-  if (fileData.isSpecItemFile) {
-    if (originalContent) {
-      console.log("Preserving original spec_item.txt format");
-      return originalContent;
-    } else {
-      console.warn("Missing originalContent for spec_item.txt file, falling back to generated format");
+  if (fileData.isSpecItemFile || isSpecItemHeader((fileData.header || []).join("\t"))) {
+    const base = originalContent ?? getPatchBase(SPEC_ITEM_FILE)?.content;
+    if (base) {
+      return serializeWithNameReplacement(fileData, base);
     }
+    console.warn("Stand von Spec_Item.txt unbekannt, Inhalt wird aus den Items erzeugt");
   }
   
   // For non-spec_item.txt files or if originalContent is missing, generate the content
@@ -343,56 +621,22 @@ export const trackItemChanges = async (item: ResourceItem, forceWrite: boolean =
       console.log(`Bereinigte Effekte für ${item.id}:`, cleanedEffects);
     }
 
-    // Sammle alle Items, die gespeichert werden sollen
-    const itemsToSave: ResourceItem[] = [item];
-    
-    // Überprüfe, ob wir zusätzliche Metadaten haben
-    const metadata = {
-      shouldSaveImmediately: forceWrite,
-      saveSpecItemImmediate: forceWrite,
-      savePropItemImmediate: forceWrite,
-      saveDefineItemImmediate: forceWrite,
-      saveMdlDynaImmediate: forceWrite,
-      itemsToSave
-    };
-
-    // Aktualisiere die Spec_Item.txt
-    if (item.id) {
-      // Tracke die Änderungen in der Spec_Item.txt
-      await trackModifiedFile(
-        "Spec_Item.txt", 
-        "", // Wir übergeben keinen Inhalt, da wir die Änderungen über serializeWithNameReplacement machen
-        {
-          ...metadata,
-          saveSpecItemImmediate: true // Immer sofort speichern, da wir den gesamten Inhalt ersetzen
-        }
-      );
-    }
-
-    // Wenn das Item einen displayName hat, aktualisiere auch die propItem.txt.txt
-    if (item.displayName || item.description) {
-      // Tracke die Änderungen in der propItem.txt.txt
-      await trackModifiedFile(
-        "propItem.txt.txt", 
-        "", // Wir übergeben keinen Inhalt, da wir die Namen in savePropItemChanges aktualisieren
-        {
-          ...metadata,
-          savePropItemImmediate: true // Immer sofort speichern
-        }
-      );
+    // Geänderte Felder im Änderungsjournal vormerken (nur die Werte, nicht die ganzen Dateien)
+    trackSpecItemFields(item);
+    
+    // Anzeigename und Beschreibung stehen in propItem.txt.txt
+    if (item.displayName !== undefined || item.description !== undefined) {
+      trackPropItemTexts([item]);
     }
-
-    // Wenn das Item ein mdlDyna-Feld hat, aktualisiere auch die mdlDyna.inc
-    if (item.fields?.mdlDyna?.fileName || item.modelFile) {
-      // Tracke die Änderungen in der mdlDyna.inc
-      await trackModifiedFile(
-        "mdlDyna.inc", 
-        "", // Wir übergeben keinen Inhalt, da wir die Modelldaten in saveMdlDynaChanges aktualisieren
-        {
-          ...metadata,
-          saveMdlDynaImmediate: true // Immer sofort speichern
-        }
-      );
+    
+    if (!forceWrite) return;
+    
+    // Sofort speichern; Modelldateien ändert updateModelFileNameInMdlDyna, sie stehen dann bereits im Journal
+    const filesToSave = [SPEC_ITEM_FILE, PROP_ITEM_FILE];
+    if (item.fields?.mdlDyna?.fileName || item.modelFile) filesToSave.push(MDL_DYNA_FILE);
+    
+    for (const fileName of filesToSave) {
+      if (hasPendingChanges(fileName)) await saveJournalFile(fileName);
     }
   } catch (error) {
     console.error("Fehler beim Tracken der Item-Änderungen:", error);
@@ -449,15 +693,16 @@ export const ensurePropItemConsistency = (fileData: any): void => {
     }
     
     // Prüfe, ob beide Dateien bereits als modifiziert markiert sind
-    const specItemModified = modifiedFiles.some(file => file.name === "Spec_Item.txt");
-    const propItemModified = modifiedFiles.some(file => file.name === "propItem.txt.txt");
+    const specItemModified = hasPendingChanges(SPEC_ITEM_FILE);
+    const propItemModified = hasPendingChanges(PROP_ITEM_FILE);
     
     if (specItemModified && propItemModified) {
       console.log("Beide Dateien sind bereits als modifiziert markiert, keine weitere Aktion erforderlich");
       return;
     }
     
-    // Wenn nur eine der Dateien modifiziert ist, stelle sicher, dass die andere auch modifiziert wird
+    // Wenn nur eine der Dateien modifiziert ist, auch die Felder der anderen aus den Items vormerken;
+    // im Journal landen dabei nur Werte, die sich von der Datei unterscheiden
     if (specItemModified && !propItemModified) {
       console.log("Spec_Item.txt ist modifiziert, aber propItem.txt.txt nicht. Stelle Konsistenz her...");
       
@@ -470,33 +715,17 @@ export const ensurePropItemConsistency = (fileData: any): void => {
       );
       
       if (itemsWithNameOrDesc.length > 0) {
-        console.log(`${itemsWithNameOrDesc.length} Items mit Name/Beschreibung gefunden, aktualisiere propItem.txt.txt`);
-        
-        // Erstelle propItem.txt.txt Inhalt
-        const propItemContent = generatePropItemContent(itemsWithNameOrDesc);
-        
-        // Speichere die Änderungen
-        trackModifiedFile("propItem.txt.txt", propItemContent, {
-          isFullSync: true,
-          sourceFile: "Spec_Item.txt",
-          lastModified: Date.now()
-        });
+        const pending = trackPropItemTexts(itemsWithNameOrDesc);
+        console.log(`${itemsWithNameOrDesc.length} Items mit Name/Beschreibung gefunden, ${pending} propItem-Einträge vorgemerkt`);
       }
     } else if (!specItemModified && propItemModified) {
       console.log("propItem.txt.txt ist modifiziert, aber Spec_Item.txt nicht. Stelle Konsistenz her...");
       
-      // In diesem Fall müssen wir sicherstellen, dass Spec_Item.txt die Änderungen hat
-      // Das ist komplexer, da wir das Format beibehalten müssen
-      
-      // Wir markieren Spec_Item.txt als modifiziert mit dem aktuellen fileData
-      trackModifiedFile("Spec_Item.txt", JSON.stringify({
-        ...fileData,
-        isSpecItemFile: true
-      }), {
-        isFullSync: true,
-        sourceFile: "propItem.txt.txt",
-        lastModified: Date.now()
+      let pendingItems = 0;
+      fileData.items.forEach(item => {
+        if (item?.id && trackSpecItemFields(item)) pendingItems++;
       });
+      console.log(`${pendingItems} Items mit Änderungen in Spec_Item.txt vorgemerkt`);
     }
   } catch (error) {
     console.error("Fehler bei der Konsistenzprüfung:", error);
@@ -525,153 +754,27 @@ export const savePropItemChanges = async (items: any[]): Promise<boolean> => {
     
     console.log(`${modifiedItems.length} zu modifizierende Items gefunden`);
     
-    // Erstelle ein Mapping der IDs zu den aktualisierten Werten
-    const updatedEntries = new Map<string, string>();
-    
-    modifiedItems.forEach(item => {
-      if (!item) return;
-      
-      // Hole die ID
-      const propItemId = (item.data?.szName || item.id) as string;
-      if (!propItemId) return;
-      
-      // Parse die ID
-      const idMatch = propItemId.match(/IDS_PROPITEM_TXT_(\d+)/);
-      if (!idMatch) return;
-      
-      const baseId = parseInt(idMatch[1], 10);
-      if (isNaN(baseId)) return;
-      
-      // Aktualisiere Namen, wenn vorhanden
-      if (item.displayName !== undefined) {
-        const nameId = `IDS_PROPITEM_TXT_${baseId.toString().padStart(6, '0')}`;
-        updatedEntries.set(nameId, item.displayName || item.name || '');
-        console.log(`Namen aktualisieren: ${nameId} = "${item.displayName || item.name || ''}"`);
-      }
-      
-      // Aktualisiere Beschreibung, wenn vorhanden
-      if (item.description !== undefined) {
-        const descId = `IDS_PROPITEM_TXT_${(baseId + 1).toString().padStart(6, '0')}`;
-        updatedEntries.set(descId, item.description || '');
-        console.log(`Beschreibung aktualisieren: ${descId} = "${item.description || ''}"`);
-      }
-    });
-    
-    // Lade die vorhandene Datei, um die Aktualisierungen vorzunehmen
-    let existingContent = "";
-    let existingLines: string[] = [];
-    
-    try {
-      // Lade die Datei direkt über Fetch mit Cache-Busting-Parameter
-      const cacheBuster = Date.now();
-      const response = await fetch(`/resource/propItem.txt.txt?t=${cacheBuster}`);
-      if (response.ok) {
-        existingContent = await response.text();
-        console.log(`Vorhandene propItem.txt.txt geladen, Länge: ${existingContent.length} Zeichen`);
-        
-        existingLines = existingContent.split(/\r?\n/);
-        console.log(`Datei enthält ${existingLines.length} Zeilen`);
-        } else {
-        console.warn(`Konnte vorhandene Datei nicht laden, Statuscode: ${response.status}`);
-        // Wenn die Datei nicht geladen werden kann, erstellen wir eine neue
-        existingLines = [];
-      }
-    } catch (error) {
-      console.error(`Fehler beim Laden der Datei:`, error);
-      existingLines = [];
-    }
-    
-    console.log(`Aktualisiere ${updatedEntries.size} Einträge in der Datei`);
-    
-    // Aktualisiere die Zeilen oder füge neue hinzu
-    const updatedLines = [...existingLines];
-    const processedIds = new Set<string>();
-    
-    // Update existing lines
-    for (let i = 0; i < updatedLines.length; i++) {
-      const line = updatedLines[i];
-        const parts = line.split('\t');
-      
-        if (parts.length >= 2) {
-        const id = parts[0];
-        
-        if (updatedEntries.has(id)) {
-          // Aktualisiere die Zeile mit dem neuen Wert
-          const newValue = updatedEntries.get(id);
-          const oldLine = updatedLines[i];
-          
-          updatedLines[i] = `${id}\t${newValue}`;
-          processedIds.add(id);
-          
-          console.log(`Zeile ${i+1} aktualisiert: "${oldLine}" -> "${updatedLines[i]}"`);
-        }
-      }
-    }
-    
-    // Add new entries that weren't in the file
-    for (const [id, value] of updatedEntries.entries()) {
-      if (!processedIds.has(id)) {
-        updatedLines.push(`${id}\t${value}`);
-        console.log(`Neue Zeile hinzugefügt: "${id}\t${value}"`);
-      }
+    // Nur Texte, die sich von der Datei unterscheiden, landen im Journal; gespeichert wird wie bei
+    // allen vorgemerkten Änderungen über den Zeilenindex im Main-Prozess, alle anderen Zeilen
+    // (Reihenfolge, weitere Spalten, Zeilenenden) bleiben byte-genau
+    const pending = trackPropItemTexts(modifiedItems);
+    if (!hasPendingChanges(PROP_ITEM_FILE)) {
+      console.log(`Keine Einträge in ${PROP_ITEM_FILE} geändert, Speichern übersprungen`);
+      return true;
     }
     
-    // Erstelle den endgültigen Inhalt, verwende CRLF für Windows-Kompatiblität
-    const finalContent = updatedLines.join('\r\n');
-    
-    console.log(`Finaler Inhalt erstellt: ${finalContent.length} Zeichen`);
+    console.log(`${pending} geänderte Einträge in ${PROP_ITEM_FILE}`);
+    const success = await saveJournalFile(PROP_ITEM_FILE);
     
-    // Speichere den aktualisierten Inhalt direkt in die Datei
-    const fileName = "propItem.txt.txt";
-    const savePath = "public/resource/propItem.txt.txt";
-    
-    try {
-      console.log(`Speichere Datei als ${savePath}`);
-      
-      // Speichere mit ANSI-Kodierung wenn möglich
-      if ((window as any).electronAPI?.saveFileWithEncoding) {
-        const encodingOptions = {
-          encoding: 'latin1', // Für ANSI-Kompatibilität
-          useANSI: true
-        };
-        
-        const result = await (window as any).electronAPI.saveFileWithEncoding(
-          fileName, 
-          finalContent, 
-          savePath, 
-          encodingOptions
-        );
-        
-        if (result === 'SUCCESS' || (result && result.success)) {
-          console.log(`Datei erfolgreich mit ANSI-Kodierung gespeichert`);
-          // Entferne aus modifizierten Dateien
-          modifiedFiles = modifiedFiles.filter(file => file.name !== fileName);
-          
-          // Datei neu laden und State aktualisieren
-          await reloadPropItemFile();
-          
-          return true;
-        } else {
-          console.error(`Fehler beim Speichern mit ANSI-Kodierung:`, result);
-        }
-      }
+    if (success) {
+      console.log(`Datei erfolgreich gespeichert`);
       
-      // Fallback zur normalen Speichermethode
-      const success = await saveTextFile(finalContent, fileName);
+      // Datei neu laden und State aktualisieren
+      await reloadPropItemFile();
       
-      if (success) {
-        console.log(`Datei erfolgreich gespeichert`);
-        
-        // Datei neu laden und State aktualisieren
-        await reloadPropItemFile();
-        
-        return true;
-      } else {
-        console.error(`Fehler beim Speichern der Datei`);
-        return false;
-      }
-    } catch (error) {
-      console.error(`Fehler beim Speichern:`, error);
+      return true;
+    } else {
+      console.error(`Fehler beim Speichern der Datei`);
       return false;
     }
   } catch (error) {
@@ -806,36 +909,24 @@ export const saveDefineItemChanges = async (items: any[]): Promise<boolean> => {
     
     console.log(`${modifiedItems.length} zu modifizierende Items gefunden`);
     
-    // Erstelle den Inhalt für defineItem.h
-    let content = '';
-    
-    modifiedItems.forEach(item => {
-      if (!item) return;
-      
-      // Generiere die Define-Zeile
-      const defineLine = `#define ${item.id}`;
-      content += defineLine + '\n';
-      
-      // Füge Effekte hinzu, wenn vorhanden
-      if (item.effects && Array.isArray(item.effects)) {
-        item.effects.forEach((effect: any, index: number) => {
-          if (effect && effect.type && effect.value !== undefined) {
-            content += `\t${effect.type}\t${effect.value}\n`;
-          }
-        });
-      }
-      
-      // Füge eine Leerzeile zwischen den Items hinzu
-      content += '\n';
-    });
+    // Geänderte IDs stehen bereits im LineDocument des Parsers (updateItemIdsInDefine); nur dessen
+    // Inhalt wird gespeichert, damit alle übrigen Zeilen byte-genau erhalten bleiben
+    const fileName = "defineItem.h";
+    const savedChanges = getPendingChanges(fileName);
+    const content = getDefineItemContent();
+    if (!content) {
+      console.warn("defineItem.h ist nicht geladen, nichts zu speichern");
+      return false;
+    }
     
     // Speichere die Änderungen
-    const fileName = "defineItem.h";
     const savePath = "public/resource/defineItem.h";
     const success = await saveTextFile(content, fileName, savePath);
     
     if (success) {
       console.log("defineItem.h erfolgreich gespeichert");
+      commitChanges(fileName, savedChanges);
+      commitQueuedContent(fileName, content);
       
       // Datei neu laden und State aktualisieren
       await reloadDefineItemFile();
@@ -975,28 +1066,22 @@ export const saveMdlDynaChanges = async (items: any[]): Promise<boolean> => {
     
     console.log(`${modifiedItems.length} zu modifizierende Items gefunden`);
     
-    // Erstelle den Inhalt für mdlDyna.inc
-    let content = '';
-    
-    modifiedItems.forEach(item => {
-      if (!item) return;
-      
-      // Generiere die Include-Zeile mit dem korrekten Dateinamen
-      const fileName = item.modelFile || item.fields?.mdlDyna?.fileName || '';
-      const includeLine = `#include "${fileName}"`;
-      content += includeLine + '\n';
-      
-      // Füge eine Leerzeile zwischen den Items hinzu
-      content += '\n';
-    });
+    // Geänderte Modelldateien stehen bereits im Inhalt des Parsers (updateModelFileNameInMdlDyna)
+    const fileName = MDL_DYNA_FILE;
+    const savedChanges = getPendingChanges(fileName);
+    const content = getMdlDynaContent();
+    if (!content) {
+      console.warn("mdlDyna.inc ist nicht geladen, nichts zu speichern");
+      return false;
+    }
     
     // Speichere die Änderungen
-    const fileName = "mdlDyna.inc";
     const savePath = "public/resource/mdlDyna.inc";
     const success = await saveTextFile(content, fileName, savePath);
     
     if (success) {
       console.log("mdlDyna.inc erfolgreich gespeichert");
+      commitChanges(fileName, savedChanges);
       
       // Datei neu laden und State aktualisieren
       await reloadMdlDynaFile();
@@ -1099,14 +1184,15 @@ export const parseMdlDynaContent = (content: string): any[] => {
   }
 };
 
-// Get the list of modified files
-export const getModifiedFiles = () => {
-  return [...modifiedFiles];
+// Dateien mit ungespeicherten Änderungen und ihre geänderten Felder (Feld-Diff für die Anzeige)
+export const getModifiedFiles = (): { name: string; changes: FieldChange[] }[] => {
+  return getFilesToSave().map(name => ({ name, changes: getPendingChanges(name) }));
 };
 
-// Clear the list of modified files
+// Verwirft alle ungespeicherten Änderungen
 export const clearModifiedFiles = () => {
-  modifiedFiles = [];
+  clearJournal();
+  queuedContents.clear();
 };
 
 // Funktion zum Herunterladen einer Textdatei als Fallback
@@ -1221,10 +1307,12 @@ export const saveTextFile = async (
       return false;
     }
     
-    // Spezieller Fall für Spec_Item.txt: Stelle sicher, dass Icons korrekt formatiert sind
-    if (fileName.includes('Spec_Item.txt')) {
-      console.log("Überprüfe Spec_Item.txt auf korrekte Icon-Formatierung vor dem Speichern...");
-      content = fixItemIcons(content);
+    // Die Serialisierer übernehmen unveränderte Zeilen byte-genau (Item Icons in Spec_Item.txt
+    // werden nur in geänderten Zeilen formatiert): Inhalt wie zuletzt geladen/gespeichert heißt
+    // nichts zu schreiben
+    if (!customPath && matchesPatchBase(fileName, content)) {
+      console.log(`${fileName} unverändert, Speichern übersprungen`);
+      return true;
     }
     
     // Bestimme den Speicherpfad
@@ -1255,10 +1343,11 @@ export const saveTextFile = async (
       console.log('propItem.txt.txt-Datei erkannt, verwende ANSI-Kodierung für Windows-Kompatibilität');
       
       // Bei Electron können wir spezielle Parameter für die Kodierung übergeben
-      const encodingOptions = {
+      // Beim Laden erkannte Kodierung, sonst ANSI (Windows-1252)
+      const encodingOptions = getSaveEncodingOptions(fileName, {
         encoding: 'latin1', // Windows-1252/ANSI-ähnliche Kodierung
         useANSI: true
-      };
+      });
       
       // Speichere die Metadaten mit der Datei
       if ((window as any).electronAPI?.saveFileWithEncoding) {
@@ -1268,9 +1357,7 @@ export const saveTextFile = async (
           
           if (result === 'SUCCESS' || (result && result.success === true)) {
             console.log(`propItem.txt.txt erfolgreich mit ANSI-Kodierung gespeichert`);
-            
-            // Entferne die Datei aus der Liste der modifizierten Dateien
-            modifiedFiles = modifiedFiles.filter(file => file.name !== fileName);
+            if (!customPath) setPatchBase(fileName, content, result?.hash);
             
             return true;
           } else {
@@ -1292,6 +1379,16 @@ export const saveTextFile = async (
     
     console.log(`Umgebungsprüfung: isElectron=${isElectron}, hasElectronAPI=${hasElectronAPI}`);
     
+    // Große Inhalte in Teilen übertragen statt als ein String über IPC (siehe saveStream.ts)
+    if (!isPropItemFile && finalContent.length >= STREAM_SAVE_THRESHOLD && isSaveStreamAvailable()) {
+      const result = await saveTextStream(fileName, savePath, write => writeTextChunks(finalContent, write));
+      if (result.success) {
+        if (!customPath) setPatchBase(fileName, finalContent, result.hash);
+        return true;
+      }
+      console.log(`Gestreamtes Speichern fehlgeschlagen, versuche saveFile...`);
+    }
+    
     // Speichern über Electron, wenn verfügbar
     if (hasElectronAPI) {
       try {
@@ -1304,17 +1401,12 @@ export const saveTextFile = async (
         
         if (result && result.success === true) {
           console.log(`Datei erfolgreich gespeichert: ${savePath}, Größe: ${result.size || 'unbekannt'} Bytes`);
-          
-          // Entferne die Datei aus der Liste der modifizierten Dateien
-          modifiedFiles = modifiedFiles.filter(file => file.name !== fileName);
+          if (!customPath) setPatchBase(fileName, finalContent, result.hash);
           
           return true;
         } else if (result === 'SUCCESS') {
           console.log(`Datei erfolgreich gespeichert: ${savePath} (altes API-Format)`);
           
-          // Entferne die Datei aus der Liste der modifizierten Dateien
-          modifiedFiles = modifiedFiles.filter(file => file.name !== fileName);
-          
           return true;
         } else {
           // Konvertiere [object Object] in lesbare Fehlermeldung
@@ -1350,7 +1442,6 @@ export const saveTextFile = async (
     const savedWithFileSystemAPI = await saveWithFileSystemAPI(finalContent, fileName);
     if (savedWithFileSystemAPI) {
       console.log(`Datei erfolgreich über FileSystem API gespeichert`);
-      modifiedFiles = modifiedFiles.filter(file => file.name !== fileName);
       return true;
     }
     
@@ -1454,8 +1545,8 @@ export const saveTextFile2 = async (
           if (Array.isArray(items) && items.length > 0) {
             console.log(`Gefundene Items in JSON: ${items.length}`);
             
-            // Direktes Serialisieren der Items ohne existierenden Inhalt zu lesen
-            content = serializePropItems(items);
+            // Einträge in den geladenen Stand übernehmen; nur ohne ihn entsteht eine neue Datei
+            content = serializePropItems(items, getPatchBase(PROP_ITEM_FILE)?.content);
             console.log(`Serialisierter Inhalt für PropItem.txt.txt erzeugt (${content.length} Bytes)`);
           }
         } else if (content.includes('\t') && content.includes('IDS_PROPITEM_TXT_')) {
@@ -1508,9 +1599,6 @@ export const saveTextFile2 = async (
     if (result === 'SUCCESS') {
       console.log(`Datei erfolgreich gespeichert: ${savePath}`);
       
-      // Entferne die Datei aus der Liste der modifizierten Dateien
-      modifiedFiles = modifiedFiles.filter(file => file.name !== targetFileInfo.path);
-      
       return 'SUCCESS';
             } else {
       // Verbesserte Fehlerbehandlung
@@ -1538,157 +1626,29 @@ export const saveTextFile2 = async (
 };
 
 // Save all modified files at once
-export const saveAllModifiedFiles = async (context: any): Promise<string[]> => {
+// Alle Dateien mit vorgemerkten Feldern werden in einem Vorgang gespeichert (saveJournalFiles):
+// entweder alle oder keine.
+// Ergebnis je Datei: SUCCESS, ERROR, CONFLICT (extern geändert, nichts wurde gespeichert) oder
+// PENDING (nach dem Commit noch nicht ersetzt; wird beim nächsten Speichern oder Start
+// nachgezogen, die Änderungen bleiben bis dahin vorgemerkt)
+export const saveAllModifiedFiles = async (context?: any): Promise<string[]> => {
   const results: string[] = [];
+  const files = getFilesToSave();
   
   // Log the number of modified files
-  console.log(`Speichere alle ${modifiedFiles.length} modifizierten Dateien`);
+  console.log(`Speichere alle ${files.length} modifizierten Dateien (${getPendingChanges().length} geänderte Felder)`);
   
-  for (const fileInfo of modifiedFiles) {
-    // Prüfe, ob ein gültiger Inhalt vorhanden ist
-    if (!fileInfo.content) {
-      console.warn(`Leerer Inhalt für Datei ${fileInfo.name}, überspringe...`);
-      results.push(`${fileInfo.name}: ERROR (leerer Inhalt)`);
-      continue;
-    }
-    
-    // Stelle sicher, dass der Inhalt ein String ist und ersetze ihn NICHT mit originalContent
-    let content = fileInfo.content;
-    
-    // Wenn die Datei eine Spec_Item.txt oder propItem.txt.txt ist, stelle sicher, dass wir die korrekten Serialisierungsfunktionen verwenden
-    const isSpecItemFile = fileInfo.name.toLowerCase().includes('spec_item.txt');
-    const isPropItemFile = fileInfo.name.toLowerCase().includes('propitem.txt.txt');
-    const isDefineItemFile = fileInfo.name.toLowerCase().includes('defineitem.h');
-    const isMdlDynaFile = fileInfo.name.toLowerCase().includes('mdldyna.inc');
-    
-    if ((isSpecItemFile || isPropItemFile || isDefineItemFile || isMdlDynaFile) && typeof content === 'string' && content.trim().startsWith('{')) {
-      try {
-        const parsedContent = JSON.parse(content);
-        
-        if (!parsedContent || !parsedContent.items || !Array.isArray(parsedContent.items)) {
-          console.warn(`Ungültiges JSON für ${fileInfo.name}, items fehlt oder ist kein Array`);
-          results.push(`${fileInfo.name}: ERROR (ungültiges Format)`);
-          continue;
-        }
-        
-        // Debugging-Ausgabe für Items mit Änderungen
-        const itemsWithChanges = parsedContent.items?.filter((item: any) => 
-          item.displayName !== undefined || 
-          item.description !== undefined ||
-          item.effects !== undefined ||
-          item.modelFile !== undefined ||
-          item.data !== undefined
-        );
-        
-        if (itemsWithChanges?.length > 0) {
-          console.log(`${fileInfo.name} enthält ${itemsWithChanges.length} Items mit Änderungen:`);
-          itemsWithChanges.slice(0, 3).forEach((item: any, index: number) => {
-            console.log(`Item ${index + 1}: ${item.name || item.id || 'unbekannt'}`);
-            if (item.displayName !== undefined) console.log(`  Name: "${item.displayName}"`);
-            if (item.description !== undefined) console.log(`  Beschreibung: "${item.description?.substring(0, 30)}..."`);
-            if (item.effects !== undefined) console.log(`  Effekte: ${item.effects.length}`);
-            if (item.modelFile !== undefined) console.log(`  Model: "${item.modelFile}"`);
-          });
-        }
-        
-        // Format item icons correctly in the items before serialization
-        if (isSpecItemFile) {
-          // Ensure all icons have proper formatting
-          parsedContent.items.forEach((item: any) => {
-            if (item?.fields?.specItem?.itemIcon) {
-              item.fields.specItem.itemIcon = formatItemIconValue(item.fields.specItem.itemIcon);
-              console.log(`Item Icon für ${item.id || 'unbekannt'} formatiert: ${item.fields.specItem.itemIcon}`);
-            }
-          });
-        }
-        
-        // Verwende die entsprechende Serialisierungsfunktion
-        if (isSpecItemFile) {
-          // Hole den originalContent aus den parsedContent-Daten
-          let originalContent = '';
-          if (parsedContent.originalContent && typeof parsedContent.originalContent === 'string') {
-            originalContent = parsedContent.originalContent;
-          }
-          
-          content = serializeWithNameReplacement(parsedContent, originalContent);
-          console.log(`Serialisierten Inhalt für ${fileInfo.name} erstellt (${content.length} Bytes)`);
-          
-          // Additional direct processing of the content to ensure proper icon formatting
-          content = fixItemIcons(content);
-        } else if (isPropItemFile) {
-          content = serializePropItems(parsedContent.items || []);
-          console.log(`Serialisierten Inhalt für ${fileInfo.name} erstellt (${content.length} Bytes)`);
-        } else if (isDefineItemFile) {
-          content = serializeDefineItems(parsedContent.items || []);
-          console.log(`Serialisierten Inhalt für ${fileInfo.name} erstellt (${content.length} Bytes)`);
-        } else if (isMdlDynaFile) {
-          content = serializeMdlDynaItems(parsedContent.items || []);
-          console.log(`Serialisierten Inhalt für ${fileInfo.name} erstellt (${content.length} Bytes)`);
-        }
-      } catch (err) {
-        console.warn(`Konnte Inhalt für ${fileInfo.name} nicht verarbeiten: ${err.message}`);
-      }
-    }
-    
-    // Prüfen, ob nach der Serialisierung ein gültiger Inhalt vorhanden ist
-    if (!content) {
-      console.warn(`Nach der Serialisierung leerer Inhalt für Datei ${fileInfo.name}, überspringe...`);
-      results.push(`${fileInfo.name}: ERROR (leerer Inhalt nach Serialisierung)`);
-      continue;
+  if (!window.electronAPI?.saveAllFiles) {
+    for (const fileName of files) {
+      const success = await saveJournalFile(fileName);
+      results.push(`${fileName}: ${success ? 'SUCCESS' : 'ERROR'}`);
     }
-    
-    // Speichern der Datei
-    const result = await saveTextFile2(context, {
-      path: fileInfo.name,
-      content,
-    });
-    
-    results.push(`${fileInfo.name}: ${result}`);
+    return results;
   }
   
-  return results;
+  return saveJournalFiles(files);
 };
 
-/**
- * Hilfsfunktion, um Item Icons in der serialisierten Datei direkt zu korrigieren
- * Diese Funktion durchsucht den Text nach DDS-Dateien und stellt sicher, dass sie 
- * mit dreifachen Anführungszeichen umschlossen sind.
- */
-function fixItemIcons(content: string): string {
-  // Nur fortfahren, wenn Inhalt vorhanden ist
-  if (!content) return content;
-  
-  console.log('Prüfe auf korrekte Icon-Formatierung...');
-  
-  // Teile den Inhalt in Zeilen auf
-  const lines = content.split(/\r?\n/);
-  const updatedLines = lines.map(line => {
-    // Teile die Zeile in Tabs
-    const parts = line.split('\t');
-    
-    // Suche nach einem Teil, der wie ein Icon aussieht (enthält .dds)
-    if (parts.length > 2) {
-      for (let i = 0; i < parts.length; i++) {
-        // Prüfe, ob der Teil ein Icon sein könnte
-        if (parts[i] && parts[i].includes('.dds') && !parts[i].startsWith('"""') && !parts[i].endsWith('"""')) {
-          // Entferne alle vorhandenen Anführungszeichen
-          const cleanIcon = parts[i].replace(/^["']{0,3}|["']{0,3}$/g, '');
-          
-          // Formatiere das Icon korrekt mit dreifachen Anführungszeichen
-          parts[i] = `"""${cleanIcon}"""`;
-          console.log(`Icon in Zeile korrigiert: ${cleanIcon} -> ${parts[i]}`);
-        }
-      }
-    }
-    
-    // Setze die Zeile wieder zusammen
-    return parts.join('\t');
-  });
-  
-  // Setze den Inhalt wieder zusammen
-  return updatedLines.join('\n');
-}
-
 // Hilfsfunktion, um den Dateinamen aus einem Pfad zu extrahieren
 const getFilename = (filePath: string): string => {
   if (!filePath) return '';
@@ -1750,48 +1710,3 @@ export const readTextFile = (file: File): Promise<string> => {
     }
   });
 };
-
-// Hilfsfunktionen für die Serialisierung verschiedener Dateitypen
-const serializeDefineItems = (items: any[]): string => {
-  let content = '';
-  
-  items.forEach(item => {
-    if (!item) return;
-    
-    // Generiere die Define-Zeile
-    const defineLine = `#define ${item.id}`;
-    content += defineLine + '\n';
-    
-    // Füge Effekte hinzu, wenn vorhanden
-    if (item.effects && Array.isArray(item.effects)) {
-      item.effects.forEach((effect: any) => {
-        if (effect && effect.type && effect.value !== undefined) {
-          content += `\t${effect.type}\t${effect.value}\n`;
-        }
-      });
-    }
-    
-    // Füge eine Leerzeile zwischen den Items hinzu
-    content += '\n';
-  });
-  
-  return content;
-};
-
-const serializeMdlDynaItems = (items: any[]): string => {
-  let content = '';
-  
-  items.forEach(item => {
-    if (!item) return;
-    
-    // Generiere die Include-Zeile mit dem korrekten Dateinamen
-    const fileName = item.modelFile || item.fields?.mdlDyna?.fileName || '';
-    const includeLine = `#include "${fileName}"`;
-    content += includeLine + '\n';
-    
-    // Füge eine Leerzeile zwischen den Items hinzu
-    content += '\n';
-  });
-  
-  return content;
-};
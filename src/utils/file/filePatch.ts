@@ -0,0 +1,98 @@
+/**
+ * Delta-Speichern: nur geänderte Zeilenbereiche an den Main-Prozess schicken
+ *
+ * Für jede über loadResourceFile geladene (oder zuletzt gespeicherte) Datei merken wir uns
+ * den Text und den SHA-1 der Bytes auf der Platte, wie ihn der Main-Prozess geliefert hat.
+ * Beim Speichern entstehen die Hunks direkt aus den Zeilen der vorgemerkten Änderungen
+ * (buildJournalPatch in fileOperations.ts); sie werden samt Basis-Hash mit save-all-files
+ * übertragen und vom Main-Prozess in die Datei übernommen (public/main/filePatch.cjs). Passt der Hash nicht
+ * mehr zur Datei, wurde sie außerhalb des Editors geändert: das ist ein Konflikt, der
+ * gemeldet wird, statt die Datei mit dem vollständigen Inhalt zu überschreiben.
+ */
+
+export interface LineHunk {
+  // Ersetzt die Zeilen [start, end) der Basis (inkl. Zeilenumbrüche) durch text
+  start: number;
+  end: number;
+  text: string;
+}
+
+export interface PatchBase {
+  content: string;
+  hash: string;
+}
+
+const bases = new Map<string, PatchBase>();
+
+const normalizeName = (fileName: string): string =>
+  fileName.split(/[\\/]/).pop()!.toLowerCase();
+
+/**
+ * Merkt sich den Stand einer Datei auf der Platte
+ * @param hash SHA-1 der Dateibytes (vom Main-Prozess)
+ */
+export const setPatchBase = (fileName: string, content: string, hash: string | undefined): void => {
+  if (hash) {
+    bases.set(normalizeName(fileName), { content, hash });
+  } else {
+    bases.delete(normalizeName(fileName));
+  }
+};
+
+export const clearPatchBase = (fileName: string): void => {
+  bases.delete(normalizeName(fileName));
+};
+
+export const getPatchBase = (fileName: string): PatchBase | undefined =>
+  bases.get(normalizeName(fileName));
+
+/**
+ * Entspricht content dem bekannten Stand der Datei auf der Platte? Dann muss nicht gespeichert werden.
+ */
+export const matchesPatchBase = (fileName: string, content: string): boolean =>
+  bases.get(normalizeName(fileName))?.content === content;
+
+// Startposition jeder Zeile im Text (Zeilen wie content.split('\n')); letzter Eintrag = Textende
+const lineStarts = (content: string): Uint32Array => {
+  let count = 1;
+  for (let i = content.indexOf('\n'); i !== -1; i = content.indexOf('\n', i + 1)) count++;
+  const starts = new Uint32Array(count + 1);
+  let line = 1;
+  for (let i = content.indexOf('\n'); i !== -1; i = content.indexOf('\n', i + 1)) starts[line++] = i + 1;
+  starts[count] = content.length;
+  return starts;
+};
+
+/**
+ * Hunk, der den Text einer Zeile ersetzt; ihr Zeilenende (\r\n, \n oder keins) bleibt erhalten
+ * @param end Ende des Zeileninhalts ohne Zeilenende
+ */
+export const replaceLineHunk = (content: string, line: number, end: number, text: string): LineHunk => {
+  let breakEnd = end;
+  if (content.charCodeAt(breakEnd) === 13) breakEnd++;
+  if (content.charCodeAt(breakEnd) === 10) breakEnd++;
+  return { start: line, end: line + 1, text: text + content.slice(end, breakEnd) };
+};
+
+/**
+ * Wendet Hunks (aufsteigend, auf die Zeilen von content bezogen) auf einen Text an
+ */
+export const applyLineHunks = (content: string, hunks: LineHunk[]): string => {
+  const starts = lineStarts(content);
+  const parts: string[] = [];
+  let pos = 0;
+  for (const hunk of hunks) {
+    parts.push(content.slice(pos, starts[hunk.start]), hunk.text);
+    pos = starts[hunk.end];
+  }
+  parts.push(content.slice(pos));
+  return parts.join('');
+};
+
+/**
+ * Bisheriger Text jedes Hunks (die Zeilen [start, end) von content)
+ */
+export const getHunkBaseTexts = (content: string, hunks: LineHunk[]): string[] => {
+  const starts = lineStarts(content);
+  return hunks.map(hunk => content.slice(starts[hunk.start], starts[hunk.end]));
+};
@@ -0,0 +1,427 @@
+/**
+ * Vergabe freier IDs für Define-Header
+ *
+ * Belegte IDs werden als disjunkte, zusammengefasste Intervalle in einem Treap
+ * gehalten. Jeder Knoten kennt die größte freie Lücke in seinem Teilbaum, so dass
+ * "nächster freier Bereich der Länge N" und "N freie IDs im Block X" in
+ * logarithmischer Zeit (pro gefundenem Bereich) beantwortet werden.
+ * Reservierungen laufen über Transaktionen und können komplett zurückgerollt werden;
+ * solange eine Transaktion offen ist, gibt release() ihre IDs nicht frei.
+ */
+import { type DefinePrefix, getLexedDefineHeader } from './defineLexer';
+
+interface IntervalNode {
+  start: number;
+  end: number;
+  priority: number;
+  left: IntervalNode | null;
+  right: IntervalNode | null;
+  // Augmentierung über den Teilbaum
+  minStart: number;
+  maxEnd: number;
+  maxGap: number;
+}
+
+export interface IdRange {
+  start: number;
+  end: number;
+}
+
+const createNode = (start: number, end: number): IntervalNode => ({
+  start,
+  end,
+  priority: Math.random(),
+  left: null,
+  right: null,
+  minStart: start,
+  maxEnd: end,
+  maxGap: 0
+});
+
+const update = (node: IntervalNode): IntervalNode => {
+  const { left, right } = node;
+  let maxGap = 0;
+
+  if (left) {
+    maxGap = Math.max(left.maxGap, node.start - left.maxEnd - 1);
+    node.minStart = left.minStart;
+  } else {
+    node.minStart = node.start;
+  }
+
+  if (right) {
+    maxGap = Math.max(maxGap, right.maxGap, right.minStart - node.end - 1);
+    node.maxEnd = right.maxEnd;
+  } else {
+    node.maxEnd = node.end;
+  }
+
+  node.maxGap = maxGap;
+  return node;
+};
+
+const merge = (a: IntervalNode | null, b: IntervalNode | null): IntervalNode | null => {
+  if (!a) return b;
+  if (!b) return a;
+  if (a.priority > b.priority) {
+    a.right = merge(a.right, b);
+    return update(a);
+  }
+  b.left = merge(a, b.left);
+  return update(b);
+};
+
+// Teilt in Intervalle mit start < key und start >= key
+const split = (node: IntervalNode | null, key: number): [IntervalNode | null, IntervalNode | null] => {
+  if (!node) return [null, null];
+  if (node.start < key) {
+    const [left, right] = split(node.right, key);
+    node.right = left;
+    return [update(node), right];
+  }
+  const [left, right] = split(node.left, key);
+  node.left = right;
+  return [left, update(node)];
+};
+
+// Entfernt das Intervall mit dem größten Start und liefert [Rest, Intervall]
+const popMax = (node: IntervalNode): [IntervalNode | null, IntervalNode] => {
+  if (!node.right) {
+    const rest = node.left;
+    node.left = null;
+    return [rest, update(node)];
+  }
+  const [rest, max] = popMax(node.right);
+  node.right = rest;
+  return [update(node), max];
+};
+
+export class IdAllocator {
+  private root: IntervalNode | null = null;
+  // Offene Transaktionen; ihre Reservierungen überstehen release() und reset()
+  private readonly openTransactions = new Set<IdTransaction>();
+  readonly minId: number;
+  readonly maxId: number;
+
+  constructor(usedIds: Iterable<number> = [], minId = 1, maxId = 0x7fffffff) {
+    this.minId = minId;
+    this.maxId = maxId;
+    this.fill(usedIds);
+  }
+
+  /**
+   * Ersetzt alle belegten IDs (z.B. nach dem Neuladen eines Headers); IDs offener
+   * Reservierungen bleiben belegt
+   */
+  reset(usedIds: Iterable<number>): void {
+    this.root = null;
+    this.fill(usedIds);
+    this.openTransactions.forEach(transaction =>
+      transaction.getReserved().forEach(range => this.markUsed(range.start, range.end))
+    );
+  }
+
+  private fill(usedIds: Iterable<number>): void {
+    // Sortiert einfügen und benachbarte IDs direkt zu Intervallen zusammenfassen
+    const sorted = Array.from(usedIds).sort((a, b) => a - b);
+    let runStart = -1;
+    let runEnd = -2;
+    for (const id of sorted) {
+      if (id === runEnd || id === runEnd + 1) {
+        runEnd = id;
+        continue;
+      }
+      if (runStart !== -1) this.markUsed(runStart, runEnd);
+      runStart = id;
+      runEnd = id;
+    }
+    if (runStart !== -1) this.markUsed(runStart, runEnd);
+  }
+
+  /**
+   * Markiert einen Bereich als belegt (überlappende und angrenzende Intervalle werden verschmolzen)
+   */
+  markUsed(start: number, end: number = start): void {
+    const [head, rest] = split(this.root, start);
+    let before = head;
+    // Intervalle, die im Bereich beginnen oder direkt an ihn angrenzen, gehen im neuen Intervall auf
+    const [absorbed, after] = split(rest, end + 2);
+
+    let mergedStart = start;
+    let mergedEnd = Math.max(end, absorbed ? absorbed.maxEnd : end);
+
+    if (before && before.maxEnd >= start - 1) {
+      const [remaining, last] = popMax(before);
+      before = remaining;
+      mergedStart = Math.min(mergedStart, last.start);
+      mergedEnd = Math.max(mergedEnd, last.end);
+    }
+
+    this.root = merge(merge(before, createNode(mergedStart, mergedEnd)), after);
+  }
+
+  /**
+   * Gibt einen belegten Bereich wieder frei; IDs, die eine offene Transaktion reserviert hat,
+   * bleiben belegt
+   */
+  release(start: number, end: number = start): void {
+    const held: IdRange[] = [];
+    this.openTransactions.forEach(transaction =>
+      transaction.getReserved().forEach(range => {
+        if (range.start <= end && range.end >= start) held.push(range);
+      })
+    );
+    held.sort((a, b) => a.start - b.start);
+
+    let from = start;
+    for (const range of held) {
+      if (range.start > from) this.releaseRange(from, range.start - 1);
+      from = Math.max(from, range.end + 1);
+    }
+    if (from <= end) this.releaseRange(from, end);
+  }
+
+  /**
+   * true, wenn eine offene Transaktion die ID reserviert hat
+   */
+  isReserved(id: number): boolean {
+    for (const transaction of this.openTransactions) {
+      if (transaction.getReserved().some(range => id >= range.start && id <= range.end)) return true;
+    }
+    return false;
+  }
+
+  private releaseRange(start: number, end: number): void {
+    for (let id = start; id <= end;) {
+      const [before, after] = split(this.root, id + 1);
+      if (!before || before.maxEnd < id) {
+        // id ist nicht belegt - zum nächsten belegten Intervall springen
+        this.root = merge(before, after);
+        const next = this.nextUsed(id);
+        if (next === null || next > end) return;
+        id = next;
+        continue;
+      }
+
+      const [remaining, node] = popMax(before);
+      let tree = remaining;
+      if (node.start < id) tree = merge(tree, createNode(node.start, id - 1));
+      const releasedEnd = Math.min(node.end, end);
+      if (node.end > releasedEnd) tree = merge(tree, createNode(releasedEnd + 1, node.end));
+
+      this.root = merge(tree, after);
+      id = releasedEnd + 1;
+    }
+  }
+
+  isUsed(id: number): boolean {
+    let node = this.root;
+    while (node) {
+      if (id < node.start) {
+        node = node.left;
+      } else if (id > node.end) {
+        node = node.right;
+      } else {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Kleinster belegter Wert >= id oder null
+   */
+  nextUsed(id: number): number | null {
+    let node = this.root;
+    let result: number | null = null;
+    while (node) {
+      if (node.end < id) {
+        node = node.right;
+      } else {
+        result = node.start >= id ? node.start : id;
+        if (node.start <= id) return id;
+        node = node.left;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Sucht den ersten zusammenhängenden freien Bereich der Länge length ab from
+   * @returns Start des Bereichs oder null, wenn im erlaubten ID-Raum keiner existiert
+   */
+  findFreeRun(length: number, from: number = this.minId): number | null {
+    if (length <= 0) return null;
+    const lowerBound = Math.max(from, this.minId);
+
+    const tryGap = (gapStart: number, gapEnd: number): number | null => {
+      const start = Math.max(gapStart, lowerBound);
+      const end = Math.min(gapEnd, this.maxId);
+      return end - start + 1 >= length ? start : null;
+    };
+
+    const search = (node: IntervalNode | null, previousEnd: number): number | null => {
+      if (!node || node.maxEnd < lowerBound) return null;
+
+      const leading = tryGap(previousEnd + 1, node.minStart - 1);
+      if (leading !== null) return leading;
+      if (node.maxGap < length) return null;
+
+      const inLeft = search(node.left, previousEnd);
+      if (inLeft !== null) return inLeft;
+
+      if (node.left) {
+        const beforeNode = tryGap(node.left.maxEnd + 1, node.start - 1);
+        if (beforeNode !== null) return beforeNode;
+      }
+
+      return search(node.right, node.end);
+    };
+
+    if (!this.root) return tryGap(this.minId, this.maxId);
+
+    const found = search(this.root, this.minId - 1);
+    if (found !== null) return found;
+
+    // Lücke nach dem letzten Intervall
+    return tryGap(this.root.maxEnd + 1, this.maxId);
+  }
+
+  /**
+   * Sammelt count freie IDs innerhalb eines Blocks (nicht zwingend zusammenhängend)
+   * @returns Die freien Bereiche oder null, wenn der Block nicht genug freie IDs hat
+   */
+  findFreeIds(count: number, block: IdRange = { start: this.minId, end: this.maxId }): IdRange[] | null {
+    const ranges: IdRange[] = [];
+    let remaining = count;
+    let cursor = Math.max(block.start, this.minId);
+    const blockEnd = Math.min(block.end, this.maxId);
+
+    while (remaining > 0 && cursor <= blockEnd) {
+      const free = this.findFreeRun(1, cursor);
+      if (free === null || free > blockEnd) break;
+
+      const nextUsed = this.nextUsed(free);
+      const runEnd = Math.min(nextUsed === null ? blockEnd : nextUsed - 1, blockEnd, free + remaining - 1);
+      ranges.push({ start: free, end: runEnd });
+      remaining -= runEnd - free + 1;
+      cursor = runEnd + 1;
+    }
+
+    return remaining === 0 ? ranges : null;
+  }
+
+  /**
+   * Alle belegten Intervalle in aufsteigender Reihenfolge
+   */
+  getUsedRanges(): IdRange[] {
+    const ranges: IdRange[] = [];
+    const visit = (node: IntervalNode | null) => {
+      if (!node) return;
+      visit(node.left);
+      ranges.push({ start: node.start, end: node.end });
+      visit(node.right);
+    };
+    visit(this.root);
+    return ranges;
+  }
+
+  /**
+   * Startet eine Reservierung; reservierte IDs gelten sofort als belegt
+   */
+  begin(): IdTransaction {
+    const transaction = new IdTransaction(this, () => this.openTransactions.delete(transaction));
+    this.openTransactions.add(transaction);
+    return transaction;
+  }
+}
+
+export class IdTransaction {
+  private readonly allocator: IdAllocator;
+  private readonly onFinish: () => void;
+  private reserved: IdRange[] = [];
+  private finished = false;
+
+  constructor(allocator: IdAllocator, onFinish: () => void) {
+    this.allocator = allocator;
+    this.onFinish = onFinish;
+  }
+
+  /**
+   * Reserviert count IDs innerhalb eines Blocks
+   * @returns Die reservierten IDs in aufsteigender Reihenfolge oder null
+   */
+  reserve(count: number, block?: IdRange): number[] | null {
+    this.ensureOpen();
+    const ranges = this.allocator.findFreeIds(count, block);
+    if (!ranges) return null;
+
+    const ids: number[] = [];
+    ranges.forEach(range => {
+      this.allocator.markUsed(range.start, range.end);
+      this.reserved.push(range);
+      for (let id = range.start; id <= range.end; id++) ids.push(id);
+    });
+    return ids;
+  }
+
+  /**
+   * Reserviert einen zusammenhängenden Bereich der Länge length
+   */
+  reserveRun(length: number, from?: number): IdRange | null {
+    this.ensureOpen();
+    const start = this.allocator.findFreeRun(length, from);
+    if (start === null) return null;
+
+    const range = { start, end: start + length - 1 };
+    this.allocator.markUsed(range.start, range.end);
+    this.reserved.push(range);
+    return range;
+  }
+
+  getReserved(): IdRange[] {
+    return [...this.reserved];
+  }
+
+  /**
+   * Übernimmt die Reservierungen endgültig
+   */
+  commit(): void {
+    this.ensureOpen();
+    this.finished = true;
+    this.onFinish();
+  }
+
+  /**
+   * Gibt alle in dieser Transaktion reservierten IDs wieder frei
+   */
+  rollback(): void {
+    this.ensureOpen();
+    // Erst schließen, sonst schützt die eigene Reservierung die IDs vor release()
+    this.finished = true;
+    this.onFinish();
+    this.reserved.forEach(range => this.allocator.release(range.start, range.end));
+    this.reserved = [];
+  }
+
+  private ensureOpen(): void {
+    if (this.finished) {
+      throw new Error('ID-Reservierung wurde bereits abgeschlossen');
+    }
+  }
+}
+
+/**
+ * Liest alle belegten IDs der angegebenen Präfixe aus einem oder mehreren Define-Headern
+ */
+export const collectUsedIds = (contents: string[], prefixes: DefinePrefix[]): number[] => {
+  const ids: number[] = [];
+  contents.forEach(content => {
+    if (!content) return;
+    const header = getLexedDefineHeader(content);
+    prefixes.forEach(prefix => {
+      header.tables[prefix].forEach(entry => ids.push(entry.value));
+    });
+  });
+  return ids;
+};
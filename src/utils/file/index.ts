@@ -25,3 +25,4 @@ export * from './mdlDynaParser';
 export * from './parseUtils';
 export * from './resourceLoader';
 export * from './propItemUtils';
+export * from './changeJournal';
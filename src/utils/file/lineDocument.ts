@@ -0,0 +1,126 @@
+/**
+ * Zeilenbasierte Piece-Table für große Textdateien (z.B. defineItem.h)
+ *
+ * Der Originalinhalt bleibt unverändert im Speicher, geänderte Zeilen liegen in
+ * einem separaten Puffer. Eine Zeilenänderung kostet daher keine Kopie der Datei;
+ * der vollständige Text wird erst beim Speichern einmal zusammengesetzt.
+ */
+
+export class LineDocument {
+  private readonly original: string;
+  // Startoffset jeder Zeile im Original, plus Endoffset als letzter Eintrag
+  private readonly lineStarts: Uint32Array;
+  // Geänderte Zeilen (ohne Zeilenende), nach Zeilennummer
+  private readonly edits = new Map<number, string>();
+  private cachedText: string | null;
+
+  constructor(content: string) {
+    this.original = content;
+    this.cachedText = content;
+
+    let lineCount = 1;
+    for (let i = content.indexOf('\n'); i !== -1; i = content.indexOf('\n', i + 1)) {
+      lineCount++;
+    }
+
+    const lineStarts = new Uint32Array(lineCount + 1);
+    let line = 1;
+    for (let i = content.indexOf('\n'); i !== -1; i = content.indexOf('\n', i + 1)) {
+      lineStarts[line++] = i + 1;
+    }
+    lineStarts[lineCount] = content.length;
+    this.lineStarts = lineStarts;
+  }
+
+  get lineCount(): number {
+    return this.lineStarts.length - 1;
+  }
+
+  get editCount(): number {
+    return this.edits.size;
+  }
+
+  isModified(): boolean {
+    return this.edits.size > 0;
+  }
+
+  /**
+   * Liefert eine Zeile (0-basiert) ohne Zeilenende
+   */
+  getLine(line: number): string {
+    const edited = this.edits.get(line);
+    if (edited !== undefined) return edited;
+
+    const start = this.lineStarts[line];
+    return this.original.substring(start, start + this.contentLength(line));
+  }
+
+  /**
+   * Ersetzt den Inhalt einer Zeile; das ursprüngliche Zeilenende bleibt erhalten
+   */
+  setLine(line: number, text: string): void {
+    if (line < 0 || line >= this.lineCount) {
+      throw new RangeError(`Zeile ${line} liegt außerhalb des Dokuments (${this.lineCount} Zeilen)`);
+    }
+
+    const start = this.lineStarts[line];
+    if (text === this.original.substring(start, start + this.contentLength(line))) {
+      this.edits.delete(line);
+    } else {
+      this.edits.set(line, text);
+    }
+    this.cachedText = null;
+  }
+
+  /**
+   * Ermittelt die Zeile zu einem Offset im Originalinhalt (Binärsuche)
+   */
+  lineAtOffset(offset: number): number {
+    let low = 0;
+    let high = this.lineCount - 1;
+
+    while (low < high) {
+      const mid = (low + high + 1) >>> 1;
+      if (this.lineStarts[mid] <= offset) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+
+    return low;
+  }
+
+  /**
+   * Setzt den vollständigen Text aus Original- und Änderungspuffer zusammen.
+   * Das Ergebnis wird bis zur nächsten Änderung zwischengespeichert.
+   */
+  toString(): string {
+    if (this.cachedText !== null) return this.cachedText;
+
+    const editedLines = Array.from(this.edits.keys()).sort((a, b) => a - b);
+    const pieces: string[] = [];
+    let position = 0;
+
+    editedLines.forEach(line => {
+      const start = this.lineStarts[line];
+      const end = start + this.contentLength(line);
+      pieces.push(this.original.substring(position, start), this.edits.get(line)!);
+      position = end;
+    });
+    pieces.push(this.original.substring(position));
+
+    this.cachedText = pieces.join('');
+    return this.cachedText;
+  }
+
+  // Länge einer Originalzeile ohne \n bzw. \r\n
+  private contentLength(line: number): number {
+    const start = this.lineStarts[line];
+    let end = this.lineStarts[line + 1];
+
+    if (end > start && this.original.charCodeAt(end - 1) === 10) end--;
+    if (end > start && this.original.charCodeAt(end - 1) === 13) end--;
+    return end - start;
+  }
+}
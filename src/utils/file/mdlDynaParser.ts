@@ -1,5 +1,9 @@
 import { toast } from "sonner";
-import { trackModifiedFile } from "./fileOperations";
+import { recordChange } from "./changeJournal";
+import { createInternScope } from "./stringPool";
+import { loadResourceFile } from "./resourceStream";
+import { type LineHunk } from "./filePatch";
+import { traceBegin, traceEnd, traceSync } from "../trace";
 
 // Interface for storing model file mappings
 interface ModelFileMapping {
@@ -18,6 +22,34 @@ let modelNameMappings: ModelNameMapping = {};
 // Store the original file content so we can modify it correctly
 let originalMdlDynaContent = "";
 
+// Parse a single item line of mdlDyna.inc ("Name" II_ITEM_ID ... MODELTYPE_MESH "model")
+const parseMdlDynaLine = (line: string): { itemDefine: string; fileName: string; modelName?: string } | null => {
+  line = line.replace(/\r/g, '').replace(/\u0000/g, '').trim();
+  
+  // Skip empty lines or comments or lines without item definitions
+  if (!line || line.startsWith('//') || !line.includes('II_')) {
+    return null;
+  }
+  
+  // Regex für Items: "Name" II_ITEM_ID
+  // Das Capture-Group-Pattern erfasst den Namen in Anführungszeichen und die Item-ID
+  const itemMatch = /"([^"]+)"\s+(II_[A-Z0-9_]+)/.exec(line);
+  if (!itemMatch) return null;
+  
+  const itemDefine = itemMatch[2].trim();
+  const entry: { itemDefine: string; fileName: string; modelName?: string } = { itemDefine, fileName: itemMatch[1].trim() };
+  
+  // If this is an armor item, also extract the model name
+  if (itemDefine.startsWith('II_ARM_') && line.includes('MODELTYPE_MESH')) {
+    const modelNameMatch = /MODELTYPE_MESH\s+"([^"]*)"/.exec(line);
+    if (modelNameMatch && modelNameMatch[1] && modelNameMatch[1] !== '""') {
+      entry.modelName = modelNameMatch[1].trim();
+    }
+  }
+  
+  return entry;
+};
+
 // Parse mdlDyna.inc file content
 export const parseMdlDynaFile = (content: string): void => {
   // Store the original content
@@ -27,6 +59,7 @@ export const parseMdlDynaFile = (content: string): void => {
     
     // Store the mappings
     const mappings: ModelFileMapping = {};
+    const internScope = createInternScope("mdlDyna.inc");
     const modelNameMaps: ModelNameMapping = {};
     
     // Normalize content by removing carriage returns and unusual characters
@@ -54,34 +87,23 @@ export const parseMdlDynaFile = (content: string): void => {
     for (let line of contentLines) {
       line = line.trim();
       
-      // Skip empty lines or comments or lines without item definitions
-      if (!line || line.startsWith('//') || !line.includes('II_')) {
-        continue;
-      }
-      
       try {
-        // Regex für Items: "Name" II_ITEM_ID
-        // Das Capture-Group-Pattern erfasst den Namen in Anführungszeichen und die Item-ID
-        const itemRegex = /"([^"]+)"\s+(II_[A-Z0-9_]+)/;
-        const itemMatch = itemRegex.exec(line);
+        const entry = parseMdlDynaLine(line);
         
-        if (itemMatch) {
-          const fileName = itemMatch[1].trim();
-          const itemDefine = itemMatch[2].trim();
+        if (entry) {
+          const fileName = internScope.intern(entry.fileName);
+          const itemDefine = entry.itemDefine;
           
           // Store the filename mapping
           mappings[itemDefine] = fileName;
           
-          // If this is an armor item, also extract the model name
-          if (itemDefine.startsWith('II_ARM_') && line.includes('MODELTYPE_MESH')) {
-            const modelNameMatch = /MODELTYPE_MESH\s+"([^"]*)"/.exec(line);
-            if (modelNameMatch && modelNameMatch[1] && modelNameMatch[1] !== '""') {
-              const modelName = modelNameMatch[1].trim();
-              modelNameMaps[itemDefine] = modelName;
-              
-              if (count < 5) {
-                console.log(`Found armor model name for ${itemDefine}: "${modelName}" (file: ${fileName})`);
-              }
+          // If this is an armor item, also store the model name
+          if (entry.modelName) {
+            const modelName = internScope.intern(entry.modelName);
+            modelNameMaps[itemDefine] = modelName;
+            
+            if (count < 5) {
+              console.log(`Found armor model name for ${itemDefine}: "${modelName}" (file: ${fileName})`);
             }
           }
           
@@ -136,6 +158,8 @@ export const parseMdlDynaFile = (content: string): void => {
     console.log('II_ARM_M_VAG_BOOTS01 filename:', mappings['II_ARM_M_VAG_BOOTS01'] || 'NOT FOUND');
     console.log('II_ARM_M_VAG_BOOTS01 model name:', modelNameMaps['II_ARM_M_VAG_BOOTS01'] || 'NOT FOUND');
     
+    internScope.finish();
+    
     // Store in global cache
     modelFileMappings = mappings;
     modelNameMappings = modelNameMaps;
@@ -152,6 +176,37 @@ export const parseMdlDynaFile = (content: string): void => {
   }
 };
 
+// Apply externally changed line ranges of mdlDyna.inc: only the lines in the ranges are parsed again
+// @param baseTexts Previous text of each hunk (same order as hunks)
+// @returns The changed item defines, or null if the file has to be parsed again completely
+export const applyMdlDynaDelta = (content: string, hunks: LineHunk[], baseTexts: string[]): string[] | null => {
+  if (!originalMdlDynaContent) return null;
+  
+  // Lines up to the first "{" are the header and are not parsed
+  const headerEnd = originalMdlDynaContent.split('\n').findIndex(line => line.includes('{')) + 1;
+  if (hunks.some(hunk => hunk.start < headerEnd)) return null;
+  
+  const changed = new Set<string>();
+  baseTexts.forEach(text => text.split('\n').forEach(line => {
+    const entry = parseMdlDynaLine(line);
+    if (!entry) return;
+    delete modelFileMappings[entry.itemDefine];
+    delete modelNameMappings[entry.itemDefine];
+    changed.add(entry.itemDefine);
+  }));
+  hunks.forEach(hunk => hunk.text.split('\n').forEach(line => {
+    const entry = parseMdlDynaLine(line);
+    if (!entry) return;
+    modelFileMappings[entry.itemDefine] = entry.fileName;
+    if (entry.modelName) modelNameMappings[entry.itemDefine] = entry.modelName;
+    changed.add(entry.itemDefine);
+  }));
+  
+  originalMdlDynaContent = content;
+  console.log(`mdlDyna.inc: ${hunks.length} changed ranges applied, ${changed.size} items updated`);
+  return Array.from(changed);
+};
+
 // Get model filename from item define
 export const getModelFileNameFromDefine = (defineName: string): string => {
   if (!defineName) return '';
@@ -229,6 +284,11 @@ export const getModelNameMappings = (): ModelNameMapping => {
   return modelNameMappings;
 };
 
+// Current content of mdlDyna.inc including unsaved model changes (line endings as loaded)
+export const getMdlDynaContent = (): string => {
+  return originalMdlDynaContent;
+};
+
 // Update a model filename in the mdlDyna.inc file
 export const updateModelFileNameInMdlDyna = (defineName: string, newFileName: string): boolean => {
   if (!defineName || !newFileName || !originalMdlDynaContent) {
@@ -263,6 +323,7 @@ export const updateModelFileNameInMdlDyna = (defineName: string, newFileName: st
     
     const oldLine = lines[lineIndex];
     let newLine;
+    let oldFileName;
     
     if (isArmor) {
       // For armor items, update the model name (after MODELTYPE_MESH)
@@ -280,6 +341,8 @@ export const updateModelFileNameInMdlDyna = (defineName: string, newFileName: st
         `MODELTYPE_MESH "${newFileName}"`
       );
       
+      oldFileName = modelNameMatch[1];
+      
       // Update our mappings
       modelNameMappings[cleanDefineName] = newFileName;
       
@@ -300,6 +363,8 @@ export const updateModelFileNameInMdlDyna = (defineName: string, newFileName: st
         `"${newFileName}"`
       );
       
+      oldFileName = fileNameMatch[1];
+      
       // Update our mappings
       modelFileMappings[cleanDefineName] = newFileName;
       
@@ -318,8 +383,8 @@ export const updateModelFileNameInMdlDyna = (defineName: string, newFileName: st
       return false;
     }
     
-    // Track the modified file to be saved
-    trackModifiedFile("mdlDyna.inc", updatedContent);
+    // Track the changed field; the content itself stays here until it is saved (getMdlDynaContent)
+    recordChange("mdlDyna.inc", cleanDefineName, isArmor ? "modelName" : "fileName", oldFileName, newFileName);
     console.log(`mdlDyna.inc modified for ${cleanDefineName}`);
     
     // Update our original content to reflect the changes
@@ -334,6 +399,7 @@ export const updateModelFileNameInMdlDyna = (defineName: string, newFileName: st
 
 // Function to load mdlDyna.inc from public folder
 export const loadMdlDynaFile = async (): Promise<void> => {
+  const span = traceBegin("loadMdlDynaFile", "load");
   try {
     console.log("Loading mdlDyna.inc file from public folder...");
     
@@ -348,6 +414,7 @@ export const loadMdlDynaFile = async (): Promise<void> => {
     
     let content = null;
     let loadedPath = null;
+    const fetchSpan = traceBegin("mdlDyna.inc", "fetch");
     
     // Versuche alle Pfade nacheinander
     for (const path of paths) {
@@ -373,11 +440,11 @@ export const loadMdlDynaFile = async (): Promise<void> => {
       if ((window as any).electronAPI) {
         try {
           console.log("Versuche Laden über Electron API");
-          const result = await (window as any).electronAPI.loadAllFiles();
+          const fileContent = await loadResourceFile("mdlDyna.inc");
           
-          if (result.success && result.files && result.files["mdlDyna.inc"]) {
+          if (fileContent) {
             console.log("mdlDyna.inc über Electron API geladen");
-            content = result.files["mdlDyna.inc"];
+            content = fileContent;
             loadedPath = "electron-api";
           }
         } catch (electronError) {
@@ -386,16 +453,20 @@ export const loadMdlDynaFile = async (): Promise<void> => {
       }
     }
     
+    traceEnd(fetchSpan, { source: loadedPath });
+    
     if (!content) {
       throw new Error(`Konnte mdlDyna.inc über keinen Pfad laden`);
     }
     
     console.log(`mdlDyna.inc erfolgreich von ${loadedPath} geladen, Inhaltslänge:`, content.length);
     
-    parseMdlDynaFile(content);
+    traceSync("mdlDyna.inc", "parse", () => parseMdlDynaFile(content));
   } catch (error) {
     console.error("Error loading mdlDyna.inc file:", error);
     toast.error("Fehler beim Laden der mdlDyna.inc-Datei");
+  } finally {
+    traceEnd(span);
   }
 };
 
@@ -0,0 +1,112 @@
+/**
+ * Parse-Cache für Spec_item.txt
+ *
+ * Ersetzt den früheren localStorage-Cache (JSON, ~5 MB Quota, 24h-Ablauf). Die geparsten
+ * Daten werden unter Electron in userData abgelegt (public/main/parseCache.cjs):
+ *  - Schlüssel: SHA-1 von Spec_item.txt und propItem.txt.txt (die Anzeigenamen stammen
+ *    daraus) plus Parser-Version; ein Eintrag gilt genau so lange, wie beide Inhalte gleich sind
+ *  - Inhalt: der Spaltenspeicher als Snapshot (Typed Arrays) und die Items ohne ihre
+ *    Datenobjekte; beim Laden werden die Zeilensichten wieder angelegt
+ * Im Browser gibt es keinen Cache.
+ */
+import { FileData, ResourceItem } from "../../types/fileTypes";
+import { ColumnStore, type ColumnStoreSnapshot, getRowViewTarget } from "./columnStore";
+import { computeContentHash } from "./contentHash";
+
+// Bei Änderungen am Spec_item-Parser oder am Aufbau der Einträge erhöhen
+const SPEC_ITEM_PARSER_VERSION = "specItem-1";
+
+// Item ohne Datenobjekt: row verweist in den Spaltenspeicher, sonst liegt data direkt bei
+type CachedItem = Omit<ResourceItem, 'data'> & { row?: number; data?: ResourceItem['data'] };
+
+interface SpecItemCacheEntry {
+  header: string[];
+  items: CachedItem[];
+  columns: ColumnStoreSnapshot | null;
+}
+
+export const isParseCacheAvailable = (): boolean =>
+  typeof window !== 'undefined' && !!window.electronAPI?.readParseCache;
+
+/**
+ * Schlüssel für den Cache-Eintrag einer Spec_item.txt
+ * @param propItemContent Inhalt von propItem.txt.txt, falls beim Parsen verwendet
+ */
+export const getSpecItemCacheKey = async (content: string, propItemContent?: string | null): Promise<string> => {
+  const [contentHash, propItemHash] = await Promise.all([
+    computeContentHash(content),
+    propItemContent ? computeContentHash(propItemContent) : Promise.resolve('none')
+  ]);
+  return `spec-${contentHash}-${propItemHash.substring(0, 16)}-${SPEC_ITEM_PARSER_VERSION}`;
+};
+
+const toCacheEntry = (data: FileData): SpecItemCacheEntry => {
+  // Alle Items eines Parse-Durchlaufs teilen sich einen Speicher
+  const firstView = data.items.find(item => getRowViewTarget(item.data));
+  const store = firstView ? getRowViewTarget(firstView.data)!.store : null;
+
+  const items = data.items.map(item => {
+    const { data: itemData, ...rest } = item;
+    const target = getRowViewTarget(itemData);
+    if (target && target.store === store) {
+      return { ...rest, row: target.row };
+    }
+    return { ...rest, data: { ...itemData } };
+  });
+
+  return { header: data.header, items, columns: store ? store.toSnapshot().snapshot : null };
+};
+
+const fromCacheEntry = (entry: SpecItemCacheEntry): FileData => {
+  const store = entry.columns ? ColumnStore.fromSnapshot(entry.columns) : null;
+
+  const items: ResourceItem[] = entry.items.map(cached => {
+    const { row, ...item } = cached;
+    return {
+      ...item,
+      data: row !== undefined && store ? store.rowView(row) : (item.data || {})
+    } as ResourceItem;
+  });
+
+  return { header: entry.header, items };
+};
+
+/**
+ * Liest geparste Daten aus dem Cache
+ * @returns Die Daten oder null, wenn es keinen Eintrag gibt
+ */
+export const loadSpecItemCache = async (key: string): Promise<FileData | null> => {
+  if (!isParseCacheAvailable()) return null;
+
+  try {
+    const startTime = performance.now();
+    const result = await window.electronAPI!.readParseCache!(key);
+    if (!result.success || !result.hit || !result.data) {
+      if (!result.success) console.warn("Parse-Cache konnte nicht gelesen werden:", result.error);
+      return null;
+    }
+
+    const data = fromCacheEntry(result.data as SpecItemCacheEntry);
+    console.log(`Parse-Cache-Treffer: ${data.items.length} Items in ${(performance.now() - startTime).toFixed(0)}ms`);
+    return data;
+  } catch (error) {
+    console.warn("Fehler beim Lesen des Parse-Caches:", error);
+    return null;
+  }
+};
+
+/**
+ * Legt geparste Daten im Cache ab (im Hintergrund, Fehler werden nur protokolliert)
+ */
+export const saveSpecItemCache = async (key: string, data: FileData): Promise<void> => {
+  if (!isParseCacheAvailable()) return;
+
+  try {
+    const result = await window.electronAPI!.writeParseCache!(key, toCacheEntry(data));
+    if (!result.success) {
+      console.warn("Parse-Cache konnte nicht geschrieben werden:", result.error);
+    }
+  } catch (error) {
+    console.warn("Fehler beim Schreiben des Parse-Caches:", error);
+  }
+};
@@ -1,4 +1,12 @@
 import { FileData, ResourceItem, ItemData, EffectData } from "../../types/fileTypes";
+import { ColumnStore, getRowViewSchema } from "./columnStore";
+import { type SpecItemSchema, getEffectSlots, getSpecItemSchema } from "./specItemSchema";
+import { createInternScope } from "./stringPool";
+import { type TabTable, scanTabSeparated } from "./tabScanner";
+import { traceBegin, traceEnd, traceSync } from "../trace";
+import { getSpecItemRowIndex } from "./specItemRowIndex";
+
+const textEncoder = new TextEncoder();
 
 // Interface for propItem data mapping
 interface PropItemMapping {
@@ -29,6 +37,47 @@ export const setDefineItemEffectMappings = (mappings: { [key: string]: EffectDat
   console.log(`DefineItem-Effect-Mappings gesetzt mit ${Object.keys(mappings).length} Einträgen`);
 };
 
+// Rohdaten einer geladenen Datei: vom Parser-Prozess bereits gescannt (parserService.loadScannedFile)
+// oder vom Loader mitgeliefert (resourceLoader.ts). Das nächste parseFileContent desselben Inhalts
+// parst dann diese Bytes, statt den Text neu zu kodieren (und ggf. zu scannen)
+let prescanned: { content: string; bytes: Uint8Array; encoding: string; table?: TabTable } | null = null;
+
+const stripBom = (data: string): string => data.charCodeAt(0) === 0xFEFF ? data.slice(1) : data;
+
+/**
+ * Merkt eine bereits gescannte Datei für das folgende parseFileContent vor
+ * @param bytes Inhalt als UTF-8 (ohne BOM); table enthält die Datenzeilen ab der Zeile nach der Kopfzeile
+ */
+export const setPrescannedTable = (content: string, bytes: Uint8Array, table: TabTable): void => {
+  prescanned = { content: stripBom(content), bytes, encoding: 'utf-8', table };
+};
+
+/**
+ * Merkt die Rohdaten einer geladenen Datei für das folgende parseFileContent vor
+ * @param bytes Inhalt der Datei, wie er auf der Platte steht (BOM erlaubt)
+ * @param encoding Kodierung der Bytes; UTF-16 lässt sich nicht auf Bytes scannen und wird ignoriert
+ */
+export const setPrescannedBytes = (content: string, bytes: Uint8Array, encoding: string): void => {
+  if (/^utf-?16/i.test(encoding)) return;
+  prescanned = { content: stripBom(content), bytes, encoding };
+};
+
+/**
+ * Liegt für diesen Inhalt eine vom Parser-Prozess gescannte Tabelle vor?
+ */
+export const hasPrescannedTable = (data: string): boolean =>
+  !!prescanned?.table && prescanned.content === stripBom(data);
+
+/**
+ * Übernimmt die vorgemerkten Rohdaten dieses Inhalts (z.B. für parseTextFileParallel)
+ */
+export const takePrescannedBytes = (data: string): { bytes: Uint8Array; encoding: string } | null => {
+  if (!prescanned || prescanned.table || prescanned.content !== stripBom(data)) return null;
+  const { bytes, encoding } = prescanned;
+  prescanned = null;
+  return { bytes, encoding };
+};
+
 /**
  * Parst eine txt- oder csv-Datei und gibt die extrahierten Daten zurück
  * @param data Der Inhalt der Datei
@@ -40,14 +89,26 @@ export const parseFileContent = (data: string): FileData => {
     return { header: [], items: [] };
   }
   
-  // Bestimme den Dateityp
-  const isTabSeparated = data.includes('\t');
-  const isCommaSeparated = data.includes(',');
-  
   // Entferne BOM (Byte Order Mark) falls vorhanden
-  let cleanedData = data;
-  if (data.charCodeAt(0) === 0xFEFF) {
-    cleanedData = data.slice(1);
+  const cleanedData = stripBom(data);
+  
+  const firstLine = readFirstLine(cleanedData);
+  
+  // Zeilenindex (dwID -> Zeile) für das Speichern gleich mit aufbauen, siehe specItemRowIndex.ts
+  if (isSpecItemHeader(firstLine)) {
+    traceSync("SpecItemRowIndex", "index", () => getSpecItemRowIndex(data));
+  }
+  
+  // Rohdaten vom Loader oder Parser-Prozess: direkt parsen, ohne den Text neu zu kodieren
+  if (prescanned?.content === cleanedData) {
+    const { bytes, encoding, table } = prescanned;
+    prescanned = null;
+    return table ? parseScannedBytes(bytes, encoding, table) : parseFileBytes(bytes, encoding);
+  }
+  
+  // Tab-getrennte Formate werden auf Bytes gescannt (tabScanner.ts), ohne die Datei in Zeilen zu teilen
+  if (isSpecItemHeader(firstLine) || (!firstLine.includes('IDS_PROPITEM_TXT_') && cleanedData.includes('\t'))) {
+    return parseScannedBytes(textEncoder.encode(cleanedData), 'utf-8');
   }
   
   // Teile den Inhalt in Zeilen auf
@@ -60,24 +121,66 @@ export const parseFileContent = (data: string): FileData => {
     return parsePropItemFormat(lines);
   }
   
-  // Prüfe, ob es sich um das Format aus einer Spec_item.txt handelt
-  const firstLine = lines[0];
-  if (firstLine && firstLine.includes('dwID') && firstLine.includes('szName')) {
-    return parseSpecItemFormat(lines);
-  }
-  
   // Fallback auf allgemeines Format
-  if (isTabSeparated) {
-    return parseTabSeparated(lines);
-  } else if (isCommaSeparated) {
+  if (cleanedData.includes(',')) {
     return parseCommaSeparated(lines);
   }
   
   // Wenn kein spezifisches Format erkannt wurde, als Tab-getrennt behandeln
   console.warn("Kein spezifisches Format erkannt, versuche Tab-getrenntes Format");
-  return parseTabSeparated(lines);
+  return parseScannedBytes(textEncoder.encode(cleanedData), 'utf-8');
+};
+
+/**
+ * Parst eine Datei direkt aus den Rohdaten
+ * Spec_item.txt und allgemeine tab-getrennte Dateien werden ohne vorheriges Dekodieren
+ * gescannt; alle anderen Formate gehen über parseFileContent.
+ * @param bytes Inhalt der Datei
+ * @param encoding Kodierung der Datei (für Zellen mit Nicht-ASCII-Zeichen)
+ */
+export const parseFileBytes = (bytes: Uint8Array, encoding: string = 'utf-8'): FileData => {
+  const bomLength = bytes[0] === 0xEF && bytes[1] === 0xBB && bytes[2] === 0xBF ? 3 : 0;
+  const firstLine = readFirstLineBytes(bytes, bomLength, encoding);
+  const isTabSeparated = bytes.indexOf(9, bomLength) !== -1;
+  
+  if (isSpecItemHeader(firstLine) || (isTabSeparated && !firstLine.includes('IDS_PROPITEM_TXT_'))) {
+    return parseScannedBytes(bytes, encoding);
+  }
+  
+  return parseFileContent(new TextDecoder(encoding).decode(bytes));
 };
 
+/**
+ * Scannt die Datenzeilen und parst sie als Spec_item.txt oder als allgemeines Tab-Format
+ * @param scanned Bereits gescannte Datenzeilen (Parser-Prozess); sonst wird hier gescannt
+ */
+const parseScannedBytes = (bytes: Uint8Array, encoding: string, scanned?: TabTable): FileData => {
+  const bomLength = bytes[0] === 0xEF && bytes[1] === 0xBB && bytes[2] === 0xBF ? 3 : 0;
+  const firstLine = readFirstLineBytes(bytes, bomLength, encoding);
+  const headerEnd = bytes.indexOf(10, bomLength);
+  
+  const table = scanned ?? traceSync("scanTabSeparated", "decode", () =>
+    scanTabSeparated(bytes, { start: headerEnd === -1 ? bytes.length : headerEnd + 1, encoding })
+  );
+  const header = firstLine.split("\t");
+  console.log(`Datei hat ${table.lineCount + 1} Zeilen, prüfe Format...`);
+  
+  return isSpecItemHeader(firstLine) ? parseSpecItemFormat(header, table) : parseTabSeparated(header, table);
+};
+
+const readFirstLineBytes = (bytes: Uint8Array, start: number, encoding: string): string => {
+  const lineEnd = bytes.indexOf(10, start);
+  return readFirstLine(new TextDecoder(encoding).decode(bytes.subarray(start, lineEnd === -1 ? bytes.length : lineEnd)));
+};
+
+const readFirstLine = (data: string): string => {
+  const lineEnd = data.indexOf('\n');
+  const firstLine = lineEnd === -1 ? data : data.substring(0, lineEnd);
+  return firstLine.endsWith('\r') ? firstLine.slice(0, -1) : firstLine;
+};
+
+export const isSpecItemHeader = (firstLine: string): boolean => firstLine.includes('dwID') && firstLine.includes('szName');
+
 /**
  * Extrahiert den Display-Namen aus einem propItem.txt.txt-Eintrag
  * @param id Die ID des propItem-Eintrags
@@ -109,20 +212,18 @@ export const getPropItemDescription = (id: string): string => {
 };
 
 /**
- * Extrahiert Effekte aus den Spalten dwDestParam1-6 und nAdjParamVal1-6
+ * Extrahiert Effekte aus den Spalten dwDestParamN und nAdjParamValN
  * @param data Die ItemData mit den dwDestParam und nAdjParamVal Spalten
+ * @param schema Schema der Datei (Standard: Schema der Zeilensicht, sonst die sechs Slots von ver6)
  * @returns Array von EffectData Objekten
  */
-export const extractEffectsFromData = (data: any): EffectData[] => {
+export const extractEffectsFromData = (data: any, schema: SpecItemSchema | null = getRowViewSchema(data)): EffectData[] => {
   if (!data) return [];
   
   const effects: EffectData[] = [];
   
-  // Extrahiere bis zu 6 Effekte aus den dwDestParam und nAdjParamVal Spalten
-  for (let i = 1; i <= 6; i++) {
-    const typeKey = `dwDestParam${i}`;
-    const valueKey = `nAdjParamVal${i}`;
-    
+  // Extrahiere die Effekte aus den Effekt-Spalten, die die Kopfzeile der Datei enthält
+  for (const { typeKey, valueKey } of getEffectSlots(schema)) {
     // Prüfe ob der Typ vorhanden und nicht '_NONE' ist
     if (data[typeKey] && data[typeKey] !== '_NONE' && data[typeKey] !== '=' && data[typeKey] !== '-') {
       effects.push({
@@ -148,6 +249,7 @@ function parsePropItemFormat(lines: string[]): FileData {
   
   const items: ResourceItem[] = [];
   const propItemMap: { [key: string]: { name: string; description: string } } = {};
+  const internScope = createInternScope("propItem.txt.txt");
   
   // Gruppiere die Einträge nach ID
   for (let i = 0; i < lines.length; i++) {
@@ -158,7 +260,7 @@ function parsePropItemFormat(lines: string[]): FileData {
     if (parts.length < 2) continue;
     
     const id = parts[0].trim();
-    const value = parts[1].trim();
+    const value = internScope.intern(parts[1].trim());
     
     if (id.startsWith('IDS_PROPITEM_TXT_')) {
       // Extrahiere die Basis-ID (Nummer ohne führende Nullen)
@@ -194,45 +296,41 @@ function parsePropItemFormat(lines: string[]): FileData {
     });
   });
   
+  internScope.finish();
   console.log(`Parsed ${items.length} items from propItem.txt.txt format`);
   return { header: ["ID", "Value"], items };
 }
 
 /**
  * Parst Daten im Tab-getrennten Format
+ * @param headerCells Ungetrimmte Zellen der Kopfzeile
+ * @param table Gescannte Datenzeilen (ab der zweiten Zeile)
  */
-function parseTabSeparated(lines: string[]): FileData {
+function parseTabSeparated(headerCells: string[], table: TabTable): FileData {
   console.log("Parsing generic tab-separated format");
   
-  if (lines.length === 0) {
-    return { header: [], items: [] };
-  }
+  const internScope = createInternScope("tab-separated");
   
   // Erste Zeile ist der Header
-  const header = lines[0].split('\t').map(h => h.trim());
+  const header = headerCells.map(h => internScope.intern(h.trim()));
   console.log(`Header columns: ${header.length}`);
   
   const items: ResourceItem[] = [];
+  table.setIntern(internScope.intern);
   
   // Verarbeite die Datenzeilen
-  for (let i = 1; i < lines.length; i++) {
-    const line = lines[i].trim();
-    if (!line) continue;
-    
-    const values = line.split('\t');
-        if (values.length < 1) continue;
-        
+  for (let row = 0; row < table.rowCount; row++) {
     const data: ItemData = {};
     
     // Weise Werte den Header-Spalten zu
-    for (let j = 0; j < Math.min(header.length, values.length); j++) {
+    const columnCount = Math.min(header.length, table.cellCount(row));
+    for (let j = 0; j < columnCount; j++) {
       const columnName = header[j];
-      const value = values[j].trim();
-      data[columnName] = value;
+      data[columnName] = table.getCell(row, j)!;
     }
     
-    // Versuche, ID und Name aus den Daten zu extrahieren
-    const id = data.id || data.ID || data.dwID || `item_${i}`;
+    // Versuche, ID und Name aus den Daten zu extrahieren (Zeilennummer inkl. Kopfzeile)
+    const id = data.id || data.ID || data.dwID || `item_${table.lineOf(row) + 1}`;
     const name = data.name || data.NAME || data.szName || id;
     
     items.push({
@@ -245,6 +343,8 @@ function parseTabSeparated(lines: string[]): FileData {
     });
   }
   
+  table.setIntern(null);
+  internScope.finish();
   console.log(`Parsed ${items.length} items from tab-separated format`);
   return { header, items };
 }
@@ -259,8 +359,10 @@ function parseCommaSeparated(lines: string[]): FileData {
     return { header: [], items: [] };
   }
   
+  const internScope = createInternScope("comma-separated");
+  
   // Erste Zeile ist der Header
-  const header = lines[0].split(',').map(h => h.trim());
+  const header = lines[0].split(',').map(h => internScope.intern(h.trim()));
   console.log(`Header columns: ${header.length}`);
   
   const items: ResourceItem[] = [];
@@ -279,7 +381,7 @@ function parseCommaSeparated(lines: string[]): FileData {
     // Weise Werte den Header-Spalten zu
     for (let j = 0; j < Math.min(header.length, values.length); j++) {
       const columnName = header[j];
-      const value = values[j].trim();
+      const value = internScope.intern(values[j].trim());
       data[columnName] = value;
     }
     
@@ -297,175 +399,170 @@ function parseCommaSeparated(lines: string[]): FileData {
     });
   }
   
+  internScope.finish();
   console.log(`Parsed ${items.length} items from comma-separated format`);
   return { header, items };
 }
 
 /**
- * Spezielle Parsing-Funktion für Spec_item.txt Format
+ * Wandelt einen Zeilenbereich aus Spec_item.txt in ResourceItems um.
+ * Die Werte landen in einem spaltenorientierten Speicher (columnStore.ts), item.data
+ * ist eine Sicht auf die jeweilige Zeile. Zellen werden direkt aus den gescannten
+ * Bytes gelesen (numerische Spalten ohne Umweg über Strings).
+ * Wird sowohl vom sequentiellen Parser als auch von den Webworkern verwendet;
+ * Anzeigenamen aus propItem werden anschließend mit resolvePropItemNames gesetzt.
+ * @param table Gescannte Datenzeilen (ganze Datei ohne Kopfzeile oder ein Worker-Abschnitt)
+ * @param header Spaltennamen aus der ersten Zeile
+ * @param startRow Erste zu verarbeitende Zeile der Tabelle
+ * @param endRow Zeile hinter der letzten zu verarbeitenden Zeile
+ * @param lineOffset Versatz der Zeilennummern (für auto_-IDs)
+ * @param intern Funktion des String-Pools für die Zellwerte (stringPool.ts)
+ * @returns Die Items und der Speicher mit ihren Werten (Zeile k gehört zu items[k])
  */
-function parseSpecItemFormat(lines: string[]): FileData {
-  console.log("Detected spec_item.txt format with tabs as delimiters");
-  
-  if (lines.length === 0) {
-    return { header: [], items: [] };
-  }
-  
-  // Bei spec_item.txt ist die erste Zeile der Header
-  const header = lines[0].split("\t").map(h => h.trim());
-  console.log(`Header columns in spec_item.txt: ${header.length}`);
-  
+export const parseSpecItemRows = (
+  table: TabTable,
+  header: string[],
+  startRow: number,
+  endRow: number,
+  lineOffset: number = 0,
+  intern?: (value: string) => string
+): { items: ResourceItem[]; store: ColumnStore } => {
   const items: ResourceItem[] = [];
+  const rows: number[] = [];
+  const { idColumn, nameColumn } = getSpecItemSchema(header);
+  table.setIntern(intern ?? null);
   
-  // Performance-Optimierung: Verwende größere Batches für moderne Computer
-  const totalLines = lines.length - 1;
-  const isLargeFile = totalLines > 50000;
-  
-  // Dynamische Batch-Größe basierend auf Dateigroße
-  const batchSize = isLargeFile ? 5000 : 2000;
-  const totalBatches = Math.ceil(totalLines / batchSize);
-  
-  console.log(`Performance-Optimierung: ${isLargeFile ? 'Große' : 'Normale'} Datei erkannt, 
-               verwende Batch-Größe von ${batchSize} (${totalBatches} Batches)`);
-  
-  // Performance-Optimierung: Webworker für Parallelverarbeitung nutzen (wenn verfügbar)
-  const supportsWorkers = typeof Worker !== 'undefined';
-  let useWorkers = isLargeFile && supportsWorkers && totalBatches > 4;
-  
-  // Cache für Spaltenindizes, um wiederholte header.indexOf-Aufrufe zu vermeiden
-  const headerLength = header.length;
-  
-  // Webworker sind für diese Art von Daten oft langsamer wegen der Overhead-Kosten
-  useWorkers = false;
-  
-  if (useWorkers) {
-    console.log('Webworker-Unterstützung noch nicht implementiert, falle zurück auf sequentielles Parsen');
-    // TODO: Implementiere Webworker-Unterstützung für paralleles Parsen
+  for (let row = startRow; row < endRow; row++) {
+    // Skip invalid lines with less than 2 columns (leere Zeilen überspringt bereits der Scanner)
+    if (table.cellCount(row) < 2) continue;
+    
+    const id = idColumn !== -1 && idColumn < header.length ? table.getCell(row, idColumn) || "" : "";
+    const name = nameColumn !== -1 ? table.getCell(row, nameColumn) || "" : "";
+    
+    // Nur bei vorhandener ID weitermachen
+    if (id) {
+      items.push({
+        id,
+        name,
+        displayName: name,
+        description: '',
+        idPropItem: name, // Store the original propItem ID
+        data: {},
+        effects: []
+      });
+    } else if (name) {
+      // Für Elemente ohne ID, aber mit Namen
+      items.push({
+        id: `auto_${table.lineOf(row) + lineOffset}`,
+        name,
+        displayName: name,
+        description: '',
+        idPropItem: '',
+        data: {},
+        effects: [], // Leeres Array, da keine vollständigen Daten vorhanden
+      });
+    } else {
+      // Performance-Optimierung: Skip Items ohne ID und ohne Namen
+      continue;
+    }
+    rows.push(row);
   }
   
-  // Sequentielles Parsen
-  {
-    for (let batchIndex = 0; batchIndex < totalBatches; batchIndex++) {
-      const startLine = 1 + batchIndex * batchSize;
-      const endLine = Math.min(startLine + batchSize, lines.length);
-      
-      console.log(`Verarbeite Batch ${batchIndex + 1}/${totalBatches} (Zeilen ${startLine} bis ${endLine})`);
-      
-      for (let i = startLine; i < endLine; i++) {
-        const line = lines[i].trim();
-        if (!line) continue; // Skip empty lines
-        
-        const values = line.split("\t");
-        if (values.length < 2) continue; // Skip invalid lines with less than 2 columns
-        
-        // Performance-Optimierung: Direktes Objekt-Literal statt wiederholter Zuweisung
-        const data: ItemData = {};
-        let id = "";
-        let name = "";
-        
-        // Performance-Optimierung: Spezialfall für SpecItem Format mit festen Spalten
-        if (headerLength === values.length) {
-          // Schnellerer Pfad wenn Header und Werte genau übereinstimmen
-          for (let j = 0; j < headerLength; j++) {
-            const colName = header[j];
-            if (!colName) continue;
-            
-            const value = values[j].trim();
-            data[colName] = value;
-            
-            // Extract ID and name for reference
-            if (colName === "//dwID" || colName === "dwID") {
-              id = value;
-              data["dwID"] = value;
-            } else if (colName === "szName") {
-              name = value;
-            }
-          }
-        } else {
-          // Fallback für unterschiedliche Längen
-          // Map values to column names from the header
-          for (let j = 0; j < Math.min(headerLength, values.length); j++) {
-            const colName = header[j];
-            if (!colName) continue;
-            
-            const value = values[j].trim();
-            data[colName] = value;
-            
-            // Extract ID and name for reference
-            if (colName === "//dwID" || colName === "dwID") {
-              id = value;
-              data["dwID"] = value;
-            } else if (colName === "szName") {
-              name = value;
-            }
-          }
-        }
-        
-        // Performance-Optimierung: Minimiere propItemMappings Zugriffe
-        // Nur bei vorhandener ID weitermachen
-        if (id) {
-          // Get the name and description from propItem mappings if available
-          let displayName = name;
-          let description = '';
-          let idPropItem = name; // Store the original propItem ID 
-          
-          // Performance-Optimierung: Reduzieren der Lookup-Operationen
-          const propItemCount = Object.keys(propItemMappings).length;
-          
-          // Only lookup in propItemMappings if we have entries and name is not empty
-          if (propItemCount > 0 && name) {
-            // Direkter Zugriff auf das Mapping, ohne mehrfache Prüfungen
-            const mapping = propItemMappings[name];
-            
-            if (mapping) {
-              displayName = mapping.displayName || name;
-              description = mapping.description || '';
-            } 
-            // Nur komplexe Fallback-Logik verwenden, wenn nötig (IDS_PROPITEM)
-            else if (name.includes("IDS_PROPITEM_TXT_")) {
-              const propItemName = getPropItemDisplayName(name);
-              if (propItemName !== name) {
-                displayName = propItemName;
-              }
-            }
-          }
-          
-          // Extrahiere Effekte aus den dwDestParam und nAdjParamVal Spalten
-          const effects = extractEffectsFromData(data);
-          
-          // Performance-Optimierung: Direkt ins items-Array pushen statt über Zwischenbatch
-          items.push({
-            id,
-            name,
-            displayName,
-            description,
-            idPropItem,
-            data,
-            effects // Befülle effects statt leerem Array
-          });
-        } else if (name) {
-          // Für Elemente ohne ID, aber mit Namen
-          items.push({
-            id: `auto_${i}`,
-            name,
-            displayName: name,
-            description: '',
-            idPropItem: '',
-            data,
-            effects: [], // Leeres Array, da keine vollständigen Daten vorhanden
-          });
-        }
-        // Performance-Optimierung: Skip Items ohne ID und ohne Namen
-      }
-      
-      // Performance-Optimierung: Batch nicht mehr verwenden, da direkt in items eingefügt wird
-      
-      // Versuche Speicher freizugeben bei großen Dateien
-      if (isLargeFile && batchIndex % 4 === 3 && global.gc) {
-        global.gc();
+  const store = ColumnStore.fromTable(header, table, rows);
+  table.setIntern(null);
+  attachColumnStore(items, store);
+  
+  return { items, store };
+};
+
+/**
+ * Verbindet Items mit den Zeilen eines Speichers und extrahiert die Effekte
+ * @param items Items in Zeilenreihenfolge des Speichers
+ * @param store Speicher mit den Werten
+ * @param extractEffects false, wenn die Effekte bereits gesetzt sind (parseTextFileParallel: in den Workern extrahiert)
+ */
+export const attachColumnStore = (items: ResourceItem[], store: ColumnStore, extractEffects: boolean = true): void => {
+  items.forEach((item, row) => {
+    item.data = store.rowView(row);
+    // Extrahiere Effekte aus den dwDestParam und nAdjParamVal Spalten
+    if (extractEffects && item.idPropItem) {
+      item.effects = extractEffectsFromData(item.data, store.schema);
+    }
+  });
+};
+
+/**
+ * Setzt Anzeigename und Beschreibung aus den propItem-Mappings
+ * @param items Items aus parseSpecItemRows
+ */
+export const resolvePropItemNames = (items: ResourceItem[]): void => {
+  // Performance-Optimierung: Reduzieren der Lookup-Operationen
+  if (Object.keys(propItemMappings).length === 0) return;
+  
+  for (const item of items) {
+    const name = item.name;
+    // auto_-Items haben keine propItem-Zuordnung
+    if (!name || !item.idPropItem) continue;
+    
+    // Direkter Zugriff auf das Mapping, ohne mehrfache Prüfungen
+    const mapping = propItemMappings[name];
+    
+    if (mapping) {
+      item.displayName = mapping.displayName || name;
+      item.description = mapping.description || '';
+    }
+    // Nur komplexe Fallback-Logik verwenden, wenn nötig (IDS_PROPITEM)
+    else if (name.includes("IDS_PROPITEM_TXT_")) {
+      const propItemName = getPropItemDisplayName(name);
+      if (propItemName !== name) {
+        item.displayName = propItemName;
       }
     }
   }
+};
+
+/**
+ * Getrimmte Kopfzeile einer Spec_item.txt (null, wenn es keine ist)
+ */
+export const readSpecItemHeader = (content: string): string[] | null => {
+  const firstLine = readFirstLine(content).replace(/^\uFEFF/, '');
+  return isSpecItemHeader(firstLine) ? firstLine.split("\t").map(h => h.trim()) : null;
+};
+
+/**
+ * Parst einzelne Datenzeilen von Spec_item.txt (z.B. einen extern geänderten Bereich)
+ * @param header Getrimmte Kopfzeile der Datei
+ * @param text Die Zeilen (ohne Kopfzeile)
+ * @param firstLine 0-basierte Zeilennummer der ersten Zeile in der Datei (für auto_-IDs)
+ */
+export const parseSpecItemLines = (header: string[], text: string, firstLine: number): ResourceItem[] => {
+  const table = scanTabSeparated(textEncoder.encode(text));
+  const { items } = parseSpecItemRows(table, header, 0, table.rowCount, firstLine);
+  resolvePropItemNames(items);
+  return items;
+};
+
+/**
+ * Spezielle Parsing-Funktion für Spec_item.txt Format
+ * Für große Dateien gibt es mit parseTextFileParallel (specItemWorkerPool.ts) eine parallele Variante.
+ * @param headerCells Ungetrimmte Zellen der Kopfzeile
+ * @param table Gescannte Datenzeilen (ab der zweiten Zeile)
+ */
+function parseSpecItemFormat(headerCells: string[], table: TabTable): FileData {
+  console.log("Detected spec_item.txt format with tabs as delimiters");
+  
+  // Bei spec_item.txt ist die erste Zeile der Header
+  const internScope = createInternScope("Spec_item.txt");
+  const header = headerCells.map(h => internScope.intern(h.trim()));
+  console.log(`Header columns in spec_item.txt: ${header.length}`);
+  
+  // Zeilennummern der Tabelle beginnen hinter der Kopfzeile
+  const parseSpan = traceBegin("parseSpecItemFormat", "parse");
+  const { items } = parseSpecItemRows(table, header, 0, table.rowCount, 1, internScope.intern);
+  traceEnd(parseSpan, { rows: table.rowCount });
+  
+  traceSync("resolvePropItemNames", "index", () => resolvePropItemNames(items));
+  internScope.finish();
   
   console.log(`Geparst: ${items.length} Items aus spec_item.txt Format`);
   
@@ -0,0 +1,121 @@
+/**
+ * Client für den Parser-Prozess (public/main/parserProcess.cjs)
+ *
+ * Unter Electron liest, dekodiert und scannt ein eigener Prozess Spec_item.txt beim Laden
+ * (loadScannedFile). Die Antwort kommt als ein ArrayBuffer direkt über einen MessagePort,
+ * ohne Umweg über den Main-Prozess; der Renderer setzt daraus nur noch seine TabTable
+ * zusammen und parst die Items daraus.
+ * Im Browser gibt es den Prozess nicht (isParserServiceAvailable).
+ */
+import { setPrescannedTable } from "./parseUtils";
+import { TabTable } from "./tabScanner";
+import { type FileEncodingInfo, setFileEncodings } from "./fileEncodings";
+import { setPatchBase } from "./filePatch";
+
+// Gescannte Datei: Offset-Arrays (Uint32) und danach der Inhalt als UTF-8 in einem Puffer
+interface ScannedFile {
+  fileName: string;
+  hash: string;
+  encoding: FileEncodingInfo;
+  lineCount: number;
+  rowCount: number;
+  cellCount: number;
+  byteLength: number;
+  buffer: ArrayBuffer;
+}
+
+const CONNECT_TIMEOUT_MS = 10000;
+
+let portPromise: Promise<MessagePort> | null = null;
+let nextRequestId = 1;
+const pendingRequests = new Map<number, { resolve: (value: any) => void; reject: (error: Error) => void }>();
+const textDecoder = new TextDecoder();
+
+export const isParserServiceAvailable = (): boolean =>
+  typeof window !== 'undefined' && !!window.electronAPI?.connectParser;
+
+const handleResponse = ({ data }: MessageEvent) => {
+  const pending = pendingRequests.get(data?.id);
+  if (!pending) return;
+  pendingRequests.delete(data.id);
+  if (data.error !== undefined) {
+    pending.reject(new Error(data.error));
+  } else {
+    pending.resolve(data.result);
+  }
+};
+
+// Port beim ersten Aufruf anfordern; der Preload reicht ihn als window-Nachricht weiter
+const getPort = (): Promise<MessagePort> => {
+  if (!portPromise) {
+    portPromise = new Promise<MessagePort>((resolve, reject) => {
+      const timeout = setTimeout(() => {
+        window.removeEventListener('message', onMessage);
+        portPromise = null;
+        reject(new Error("Keine Verbindung zum Parser-Prozess"));
+      }, CONNECT_TIMEOUT_MS);
+
+      const onMessage = (event: MessageEvent) => {
+        if (event.source !== window || event.data?.type !== 'parser-port' || !event.ports[0]) return;
+        clearTimeout(timeout);
+        window.removeEventListener('message', onMessage);
+
+        const port = event.ports[0];
+        port.onmessage = handleResponse;
+        console.log("Verbindung zum Parser-Prozess hergestellt");
+        resolve(port);
+      };
+
+      window.addEventListener('message', onMessage);
+      window.electronAPI!.connectParser!();
+    });
+  }
+  return portPromise;
+};
+
+const request = async <T>(type: string, payload: Record<string, unknown>): Promise<T> => {
+  if (!isParserServiceAvailable()) {
+    throw new Error("Parser-Prozess ist nur unter Electron verfügbar");
+  }
+  const port = await getPort();
+  const id = nextRequestId++;
+  return new Promise<T>((resolve, reject) => {
+    pendingRequests.set(id, { resolve, reject });
+    port.postMessage({ id, type, ...payload });
+  });
+};
+
+/**
+ * Lädt eine Datei mit Kopfzeile (Spec_item.txt) über den Parser-Prozess
+ * Der Scan der Datenzeilen wird für das folgende parseFileContent vorgemerkt; Kodierung
+ * und Stand für das Delta-Speichern werden wie bei loadResourceFile gesetzt.
+ * @returns Der Inhalt oder null, wenn die Datei nicht geladen werden konnte
+ */
+export const loadScannedFile = async (fileName: string): Promise<string | null> => {
+  try {
+    const startTime = performance.now();
+    const scanned = await request<ScannedFile>('scan', { fileName });
+    const { rowCount, cellCount, buffer } = scanned;
+
+    // Sichten auf den Puffer, ohne ihn zu kopieren
+    const offsetCount = rowCount + (rowCount + 1) + cellCount * 2;
+    const rowLines = new Uint32Array(buffer, 0, rowCount);
+    const rowCells = new Uint32Array(buffer, rowCount * 4, rowCount + 1);
+    const cellStarts = new Uint32Array(buffer, (rowCount * 2 + 1) * 4, cellCount);
+    const cellEnds = new Uint32Array(buffer, (rowCount * 2 + 1 + cellCount) * 4, cellCount);
+    const bytes = new Uint8Array(buffer, offsetCount * 4, scanned.byteLength);
+
+    const content = textDecoder.decode(bytes);
+    const table = new TabTable(bytes, rowLines, rowCells, cellStarts, cellEnds, scanned.lineCount, 'utf-8');
+    setPrescannedTable(content, bytes, table);
+
+    setFileEncodings({ [scanned.fileName]: scanned.encoding });
+    setPatchBase(scanned.fileName, content, scanned.hash);
+
+    console.log(`${scanned.fileName} über den Parser-Prozess geladen (${rowCount} Zeilen, ${scanned.encoding.encoding}) in ${(performance.now() - startTime).toFixed(0)}ms`);
+    return content;
+  } catch (error) {
+    console.error(`Fehler beim Laden von ${fileName} über den Parser-Prozess:`, error);
+    return null;
+  }
+};
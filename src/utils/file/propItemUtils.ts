@@ -1,5 +1,6 @@
 import { setPropItemMappings } from './parseUtils';
 import { trackPropItemChanges, savePropItemChanges } from './fileOperations';
+import { createInternScope } from './stringPool';
 // import path from 'path';
 
 // Interface for propItem data mapping
@@ -7,9 +8,170 @@ interface PropItemMapping {
   [key: string]: { name: string; description: string; displayName: string };
 }
 
+// Zuletzt geparster Inhalt; derselbe Inhalt (z.B. schon beim Streamen geparst) wird nicht erneut geparst
+let lastParsedPropItem: { content: string; mappings: PropItemMapping } | null = null;
+
+/**
+ * Vergisst den zuletzt geparsten Inhalt, damit parsePropItemFile wieder vollständig parst
+ * (z.B. für Benchmarks, die denselben Inhalt wiederholt parsen)
+ */
+export const resetParsedPropItem = () => {
+  lastParsedPropItem = null;
+};
+
+/**
+ * Parser für propItem.txt.txt, der die Zeilen einzeln erhält - z.B. aus loadResourceFile,
+ * während die Datei noch gelesen wird (siehe resourceStream.ts, ResourceLineReader)
+ */
+export const createPropItemParser = () => {
+  let mappings: PropItemMapping = {};
+  let internScope = createInternScope("propItem.txt.txt");
+  let firstLine = true;
+
+  const line = (rawLine: string): void => {
+    // BOM entfernen, wenn vorhanden
+    if (firstLine) {
+      firstLine = false;
+      if (rawLine.charCodeAt(0) === 0xFEFF) {
+        console.log("BOM detected, removing...");
+        rawLine = rawLine.substring(1);
+      }
+    }
+
+    const line = rawLine.trim();
+    if (!line) return;
+    
+    // Problematische Zeichen entfernen
+    const cleanedLine = line.replace(/[\uFEFF\u0000-\u0008\u000B\u000C\u000E-\u001F]/g, "");
+    
+    // Teile die Zeile nach Tab-Zeichen oder Leerzeichen
+    let parts: string[] = [];
+    
+    // Entferne zusätzliche Leerzeichen am Anfang und Ende
+    const trimmedLine = cleanedLine.trim();
+    
+    // Versuche verschiedene Parsing-Methoden
+    if (trimmedLine.includes('\t')) {
+      // Tab-getrennte Werte
+      parts = trimmedLine.split('\t');
+    } else {
+      // Suche nach der ID und dem Rest mit regulärem Ausdruck
+      // Berücksichtige verschiedene Textformate (mit und ohne Klammern)
+      const match = trimmedLine.match(/^(IDS_PROPITEM_TXT_\d+)\s+(.+)$/);
+      if (match) {
+        const [, id, rest] = match;
+        parts = [id.trim(), rest.trim()];
+      }
+    }
+    
+    if (parts.length < 2) return;
+    
+    const id = parts[0].trim();
+    const value = internScope.intern(parts[1].trim());
+    
+    if (!value) return;
+    
+    // Extrahiere den numerischen Teil der ID
+    if (id.includes("IDS_PROPITEM_TXT_")) {
+      const numericPart = id.replace(/.*IDS_PROPITEM_TXT_/, "");
+      const idNumber = parseInt(numericPart, 10);
+      
+      if (isNaN(idNumber)) {
+        console.warn(`Invalid numeric part in ID: ${id}`);
+        return;
+      }
+      
+      // Prüfe, ob dies ein Name (gerade) oder eine Beschreibung (ungerade) ist
+      if (idNumber % 2 === 0) { // Gerade Zahl - Name
+        // Stelle sicher, dass die ID im korrekten Format ist
+        const formattedId = `IDS_PROPITEM_TXT_${idNumber.toString().padStart(6, '0')}`;
+        
+        // Speichere das Mapping
+        mappings[formattedId] = {
+          name: formattedId,
+          displayName: value,
+          description: ""
+        };
+        
+        // Speichere auch die ursprüngliche ID als Mapping
+        if (id !== formattedId) {
+          mappings[id] = {
+            name: id,
+            displayName: value,
+            description: ""
+          };
+        }
+      } else { // Ungerade Zahl - Beschreibung
+        // Finde die zugehörige ID (vorherige gerade Zahl)
+        const nameId = `IDS_PROPITEM_TXT_${(idNumber - 1).toString().padStart(6, '0')}`;
+        
+        if (mappings[nameId]) {
+          mappings[nameId].description = value;
+        } else {
+          // Erstelle einen Platzhalter-Eintrag für die Beschreibung
+          mappings[id] = {
+            name: id,
+            displayName: id, // Verwende ID als Fallback
+            description: value
+          };
+        }
+      }
+    }
+  };
+
+  const reset = (): void => {
+    internScope.finish();
+    internScope = createInternScope("propItem.txt.txt");
+    mappings = {};
+    firstLine = true;
+  };
+
+  /**
+   * Schließt das Parsen ab und übernimmt die Mappings
+   * @param content Optional: der vollständige Inhalt, damit parsePropItemFile ihn nicht erneut parst
+   */
+  const finish = (content?: string): PropItemMapping => {
+    internScope.finish();
+    const mappingCount = Object.keys(mappings).length;
+    console.log(`✅ PropItem Mappings loaded: ${mappingCount}`);
+    
+    // Stichprobenartige Überprüfung wichtiger Mappings
+    const criticalItems = [
+      "IDS_PROPITEM_TXT_000124",
+      "IDS_PROPITEM_TXT_007342",
+      "IDS_PROPITEM_TXT_011634"
+    ];
+    
+    criticalItems.forEach(id => {
+      if (mappings[id]) {
+        console.log(`Found critical item ${id}: ${mappings[id].displayName}`);
+      } else {
+        console.warn(`❌ Critical item not found: ${id}`);
+      }
+    });
+    
+    if (content !== undefined) {
+      lastParsedPropItem = { content, mappings };
+    }
+    
+    // Cache the mappings for future use
+    setPropItemMappings(mappings);
+    return mappings;
+  };
+
+  return { line, reset, finish };
+};
+
 export const parsePropItemFile = (content: string): PropItemMapping => {
   console.log("parsePropItemFile called with content length:", content.length);
   
+  // Schon beim Laden (zeilenweise aus dem Stream) geparst
+  if (lastParsedPropItem && lastParsedPropItem.content === content) {
+    console.log("propItem.txt.txt was already parsed while loading, reusing mappings");
+    setPropItemMappings(lastParsedPropItem.mappings);
+    return lastParsedPropItem.mappings;
+  }
+  
   // Überprüfe auf nicht-standardmäßige Codierungen nur bei den ersten 1000 Zeichen
   const hasNonASCII = /[^\x00-\x7F]/.test(content.substring(0, 1000));
   if (hasNonASCII) {
@@ -38,156 +200,11 @@ export const parsePropItemFile = (content: string): PropItemMapping => {
     console.log("First line sample:", lines[0].substring(0, 100) + (lines[0].length > 100 ? '...' : ''));
   }
   
-  const mappings: PropItemMapping = {};
-  
-  // BOM entfernen, wenn vorhanden
-  let startIndex = 0;
-  if (lines.length > 0 && (lines[0].charCodeAt(0) === 0xFEFF || lines[0].startsWith("\uFEFF"))) {
-    console.log("BOM detected, removing...");
-    lines[0] = lines[0].substring(1);
-  }
-  
-  // Verarbeitung in Chunks
-  const chunkSize = 5000;
-  const totalChunks = Math.ceil(lines.length / chunkSize);
-  
-  for (let chunkIndex = 0; chunkIndex < totalChunks; chunkIndex++) {
-    const startLine = chunkIndex * chunkSize;
-    const endLine = Math.min(startLine + chunkSize, lines.length);
-    
-    if (chunkIndex === 0 || chunkIndex === totalChunks - 1 || chunkIndex % 5 === 0) {
-      console.log(`Processing chunk ${chunkIndex + 1}/${totalChunks} (lines ${startLine}-${endLine})`);
-    }
-    
-    for (let i = startLine; i < endLine; i++) {
-      const line = lines[i].trim();
-      if (!line) continue;
-      
-      // Problematische Zeichen entfernen
-      const cleanedLine = line.replace(/[\uFEFF\u0000-\u0008\u000B\u000C\u000E-\u001F]/g, "");
-      
-      // Teile die Zeile nach Tab-Zeichen oder Leerzeichen
-      let parts: string[] = [];
-      
-      // Entferne zusätzliche Leerzeichen am Anfang und Ende
-      const trimmedLine = cleanedLine.trim();
-      
-      // Versuche verschiedene Parsing-Methoden
-      if (trimmedLine.includes('\t')) {
-        // Tab-getrennte Werte
-        parts = trimmedLine.split('\t');
-      } else {
-        // Suche nach der ID und dem Rest mit regulärem Ausdruck
-        // Berücksichtige verschiedene Textformate (mit und ohne Klammern)
-        const match = trimmedLine.match(/^(IDS_PROPITEM_TXT_\d+)\s+(.+)$/);
-        if (match) {
-          const [, id, rest] = match;
-          parts = [id.trim(), rest.trim()];
-          
-          // Debug-Ausgabe für problematische IDs
-          if (id.includes("007342")) {
-            console.log("Found problematic ID:", {
-              originalLine: trimmedLine,
-              parsedId: id,
-              parsedValue: rest,
-              parts
-            });
-          }
-        }
-      }
-      
-      if (parts.length < 2) continue;
-      
-      const id = parts[0].trim();
-      const value = parts[1].trim();
-      
-      if (!value) continue;
-      
-      // Extrahiere den numerischen Teil der ID
-      if (id.includes("IDS_PROPITEM_TXT_")) {
-        const numericPart = id.replace(/.*IDS_PROPITEM_TXT_/, "");
-        const idNumber = parseInt(numericPart, 10);
-        
-        if (isNaN(idNumber)) {
-          console.warn(`Invalid numeric part in ID: ${id}`);
-          continue;
-        }
-        
-        // Prüfe, ob dies ein Name (gerade) oder eine Beschreibung (ungerade) ist
-        if (idNumber % 2 === 0) { // Gerade Zahl - Name
-          // Stelle sicher, dass die ID im korrekten Format ist
-          const formattedId = `IDS_PROPITEM_TXT_${idNumber.toString().padStart(6, '0')}`;
-          
-          // Speichere das Mapping
-          mappings[formattedId] = {
-            name: formattedId,
-            displayName: value,
-            description: ""
-          };
-          
-          // Speichere auch die ursprüngliche ID als Mapping
-          if (id !== formattedId) {
-            mappings[id] = {
-              name: id,
-              displayName: value,
-              description: ""
-            };
-          }
-        } else { // Ungerade Zahl - Beschreibung
-          // Finde die zugehörige ID (vorherige gerade Zahl)
-          const nameId = `IDS_PROPITEM_TXT_${(idNumber - 1).toString().padStart(6, '0')}`;
-          
-          if (mappings[nameId]) {
-            mappings[nameId].description = value;
-          } else {
-            // Erstelle einen Platzhalter-Eintrag für die Beschreibung
-            mappings[id] = {
-              name: id,
-              displayName: id, // Verwende ID als Fallback
-              description: value
-            };
-          }
-        }
-      }
-    }
-    
-    // Gib dem Browser Zeit zum Atmen nach jedem Chunk
-    if (chunkIndex % 3 === 2 && chunkIndex < totalChunks - 1) {
-      console.log(`Processed ${Object.keys(mappings).length} mappings so far...`);
-    }
+  const parser = createPropItemParser();
+  for (let i = 0; i < lines.length; i++) {
+    parser.line(lines[i]);
   }
-  
-  const mappingCount = Object.keys(mappings).length;
-  console.log(`✅ PropItem Mappings loaded: ${mappingCount}`);
-  
-  // Stichprobenartige Überprüfung wichtiger Mappings
-  const criticalItems = [
-    "IDS_PROPITEM_TXT_000124",
-    "IDS_PROPITEM_TXT_007342",
-    "IDS_PROPITEM_TXT_011634"
-  ];
-  
-  console.log("Checking critical items in mappings:");
-  criticalItems.forEach(id => {
-    if (mappings[id]) {
-      console.log(`Found critical item ${id}: ${mappings[id].displayName}`);
-    } else {
-      console.warn(`❌ Critical item not found: ${id}`);
-      // Versuche alternative Formatierung
-      const altId = id.replace(/IDS_PROPITEM_TXT_(\d+)/, (_, num) => 
-        `IDS_PROPITEM_TXT_${parseInt(num).toString().padStart(6, '0')}`
-      );
-      if (mappings[altId]) {
-        console.log(`Found critical item with alternative format ${altId}: ${mappings[altId].displayName}`);
-      } else {
-        console.warn(`❌ Critical item not found with alternative format: ${altId}`);
-      }
-    }
-  });
-  
-  // Cache the mappings for future use
-  setPropItemMappings(mappings);
-  return mappings;
+  return parser.finish(content);
 };
 
 /**
@@ -421,33 +438,17 @@ export const savePropItemsToFile = async (items: any[]): Promise<boolean> => {
     console.log("Serialisiere propItem-Änderungen für", items.length, "Items");
     
     // Importiere die benötigte Funktion aus fileOperations
-    const { serializePropItemData, saveTextFile, trackModifiedFile } = await import('./fileOperations');
-    const content = serializePropItemData(items);
-    
-    // Debug: Prüfe den generierten Inhalt
-    console.log(`Serialisierter propItem-Inhalt (Auszug): ${content.substring(0, 200)}...`);
+    const { trackPropItemTexts, saveJournalFile, materializeJournalFile } = await import('./fileOperations');
     
-    // Inspiziere Inhalt auf bestimmte IDs
-    console.log("Suche nach bestimmten IDs im serialisierten Inhalt:");
-    const idsPattern = /IDS_PROPITEM_TXT_\d+\t([^\r\n]+)/g;
-    let match;
-    let matchCount = 0;
-    while ((match = idsPattern.exec(content)) !== null && matchCount < 10) {
-      console.log(`  ${match[0]}`);
-      matchCount++;
-    }
-    
-    // Vor dem Speichern beide Dateien als modifiziert markieren
-    trackModifiedFile("propItem.txt.txt", content, {
-      isSaving: true,
-      timestamp: Date.now(),
-      originalContent: content // Sicherstellen, dass wir den originalen Inhalt behalten
-    });
+    // Nur Einträge mit abweichendem Text im Änderungsjournal vormerken; gespeichert wird der
+    // geladene Stand der Datei, in dem nur diese Einträge ersetzt sind
+    const pending = trackPropItemTexts(items);
+    console.log(`${pending} propItem-Einträge mit Änderungen vorgemerkt`);
     
     // Speichere in die Datei propItem.txt.txt
     try {
-      console.log("Starte saveTextFile für propItem.txt.txt...");
-      const success = await saveTextFile(content, "propItem.txt.txt");
+      console.log("Speichere vorgemerkte Einträge in propItem.txt.txt...");
+      const success = await saveJournalFile("propItem.txt.txt");
       
       if (success) {
         console.log("PropItem.txt.txt erfolgreich gespeichert");
@@ -461,7 +462,8 @@ export const savePropItemsToFile = async (items: any[]): Promise<boolean> => {
         alert("Fehler beim Speichern von propItem.txt.txt. Ein weiterer Versuch wird unternommen.");
         
         // Bei Fehler trotzdem einen neuen Versuch mit saveToResourceFolder starten
-        const retrySuccess = await saveToResourceFolder(content, "propItem.txt.txt");
+        const content = await materializeJournalFile("propItem.txt.txt");
+        const retrySuccess = !!content && await saveToResourceFolder(content, "propItem.txt.txt");
         if (retrySuccess) {
           console.log("PropItem.txt.txt beim zweiten Versuch erfolgreich gespeichert");
           clearModifiedItems();
@@ -480,7 +482,8 @@ export const savePropItemsToFile = async (items: any[]): Promise<boolean> => {
       
       // Versuche es mit der Backup-Methode
       try {
-        const retrySuccess = await saveToResourceFolder(content, "propItem.txt.txt");
+        const content = await materializeJournalFile("propItem.txt.txt");
+        const retrySuccess = !!content && await saveToResourceFolder(content, "propItem.txt.txt");
         if (retrySuccess) {
           console.log("PropItem.txt.txt über Backup-Methode erfolgreich gespeichert");
           clearModifiedItems();
@@ -1,5 +1,13 @@
 import { parsePropItemFile } from './propItemUtils';
-import { parseTextFile } from './parseUtils';
+import { parseTextFile, setPrescannedBytes } from './parseUtils';
+import { type FileEncodingInfo, type SaveEncodingOptions } from './fileEncodings';
+import { type SaveStream } from './saveStream';
+import { type ResourceFileDelta } from './resourceWatcher';
+import { loadResourceFile } from './resourceStream';
+import { isParserServiceAvailable, loadScannedFile } from './parserService';
+import { createPropItemParser } from './propItemUtils';
+import { clearStringPool } from './stringPool';
+import { traceAsync, traceBegin, traceEnd } from '../trace';
 
 // Erkennen ob wir in Electron oder im Browser laufen
 const isElectron = () => {
@@ -11,14 +19,26 @@ declare global {
   interface Window {
     electronAPI?: {
       saveFile: (savePath: string, content: string) => Promise<any>;
-      saveAllFiles: (files: any[], savePath: string) => Promise<any>;
-      loadAllFiles: () => Promise<any>;
+      saveAllFiles: (files: any[], savePath?: string) => Promise<any>;
+      loadAllFiles: () => Promise<{ success: boolean; files?: Record<string, string>; encodings?: Record<string, FileEncodingInfo>; error?: string }>;
       getResourcePath: (subPath: string) => Promise<any>;
+      saveFileWithEncoding?: (fileName: string, content: string, savePath: string, options?: SaveEncodingOptions) => Promise<any>;
+      loadResourceFile?: (fileName: string, onChunk?: (text: string) => void, onReset?: () => void, withBytes?: boolean) => Promise<{ success: boolean; fileName?: string; content?: string; bytes?: Uint8Array; encoding?: FileEncodingInfo; hash?: string; error?: string }>;
+      onResourceFileChanged?: (callback: (delta: ResourceFileDelta) => void) => void;
+      readSymbolTable?: (fileName: string) => Promise<{ success: boolean; data?: Uint8Array; error?: string }>;
+      writeSymbolTable?: (fileName: string, data: Uint8Array) => Promise<{ success: boolean; path?: string; error?: string }>;
+      readParseCache?: (key: string) => Promise<{ success: boolean; hit?: boolean; data?: any; error?: string }>;
+      writeParseCache?: (key: string, data: any) => Promise<{ success: boolean; size?: number; error?: string }>;
+      connectParser?: () => void;
+      openSaveStream?: (fileName: string, savePath: string, options?: SaveEncodingOptions) => SaveStream;
     }
   }
 }
 
 export const loadPredefinedFiles = async (): Promise<{specItem: string | null, propItem: string | null}> => {
+  const span = traceBegin("loadPredefinedFiles", "load");
+  // Jeder Ladevorgang beginnt mit einem leeren Pool; Werte früherer Stände hält der Pool sonst dauerhaft fest
+  clearStringPool();
   try {
     console.log("Attempting to load files from resource directory");
     console.log("Is Electron environment:", isElectron());
@@ -29,10 +49,12 @@ export const loadPredefinedFiles = async (): Promise<{specItem: string | null, p
     }
     
     // Ansonsten mit Fetch versuchen (Browser)
-    return await loadFilesWithFetch();
+    return await traceAsync("Spec_item.txt (fetch)", "fetch", loadFilesWithFetch);
   } catch (error) {
     console.error('Error loading predefined files:', error);
     return { specItem: null, propItem: null };
+  } finally {
+    traceEnd(span);
   }
 };
 
@@ -41,21 +63,29 @@ async function loadFilesFromFileSystem(): Promise<{specItem: string | null, prop
   try {
     console.log("Lade Dateien über Electron API...");
     
-    // Verwende die Electron-API zum Laden aller Ressourcendateien
+    // Nur die beiden Dateien des Item-Tabs laden, nicht den ganzen Ressourcenordner
     if (window.electronAPI) {
-      // Verwende die Electron-API zum Laden der Dateien
-      const result = await window.electronAPI.loadAllFiles();
-      
-      if (result && result.success && result.files) {
-        console.log("Dateien vom Dateisystem geladen:", Object.keys(result.files));
-        
-        return {
-          specItem: result.files['Spec_Item.txt'] || null,
-          propItem: result.files['propItem.txt.txt'] || null
-        };
-      } else {
-        console.error("Fehler beim Laden der Dateien über Electron API:", result?.error || "Unbekannter Fehler");
+      // propItem.txt.txt wird zeilenweise geparst, während die Teile ankommen; parsePropItemFile
+      // liefert danach für denselben Inhalt die fertigen Mappings
+      const propItemParser = createPropItemParser();
+      // Spec_item.txt liest, dekodiert und scannt der Parser-Prozess (parserService.ts); ist er nicht
+      // erreichbar, kommt die Datei wie propItem über den Main-Prozess, samt Rohdaten, die der Renderer
+      // dann direkt scannt (setPrescannedBytes). Der Span umfasst Lesen, Dekodieren und das Parsen von propItem
+      const loadSpecItem = async () =>
+        (isParserServiceAvailable() ? await loadScannedFile('Spec_item.txt') : null) ??
+        loadResourceFile('Spec_item.txt', undefined, undefined, setPrescannedBytes);
+      const [specItem, propItem] = await traceAsync("Spec_item.txt + propItem.txt.txt", "fetch", () =>
+        Promise.all([
+          loadSpecItem(),
+          loadResourceFile('propItem.txt.txt', undefined, propItemParser)
+        ])
+      );
+      if (propItem !== null) {
+        propItemParser.finish(propItem);
       }
+      console.log("Dateien vom Dateisystem geladen:", { specItem: specItem !== null, propItem: propItem !== null });
+      
+      return { specItem, propItem };
     } else {
       console.error("window.electronAPI nicht verfügbar, kann nicht auf Dateisystem zugreifen");
     }
@@ -171,6 +201,8 @@ async function loadFilesWithFetch(): Promise<{specItem: string | null, propItem:
             }
             
             specItemText = decoder.decode(mergedArray);
+            // Die Bytes gleich zum Parsen weitergeben, statt den Text später neu zu kodieren
+            if (decoder.encoding === 'utf-8') setPrescannedBytes(specItemText, mergedArray, 'utf-8');
             specItemPath = path;
             console.log(`Stream-basiertes Laden abgeschlossen, Inhaltslänge: ${specItemText.length}`);
           } else {
@@ -205,6 +237,8 @@ async function loadFilesWithFetch(): Promise<{specItem: string | null, propItem:
               specItemText = decoder.decode(specItemBuffer);
             }
             
+            // Die Bytes gleich zum Parsen weitergeben, statt den Text später neu zu kodieren
+            if (decoder.encoding === 'utf-8') setPrescannedBytes(specItemText, new Uint8Array(specItemBuffer), 'utf-8');
             specItemPath = path;
             console.log(`Successfully decoded ${path}, content length:`, specItemText.length);
           }
@@ -0,0 +1,105 @@
+/**
+ * Einzelne Ressourcendateien über Electron laden
+ *
+ * Statt mit loadAllFiles den gesamten Ressourcenordner (~10 MB Text) in einem Stück zu
+ * übertragen, wird nur die angeforderte Datei gelesen und in Teilen über einen
+ * MessagePort gestreamt. So kann z.B. der Item-Tab starten, bevor propQuest.txt.txt
+ * oder textClient.inc überhaupt gelesen wurden.
+ */
+import { setFileEncodings } from './fileEncodings';
+import { setPatchBase } from './filePatch';
+
+export const isResourceStreamAvailable = (): boolean =>
+  typeof window !== 'undefined' && !!window.electronAPI?.loadResourceFile;
+
+// Empfänger für die Zeilen einer Datei, während sie noch gelesen wird
+export interface ResourceLineReader {
+  // Eine vollständige Zeile ohne Zeilenende
+  line(text: string): void;
+  // Die bisherigen Zeilen sind ungültig, die Datei wird von vorn gelesen
+  reset(): void;
+}
+
+/**
+ * Zerlegt gestreamte Teile in Zeilen (\n oder \r\n); die letzte, unvollständige Zeile
+ * wird bis zum nächsten Teil zurückgehalten
+ */
+export const createLineSplitter = (reader: ResourceLineReader) => {
+  let rest = '';
+  return {
+    chunk(text: string): void {
+      const data = rest + text;
+      let start = 0;
+      for (let newline = data.indexOf('\n'); newline !== -1; newline = data.indexOf('\n', start)) {
+        const end = newline > start && data.charCodeAt(newline - 1) === 13 ? newline - 1 : newline;
+        reader.line(data.substring(start, end));
+        start = newline + 1;
+      }
+      rest = data.substring(start);
+    },
+    reset(): void {
+      rest = '';
+      reader.reset();
+    },
+    end(): void {
+      if (rest) reader.line(rest.endsWith('\r') ? rest.slice(0, -1) : rest);
+      rest = '';
+    }
+  };
+};
+
+/**
+ * Lädt eine Datei aus dem Ressourcenordner
+ * @param fileName Dateiname relativ zum Ressourcenordner (Groß-/Kleinschreibung egal)
+ * @param onChunk Optional: erhält jeden dekodierten Teil sofort
+ * @param lines Optional: erhält jede Zeile, sobald sie vollständig gelesen ist (z.B. für einen Parser)
+ * @param onBytes Optional: erhält zusätzlich die Rohdaten der Datei (nicht für UTF-16), z.B. für setPrescannedBytes
+ * @returns Der Inhalt oder null, wenn die Datei nicht geladen werden konnte
+ */
+export const loadResourceFile = async (
+  fileName: string,
+  onChunk?: (text: string) => void,
+  lines?: ResourceLineReader,
+  onBytes?: (content: string, bytes: Uint8Array, encoding: string) => void
+): Promise<string | null> => {
+  if (!window.electronAPI?.loadResourceFile) {
+    console.error("loadResourceFile nicht verfügbar");
+    return null;
+  }
+
+  try {
+    const startTime = performance.now();
+    const splitter = lines ? createLineSplitter(lines) : null;
+    const result = await window.electronAPI.loadResourceFile(
+      fileName,
+      splitter || onChunk ? (text) => {
+        splitter?.chunk(text);
+        onChunk?.(text);
+      } : undefined,
+      splitter ? () => splitter.reset() : undefined,
+      !!onBytes
+    );
+
+    if (!result.success || result.content === undefined) {
+      console.warn(`Konnte ${fileName} nicht laden:`, result.error);
+      return null;
+    }
+
+    splitter?.end();
+    if (onBytes && result.bytes && result.encoding) {
+      onBytes(result.content, result.bytes, result.encoding.encoding);
+    }
+
+    if (result.encoding) {
+      setFileEncodings({ [result.fileName || fileName]: result.encoding });
+    }
+    // Stand auf der Platte für späteres Delta-Speichern
+    setPatchBase(result.fileName || fileName, result.content, result.hash);
+
+    console.log(`${fileName} geladen (${result.content.length} Zeichen, ${result.encoding?.encoding}) in ${(performance.now() - startTime).toFixed(0)}ms`);
+    return result.content;
+  } catch (error) {
+    console.error(`Fehler beim Laden von ${fileName}:`, error);
+    return null;
+  }
+};
@@ -0,0 +1,288 @@
+/**
+ * Externe Änderungen an Ressourcendateien übernehmen
+ *
+ * Der Main-Prozess überwacht den Ressourcenordner (public/main/resourceWatcher.cjs) und
+ * schickt für jede geänderte Datei nur die geänderten Zeilenbereiche. Hier werden die
+ * Bereiche auf den gemerkten Stand (Patch-Basis) angewendet und nur die betroffenen
+ * Defines, Modelle oder Items neu gelesen:
+ *  - defineItem.h  -> applyDefineItemDelta, Event 'defineItemsUpdated'
+ *  - mdlDyna.inc   -> applyMdlDynaDelta, Event 'mdlDynaItemsUpdated'
+ *  - Spec_item.txt -> parseSpecItemLines, Event 'specItemsChanged' (useFileLoader)
+ * Passt der Stand nicht (oder betrifft die Änderung Kopfzeilen, Blockkommentare usw.),
+ * wird die Datei vollständig neu geladen.
+ *
+ * Hat die Datei ungespeicherte Änderungen, wird das Änderungsjournal auf den neuen Stand
+ * gesetzt (rebaseChanges): bei Spec_item.txt feldweise, extern anders geänderte Felder sind
+ * Konflikte. defineItem.h und mdlDyna.inc halten ihren Inhalt samt Änderungen selbst, dort ist
+ * jede externe Änderung ein Konflikt. Bis der Benutzer ihn auflöst (eigene Werte behalten oder
+ * die externen übernehmen), wird die Datei nicht gespeichert.
+ */
+import { toast } from "sonner";
+import { ResourceItem } from "../../types/fileTypes";
+import { type LineHunk, applyLineHunks, getHunkBaseTexts, getPatchBase, setPatchBase, clearPatchBase } from "./filePatch";
+import { clearJournal, getPendingRows, hasPendingChanges, markExternalConflict, rebaseChanges, resolveJournalConflicts } from "./changeJournal";
+import { applySpecItemCells, readRowCell } from "./serializeUtils";
+import { getSpecItemRowIndex } from "./specItemRowIndex";
+import { applyDefineItemDelta, parseDefineItemFile, getItemDefineMappings } from "./defineItemParser";
+import { applyMdlDynaDelta, parseMdlDynaFile } from "./mdlDynaParser";
+import { parseSpecItemLines, readSpecItemHeader, setPrescannedBytes } from "./parseUtils";
+import { loadResourceFile } from "./resourceStream";
+
+export interface ResourceFileDelta {
+  fileName: string;
+  // SHA-1 der Datei nach der Änderung
+  hash?: string;
+  // SHA-1 des Stands, auf den sich die Hunks beziehen
+  baseHash?: string;
+  lineCount?: number;
+  hunks?: LineHunk[];
+  // Kein bekannter Stand: Datei vollständig neu laden
+  reload?: boolean;
+  // Datei wurde gelöscht oder umbenannt
+  removed?: boolean;
+}
+
+export interface SpecItemsChangedDetail {
+  // Neue oder geänderte Items
+  items: ResourceItem[];
+  removedIds: string[];
+  // Verschiebung der Zeilennummern hinter der Änderung (betrifft auto_-IDs)
+  lineShift: number;
+  content: string;
+  // Kopfzeile geändert oder kein bekannter Stand: alles neu parsen
+  fullReparse: boolean;
+}
+
+let initialized = false;
+
+/**
+ * Meldet sich beim Main-Prozess für Änderungen an (nur unter Electron, einmalig)
+ */
+export const initResourceWatcher = (): void => {
+  if (initialized || !window.electronAPI?.onResourceFileChanged) return;
+  initialized = true;
+
+  window.electronAPI.onResourceFileChanged(delta => {
+    handleResourceFileDelta(delta).catch(error =>
+      console.error(`Fehler beim Übernehmen der Änderung an ${delta.fileName}:`, error)
+    );
+  });
+  console.log("Ressourcenüberwachung aktiv");
+};
+
+const isWatchedFile = (name: string): boolean =>
+  name === "defineitem.h" || name === "mdldyna.inc" || name === "spec_item.txt";
+
+const handleResourceFileDelta = async (delta: ResourceFileDelta): Promise<void> => {
+  const name = delta.fileName.toLowerCase();
+  if (!isWatchedFile(name)) return;
+
+  if (delta.removed) {
+    console.warn(`${delta.fileName} wurde aus dem Ressourcenordner entfernt`);
+    clearPatchBase(delta.fileName);
+    return;
+  }
+
+  if (hasPendingChanges(delta.fileName)) {
+    await rebaseResourceFile(delta);
+    return;
+  }
+
+  const base = getPatchBase(delta.fileName);
+  if (delta.reload || !delta.hunks || !base || base.hash !== delta.baseHash) {
+    await reloadResourceFile(delta.fileName);
+    return;
+  }
+
+  const startTime = performance.now();
+  const previous = base.content;
+  const content = applyLineHunks(previous, delta.hunks);
+  const baseTexts = getHunkBaseTexts(previous, delta.hunks);
+  setPatchBase(delta.fileName, content, delta.hash);
+
+  if (name === "defineitem.h") {
+    const changes = applyDefineItemDelta(content, delta.hunks, baseTexts);
+    if (changes) {
+      window.dispatchEvent(new CustomEvent('defineItemsUpdated', {
+        detail: changes.map(change => ({ id: change.name, value: change.id }))
+      }));
+    } else {
+      applyDefineItemContent(content);
+    }
+  } else if (name === "mdldyna.inc") {
+    const changed = applyMdlDynaDelta(content, delta.hunks, baseTexts);
+    if (changed) {
+      window.dispatchEvent(new CustomEvent('mdlDynaItemsUpdated', {
+        detail: changed.map(define => ({ id: define }))
+      }));
+    } else {
+      applyMdlDynaContent(content);
+    }
+  } else {
+    dispatchSpecItemDelta(previous, content, delta.hunks, baseTexts);
+  }
+
+  console.log(`Externe Änderung an ${delta.fileName} übernommen (${delta.hunks.length} Bereiche) in ${(performance.now() - startTime).toFixed(1)}ms`);
+};
+
+// Datei mit ungespeicherten Änderungen wurde extern geändert: Journal auf den neuen Stand setzen
+const rebaseResourceFile = async (delta: ResourceFileDelta): Promise<void> => {
+  const base = getPatchBase(delta.fileName);
+  const canApply = !delta.reload && !!delta.hunks && !!base && base.hash === delta.baseHash;
+  const content = canApply ? applyLineHunks(base!.content, delta.hunks!) : await loadResourceFile(delta.fileName);
+  if (content === null) return;
+  if (canApply) setPatchBase(delta.fileName, content, delta.hash);
+
+  const rowIndex = delta.fileName.toLowerCase() === "spec_item.txt" ? getSpecItemRowIndex(content) : null;
+  if (!rowIndex) {
+    // Inhalt samt Änderungen liegt im Parser (LineDocument bzw. mdlDyna-Inhalt): nicht feldweise abgleichbar
+    console.warn(`${delta.fileName} wurde extern geändert, hat aber ungespeicherte Änderungen`);
+    markExternalConflict(delta.fileName);
+    showExternalConflict(delta.fileName);
+    return;
+  }
+
+  const { conflicts, discarded } = rebaseChanges(delta.fileName, (itemId, column) => {
+    const span = rowIndex.find(itemId);
+    return span ? readRowCell(content.slice(span.start, span.end), column, rowIndex.schema) : undefined;
+  });
+
+  // Anzeige: neuer Stand mit den weiterhin vorgemerkten (auch den strittigen) eigenen Werten
+  const working = applySpecItemCells(getPendingRows(delta.fileName), content);
+  if (canApply) {
+    const previous = base!.content;
+    dispatchSpecItemDelta(previous, working, overlayHunks(previous, working, delta.hunks!), getHunkBaseTexts(previous, delta.hunks!));
+  } else {
+    const detail: SpecItemsChangedDetail = { items: [], removedIds: [], lineShift: 0, content: working, fullReparse: true };
+    window.dispatchEvent(new CustomEvent('specItemsChanged', { detail }));
+  }
+
+  console.log(`Externe Änderung an ${delta.fileName} mit ungespeicherten Änderungen abgeglichen: ${conflicts.length} Konflikte, ${discarded.length} verworfen`);
+  if (discarded.length > 0) {
+    toast.warning(`${discarded.length} ungespeicherte Änderungen an extern entfernten Items verworfen`, {
+      description: [...new Set(discarded.map(change => change.label || change.rowKey))].join(", ")
+    });
+  }
+  if (conflicts.length > 0) {
+    showExternalConflict(delta.fileName);
+  } else {
+    toast.info(`${delta.fileName} wurde extern geändert. Ungespeicherte Änderungen wurden übernommen.`);
+  }
+};
+
+// Hunks mit dem Text aus dem Arbeitsstand; die vorgemerkten Zellen ändern keine Zeilenzahl,
+// die Bereiche liegen dort also an denselben Zeilen wie im neuen Stand
+const overlayHunks = (previous: string, working: string, hunks: LineHunk[]): LineHunk[] => {
+  let lineCount = 1;
+  for (let i = previous.indexOf('\n'); i !== -1; i = previous.indexOf('\n', i + 1)) lineCount++;
+
+  let shift = 0;
+  const ranges = hunks.map(hunk => {
+    // Bis auf das Dateiende endet jeder Hunk mit einem Zeilenumbruch
+    const lines = hunk.text.split('\n').length - (hunk.end === lineCount ? 0 : 1);
+    const start = hunk.start + shift;
+    shift += lines - (hunk.end - hunk.start);
+    return { start, end: start + lines, text: "" };
+  });
+  const texts = getHunkBaseTexts(working, ranges);
+  return hunks.map((hunk, index) => ({ ...hunk, text: texts[index] }));
+};
+
+/**
+ * Meldet einen Konflikt zwischen ungespeicherten und externen Änderungen einer Datei und bietet
+ * die Auflösung an; bis dahin wird die Datei nicht gespeichert
+ */
+export const showExternalConflict = (fileName: string): void => {
+  toast.warning(`${fileName} wurde extern geändert`, {
+    id: `external-conflict-${fileName.toLowerCase()}`,
+    description: "Ungespeicherte Änderungen widersprechen der externen Änderung. Die Datei wird erst gespeichert, wenn der Konflikt aufgelöst ist.",
+    duration: Infinity,
+    action: { label: "Eigene behalten", onClick: () => resolveExternalConflict(fileName, true) },
+    cancel: { label: "Externe übernehmen", onClick: () => resolveExternalConflict(fileName, false) }
+  });
+};
+
+const resolveExternalConflict = (fileName: string, keepMine: boolean): void => {
+  const resolved = resolveJournalConflicts(fileName, keepMine);
+  const base = getPatchBase(fileName);
+  console.log(`Konflikt in ${fileName} aufgelöst (${keepMine ? "eigene Werte" : "externe Werte"}, ${resolved.length} Felder)`);
+  if (keepMine || !base) return;
+
+  const name = fileName.toLowerCase();
+  if (name === "spec_item.txt") {
+    // Die strittigen Felder zeigen wieder den Wert aus der Datei
+    const working = applySpecItemCells(getPendingRows(fileName), base.content);
+    const header = readSpecItemHeader(working);
+    const rowIndex = getSpecItemRowIndex(working);
+    if (!header || !rowIndex) return;
+    const items = [...new Set(resolved.map(change => change.rowKey))].flatMap(itemId => {
+      const span = rowIndex.find(itemId);
+      return span ? parseSpecItemLines(header, working.slice(span.start, span.end), span.line) : [];
+    });
+    const detail: SpecItemsChangedDetail = { items, removedIds: [], lineShift: 0, content: working, fullReparse: false };
+    window.dispatchEvent(new CustomEvent('specItemsChanged', { detail }));
+    return;
+  }
+
+  // defineItem.h/mdlDyna.inc: eigene Änderungen verwerfen und den Stand der Datei übernehmen
+  clearJournal(fileName);
+  if (name === "defineitem.h") {
+    applyDefineItemContent(base.content);
+  } else if (name === "mdldyna.inc") {
+    applyMdlDynaContent(base.content);
+  }
+};
+
+// Datei ohne passenden Stand: vollständig laden und neu parsen
+const reloadResourceFile = async (fileName: string): Promise<void> => {
+  const name = fileName.toLowerCase();
+  // Spec_item.txt wird danach neu geparst: die Rohdaten gleich mitnehmen
+  const content = await loadResourceFile(fileName, undefined, undefined, name === "spec_item.txt" ? setPrescannedBytes : undefined);
+  if (content === null) return;
+
+  if (name === "defineitem.h") {
+    applyDefineItemContent(content);
+  } else if (name === "mdldyna.inc") {
+    applyMdlDynaContent(content);
+  } else {
+    const detail: SpecItemsChangedDetail = { items: [], removedIds: [], lineShift: 0, content, fullReparse: true };
+    window.dispatchEvent(new CustomEvent('specItemsChanged', { detail }));
+  }
+};
+
+const applyDefineItemContent = (content: string): void => {
+  parseDefineItemFile(content);
+  const mappings = getItemDefineMappings();
+  window.dispatchEvent(new CustomEvent('defineItemsUpdated', {
+    detail: Object.keys(mappings).map(define => ({ id: define, value: mappings[define] }))
+  }));
+};
+
+const applyMdlDynaContent = (content: string): void => {
+  parseMdlDynaFile(content);
+  window.dispatchEvent(new CustomEvent('mdlDynaItemsUpdated', { detail: [{ id: "mdlDyna.inc" }] }));
+};
+
+// Nur die Zeilen der Hunks neu parsen (alt und neu), um geänderte und entfernte Items zu finden
+const dispatchSpecItemDelta = (previous: string, content: string, hunks: LineHunk[], baseTexts: string[]): void => {
+  const header = readSpecItemHeader(previous);
+  const lineShift = hunks.reduce((shift, hunk) =>
+    shift + (hunk.text.split('\n').length - 1) - (hunk.end - hunk.start), 0);
+
+  // Kopfzeile betroffen: Spalten können sich verschoben haben
+  if (!header || hunks.some(hunk => hunk.start === 0)) {
+    const detail: SpecItemsChangedDetail = { items: [], removedIds: [], lineShift, content, fullReparse: true };
+    window.dispatchEvent(new CustomEvent('specItemsChanged', { detail }));
+    return;
+  }
+
+  const items = hunks.flatMap(hunk => parseSpecItemLines(header, hunk.text, hunk.start));
+  const nextIds = new Set(items.map(item => item.id));
+  // Ein Item kann auch nur in einen anderen Bereich verschoben worden sein
+  const removedIds = hunks.flatMap((hunk, index) => parseSpecItemLines(header, baseTexts[index], hunk.start))
+    .map(item => item.id)
+    .filter(id => !nextIds.has(id));
+
+  const detail: SpecItemsChangedDetail = { items, removedIds, lineShift, content, fullReparse: false };
+  window.dispatchEvent(new CustomEvent('specItemsChanged', { detail }));
+};
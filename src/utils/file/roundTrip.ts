@@ -0,0 +1,86 @@
+/**
+ * Byte-genaues Zurückschreiben von Textdateien
+ *
+ * Die Parser trimmen Zellen und Zeilen, aus den geparsten Werten lässt sich die Datei also nicht
+ * unverändert wieder zusammensetzen. Beim Speichern werden deshalb nur geänderte Zeilen im
+ * Originaltext ersetzt: Zeilenenden (CRLF/LF), Tabs und Leerzeichen am Zeilenende und alle
+ * übrigen Zeilen bleiben erhalten. BOM und Kodierung schreibt der Main-Prozess wie geladen
+ * (textEncoding.cjs). Ohne Änderungen entsteht so genau der geladene Inhalt, das Speichern
+ * wird dann übersprungen (matchesPatchBase bzw. fileMatchesHash im Main-Prozess).
+ */
+
+export type LineEnding = '\r\n' | '\n';
+
+/**
+ * Zeilenende eines Textes (nach dem ersten Zeilenumbruch)
+ * @param fallback Für Texte ohne Zeilenumbruch
+ */
+export const detectLineEnding = (text: string, fallback: LineEnding = '\n'): LineEnding => {
+  const newline = text.indexOf('\n');
+  if (newline === -1) return fallback;
+  return newline > 0 && text.charCodeAt(newline - 1) === 13 ? '\r\n' : '\n';
+};
+
+/**
+ * Ersetzt einzelne Zeilen eines Textes; Zeilenenden und unveränderte Zeilen bleiben erhalten
+ * @param edit Erhält jede Zeile ohne Zeilenende und liefert ihren neuen Text oder undefined
+ * @returns Der Text selbst, wenn keine Zeile geändert wurde
+ */
+export const editLines = (
+  text: string,
+  edit: (line: string, index: number) => string | undefined
+): string => {
+  let result = '';
+  let position = 0;
+  let changed = false;
+  let lineStart = 0;
+
+  for (let index = 0; ; index++) {
+    const newline = text.indexOf('\n', lineStart);
+    let lineEnd = newline === -1 ? text.length : newline;
+    if (lineEnd > lineStart && text.charCodeAt(lineEnd - 1) === 13) lineEnd--;
+
+    const line = text.slice(lineStart, lineEnd);
+    const replacement = edit(line, index);
+    if (replacement !== undefined && replacement !== line) {
+      result += text.slice(position, lineStart) + replacement;
+      position = lineEnd;
+      changed = true;
+    }
+
+    if (newline === -1) break;
+    lineStart = newline + 1;
+  }
+
+  return changed ? result + text.slice(position) : text;
+};
+
+/**
+ * Ruft visit für jede Zeile mit ihrer Nummer (0-basiert) und ihrem Bereich ohne Zeilenende auf
+ * @returns Die Zahl der Zeilen (wie text.split('\n').length)
+ */
+export const forEachLine = (
+  text: string,
+  visit: (index: number, start: number, end: number) => void
+): number => {
+  let lineStart = 0;
+  for (let index = 0; ; index++) {
+    const newline = text.indexOf('\n', lineStart);
+    let lineEnd = newline === -1 ? text.length : newline;
+    if (lineEnd > lineStart && text.charCodeAt(lineEnd - 1) === 13) lineEnd--;
+    visit(index, lineStart, lineEnd);
+    if (newline === -1) return index + 1;
+    lineStart = newline + 1;
+  }
+};
+
+/**
+ * Hängt Zeilen mit dem Zeilenende des Textes an; endet der Text mit einem Zeilenumbruch,
+ * endet auch das Ergebnis mit einem
+ */
+export const appendLines = (text: string, lines: string[], eol: LineEnding = detectLineEnding(text)): string => {
+  if (lines.length === 0) return text;
+  const block = lines.join(eol);
+  if (text.length === 0) return block;
+  return text.endsWith('\n') ? text + block + eol : text + eol + block;
+};
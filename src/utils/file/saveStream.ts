@@ -0,0 +1,130 @@
+/**
+ * Dateien in Teilen über Electron speichern
+ *
+ * Statt den ganzen Inhalt als einen String zusammenzusetzen und in einem IPC-Aufruf zu
+ * übertragen, gibt ein Erzeuger (z.B. writeSpecItemCells) den Inhalt in Teilen von etwa
+ * SAVE_CHUNK_SIZE Zeichen weiter. Der Main-Prozess kodiert und schreibt jeden Teil sofort
+ * (public/main/streamWriter.cjs); bestätigt er nicht schnell genug, wartet der Erzeuger.
+ * Der Speicherbedarf hängt damit nicht mehr von der Dateigröße ab, und die maximale
+ * Stringlänge von V8 begrenzt die Größe der geschriebenen Datei nicht mehr.
+ */
+import { type SaveEncodingOptions } from './fileEncodings';
+
+export interface SaveStreamResult {
+  success: boolean;
+  path?: string;
+  size?: number;
+  hash?: string;
+  // Die Datei hatte bereits genau diese Bytes und wurde nicht ersetzt
+  unchanged?: boolean;
+  error?: string;
+}
+
+export interface SaveStream {
+  write: (text: string) => Promise<void>;
+  close: () => Promise<SaveStreamResult>;
+  abort: () => void;
+}
+
+// Größe der übertragenen Teile in Zeichen
+export const SAVE_CHUNK_SIZE = 1 << 20;
+
+// Ab dieser Länge werden auch fertige Inhalte in Teilen übertragen (saveTextFile)
+export const STREAM_SAVE_THRESHOLD = 8 * SAVE_CHUNK_SIZE;
+
+export const isSaveStreamAvailable = (): boolean =>
+  typeof window !== 'undefined' && !!window.electronAPI?.openSaveStream;
+
+/**
+ * Sammelt kleine Teile (z.B. einzelne geänderte Zeilen) und gibt sie ab SAVE_CHUNK_SIZE weiter
+ */
+export const createChunkWriter = (write: (text: string) => Promise<void>) => {
+  let buffer = '';
+  const flush = async (): Promise<void> => {
+    if (buffer.length === 0) return;
+    const chunk = buffer;
+    buffer = '';
+    await write(chunk);
+  };
+  return {
+    push: async (text: string): Promise<void> => {
+      // Teile bleiben höchstens so groß wie der größte einzelne Abschnitt
+      if (buffer.length + text.length > SAVE_CHUNK_SIZE) await flush();
+      buffer += text;
+      if (buffer.length >= SAVE_CHUNK_SIZE) await flush();
+    },
+    flush
+  };
+};
+
+/**
+ * Gibt einen Bereich eines Textes in Teilen weiter, möglichst an Zeilengrenzen geteilt
+ * @param start Erstes Zeichen des Bereichs
+ * @param end Zeichen hinter dem Bereich
+ */
+export const writeTextChunks = async (
+  text: string,
+  write: (chunk: string) => Promise<void>,
+  start: number = 0,
+  end: number = text.length
+): Promise<void> => {
+  let position = start;
+  while (position < end) {
+    let next = Math.min(end, position + SAVE_CHUNK_SIZE);
+    if (next < end) {
+      const newline = text.lastIndexOf('\n', next - 1);
+      if (newline >= position) {
+        next = newline + 1;
+      } else if ((text.charCodeAt(next - 1) & 0xfc00) === 0xd800) {
+        // Zeile länger als ein Teil: zumindest kein Surrogatpaar trennen
+        next--;
+      }
+    }
+    await write(text.slice(position, next));
+    position = next;
+  }
+};
+
+/**
+ * Speichert eine Datei in Teilen
+ * @param fileName Dateiname (für die beim Laden erkannte Kodierung)
+ * @param savePath Zielpfad wie bei saveFile
+ * @param produce Erzeugt den Inhalt und übergibt ihn in Teilen an write
+ * @param options Optionale Kodierung (wie bei saveFileWithEncoding)
+ * @returns Ergebnis des Main-Prozesses; bei Fehlern bleibt die Zieldatei unverändert
+ */
+export const saveTextStream = async (
+  fileName: string,
+  savePath: string,
+  produce: (write: (text: string) => Promise<void>) => Promise<void>,
+  options?: SaveEncodingOptions
+): Promise<SaveStreamResult> => {
+  if (!window.electronAPI?.openSaveStream) {
+    return { success: false, error: 'openSaveStream nicht verfügbar' };
+  }
+
+  const startTime = performance.now();
+  const stream = window.electronAPI.openSaveStream(fileName, savePath, options);
+  let chunks = 0;
+
+  try {
+    await produce(async (text) => {
+      chunks++;
+      await stream.write(text);
+    });
+  } catch (error) {
+    console.error(`Fehler beim gestreamten Speichern von ${fileName}:`, error);
+    stream.abort();
+    return { success: false, error: error instanceof Error ? error.message : String(error) };
+  }
+
+  const result = await stream.close();
+  if (result.success && result.unchanged) {
+    console.log(`${fileName} unverändert (${result.size} Bytes, ${chunks} Teile), Datei nicht ersetzt`);
+  } else if (result.success) {
+    console.log(`${fileName} in ${chunks} Teilen gespeichert (${result.size} Bytes) in ${(performance.now() - startTime).toFixed(0)}ms`);
+  } else {
+    console.error(`Gestreamtes Speichern von ${fileName} fehlgeschlagen:`, result.error);
+  }
+  return result;
+};
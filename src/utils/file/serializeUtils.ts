@@ -5,6 +5,11 @@
 
 // Importiere die formatItemIconValue-Funktion
 import { formatItemIconValue } from './fileOperations';
+import { type SpecItemRowIndex, getSpecItemRowIndex } from './specItemRowIndex';
+import { createChunkWriter, writeTextChunks } from './saveStream';
+import { type EffectSlot, type SpecItemSchema } from './specItemSchema';
+import { getRowViewTarget } from './columnStore';
+import { appendLines, detectLineEnding, editLines } from './roundTrip';
 
 /**
  * Serialisiert für Spec_Item.txt unter Beibehaltung des Formats, aber mit Ersetzung von Namen und Beschreibungen
@@ -26,18 +31,7 @@ export const serializeWithNameReplacement = (fileData: any, originalContent: str
   console.log(`Serialisiere mit Namensersetzung für ${fileData.items.length} Items`);
   
   // Sammle die Änderungen zur Übersicht
-  const itemsWithChanges = fileData.items.filter(item => 
-    item && (
-      item.displayName !== undefined || 
-      item.description !== undefined ||
-      item.fields?.specItem?.define !== undefined ||
-      item.fields?.specItem?.itemIcon !== undefined ||
-      item.fields?.mdlDyna?.fileName !== undefined ||
-      (item.effects && item.effects.length > 0) || // Hinzugefügt: Prüfe auf Effekte
-      item.data?.dwAbilityMin !== undefined ||     // Hinzugefügt: Prüfe auf Min Ability
-      item.data?.dwAbilityMax !== undefined        // Hinzugefügt: Prüfe auf Max Ability
-    )
-  );
+  const itemsWithChanges = getItemsWithChanges(fileData.items);
   
   if (itemsWithChanges.length === 0) {
     console.log("Keine Änderungen gefunden");
@@ -120,205 +114,387 @@ export const serializeWithNameReplacement = (fileData: any, originalContent: str
     return lines.join('\n');
   }
   
-  // Starte mit dem Original-Content und bearbeite nur Zeilen, die wirklich geändert werden sollen
-  let updatedContent = validOriginalContent;
-  
-  // Erstelle ein Mapping von Item-IDs zu den tatsächlichen Zeilen und Positionen in der Datei
-  const lines = updatedContent.split(/\r?\n/);
-  const itemIdToLineMap = new Map<string, number>();
-  const fieldPositionMap = new Map<string, Map<string, { lineIndex: number, startPos: number, endPos: number, line: string }>>();
-  
-  // Analysiere die Datei, um Item-IDs den tatsächlichen Zeilen zuzuordnen
-  console.log("Analysiere Original-Datei nach Item-IDs und Positionen...");
-  lines.forEach((line, index) => {
-    const parts = line.split('\t');
-    if (parts.length >= 2) {
-      // Identifiziere Zeilen, die zum Item gehören könnten
-      for (const item of itemsWithChanges) {
-        if (!item || !item.id) continue;
-        
-        const itemId = item.id;
-        
-        // Prüfe ob diese Zeile das spezifische Item enthält
-        if (line.includes(itemId)) {
-          itemIdToLineMap.set(itemId, index);
-          console.log(`Item ${itemId} gefunden in Zeile ${index + 1}`);
-          
-          // Initialisiere das Field-Map für dieses Item, falls noch nicht vorhanden
-          if (!fieldPositionMap.has(itemId)) {
-            fieldPositionMap.set(itemId, new Map());
-          }
-          
-          // Finde die Positionen für alle Felder
-          const columns = line.split('\t');
-          let currentPos = 0;
-          
-          columns.forEach((col, i) => {
-            const fieldMap = fieldPositionMap.get(itemId)!;
-            
-            // Speichere die Position für jedes relevante Feld
-            if (i === 1) fieldMap.set('define', { lineIndex: index, startPos: currentPos, endPos: currentPos + col.length, line });
-            if (i === 2) fieldMap.set('itemIcon', { lineIndex: index, startPos: currentPos, endPos: currentPos + col.length, line });
-            if (i === 3) fieldMap.set('displayName', { lineIndex: index, startPos: currentPos, endPos: currentPos + col.length, line });
-            if (i === 4) fieldMap.set('description', { lineIndex: index, startPos: currentPos, endPos: currentPos + col.length, line });
-            
-            // Hinzugefügt: Speichere die Positionen für dwDestParam1-6 und nAdjParamVal1-6
-            // Annahme: dwDestParam1 ist die 82. Spalte (0-indexiert) in der Spec_item.txt
-            if (i >= 82 && i <= 87) {
-              fieldMap.set(`dwDestParam${i - 81}`, { lineIndex: index, startPos: currentPos, endPos: currentPos + col.length, line });
-            }
-            
-            // Annahme: nAdjParamVal1 ist die 88. Spalte (0-indexiert) in der Spec_item.txt
-            if (i >= 88 && i <= 93) {
-              fieldMap.set(`nAdjParamVal${i - 87}`, { lineIndex: index, startPos: currentPos, endPos: currentPos + col.length, line });
-            }
-            
-            currentPos += col.length + 1; // +1 für den Tab
-          });
-        }
-      }
+  // Zeilen der geänderten Items über den Zeilenindex finden (dwID -> Zeile, siehe specItemRowIndex.ts)
+  // und nur diese Zeilen neu schreiben; der übrige Inhalt bleibt unverändert
+  const rowIndex = getSpecItemRowIndex(validOriginalContent);
+  if (!rowIndex) {
+    console.warn("Keine Spec_item-Kopfzeile gefunden, Änderungen werden nicht angewendet");
+    return validOriginalContent;
+  }
+  
+  const edits = collectRowEdits(itemsWithChanges, rowIndex);
+  if (edits.length === 0) return validOriginalContent;
+  
+  return applyRowEdits(validOriginalContent, edits);
+};
+
+/**
+ * Setzt den Inhalt aus den unveränderten Abschnitten und den neuen Zeilen zusammen
+ * Verkettung mit + statt join: die Abschnitte werden dabei nicht kopiert, das erledigt erst das
+ * Kodieren beim Schreiben
+ */
+const applyRowEdits = (content: string, edits: RowEdit[]): string => {
+  if (edits.length === 0) return content;
+  let updatedContent = "";
+  let position = 0;
+  for (const edit of edits) {
+    updatedContent += content.slice(position, edit.start) + edit.text;
+    position = edit.end;
+  }
+  return updatedContent + content.slice(position);
+};
+
+export interface CellChange {
+  // Spaltenname (bei doppelten Namen "#<Index>")
+  column: string;
+  oldValue: string;
+  newValue: string;
+}
+
+// Schlüssel einer Spalte im Änderungsjournal: der Name, bei doppelten Namen die Position
+const columnKey = (schema: SpecItemSchema, index: number): string => {
+  const name = schema.columns[index]?.name;
+  return name && schema.indexOf(name) === index ? name : `#${index}`;
+};
+
+const columnOfKey = (schema: SpecItemSchema, key: string): number =>
+  key.startsWith('#') ? Number(key.substring(1)) : schema.indexOf(key);
+
+/**
+ * Zellen, die die Änderungen eines Items in seiner Zeile von Spec_item.txt ändern (Feld-Diff)
+ * Verglichen wird mit der Zeile in der Datei; bis auf Leerraum gleiche Werte gelten als unverändert.
+ * @param pending Bereits vorgemerkte Werte der Zeile (Spalte -> Wert); diese Spalten werden immer
+ * gemeldet, damit ein wieder auf den alten Wert gesetztes Feld aus dem Journal entfällt
+ * @returns null, wenn das Item nicht in der Datei steht
+ */
+export const diffItemCells = (
+  item: any,
+  rowIndex: SpecItemRowIndex,
+  pending?: Map<string, string>
+): CellChange[] | null => {
+  const span = item?.id ? rowIndex.find(item.id) : null;
+  if (!span) return null;
+  
+  const schema = rowIndex.schema;
+  const fileColumns = rowIndex.content.slice(span.start, span.end).split('\t');
+  const columns = fileColumns.slice();
+  pending?.forEach((value, key) => setColumn(columns, schema, columnOfKey(schema, key), value));
+  applyItemChangesToColumns(columns, item, schema);
+  const updated = fixItemIconCells(columns.join('\t')).split('\t');
+  
+  const changes: CellChange[] = [];
+  for (let i = 0; i < updated.length; i++) {
+    const key = columnKey(schema, i);
+    const oldValue = (fileColumns[i] ?? "").trim();
+    if (oldValue === updated[i].trim() && !pending?.has(key)) continue;
+    changes.push({ column: key, oldValue, newValue: oldValue === updated[i].trim() ? oldValue : updated[i] });
+  }
+  return changes;
+};
+
+/**
+ * Setzt vorgemerkte Zellen (Spalte -> Wert) in den Text einer Spec_item-Zeile ein
+ */
+export const applyCellsToRow = (rowText: string, cells: Map<string, string>, schema: SpecItemSchema): string => {
+  const columns = rowText.split('\t');
+  cells.forEach((value, key) => setColumn(columns, schema, columnOfKey(schema, key), value));
+  return columns.join('\t');
+};
+
+/**
+ * Wert einer Zelle (Spaltenschlüssel wie im Änderungsjournal) in einer Spec_item-Zeile, getrimmt
+ * Fehlt die Zelle, gilt der Standardwert der Spalte (wie beim Auffüllen durch setColumn).
+ * @returns undefined, wenn es die Spalte in dieser Version der Datei nicht gibt
+ */
+export const readRowCell = (rowText: string, key: string, schema: SpecItemSchema): string | undefined => {
+  const column = columnOfKey(schema, key);
+  if (column < 0 || !Number.isInteger(column)) return undefined;
+  const columns = rowText.split('\t');
+  return (columns[column] ?? schema.columns[column]?.defaultValue ?? "=").trim();
+};
+
+/**
+ * Neue Texte der Zeilen mit vorgemerkten Zellen, nach Position sortiert
+ * @returns null ohne Spec_item-Kopfzeile
+ */
+const collectCellEdits = (
+  rows: Map<string, Map<string, string>>,
+  originalContent: string
+): RowEdit[] | null => {
+  const rowIndex = getSpecItemRowIndex(originalContent);
+  if (!rowIndex) {
+    console.warn("Keine Spec_item-Kopfzeile gefunden, Änderungen werden nicht angewendet");
+    return null;
+  }
+  
+  const schema = rowIndex.schema;
+  const edits: RowEdit[] = [];
+  rows.forEach((cells, itemId) => {
+    const span = rowIndex.find(itemId);
+    if (!span) {
+      console.warn(`Item ${itemId} nicht in der Datei gefunden, Änderungen werden nicht angewendet`);
+      return;
     }
+    const oldText = originalContent.slice(span.start, span.end);
+    const text = applyCellsToRow(oldText, cells, schema);
+    if (text !== oldText) edits.push({ start: span.start, end: span.end, text });
   });
+  edits.sort((a, b) => a.start - b.start);
   
-  console.log(`${itemIdToLineMap.size} Items in der Datei lokalisiert`);
+  console.log(`${rows.size} Items mit vorgemerkten Änderungen, ${edits.length} Zeilen geändert`);
+  return edits;
+};
+
+/**
+ * Schreibt vorgemerkte Zellen (Item-ID -> Spalte -> Wert) in die Zeilen von Spec_item.txt
+ * Nur die betroffenen Zeilen werden neu zusammengesetzt, alle anderen bleiben byte-genau.
+ * @returns Der neue Inhalt (originalContent selbst, wenn sich keine Zeile ändert)
+ */
+export const applySpecItemCells = (
+  rows: Map<string, Map<string, string>>,
+  originalContent: string
+): string => {
+  const edits = collectCellEdits(rows, originalContent);
+  return edits ? applyRowEdits(originalContent, edits) : originalContent;
+};
+
+/**
+ * Wie applySpecItemCells, gibt den Inhalt aber in Teilen an write weiter, statt ihn als einen
+ * String zusammenzusetzen (gestreamtes Speichern, siehe saveStream.ts): die unveränderten
+ * Abschnitte werden aus originalContent geschnitten, dazwischen folgen die neuen Zeilen.
+ * @param write Erhält die Teile der Reihe nach (etwa SAVE_CHUNK_SIZE Zeichen)
+ */
+export const writeSpecItemCells = async (
+  rows: Map<string, Map<string, string>>,
+  originalContent: string,
+  write: (text: string) => Promise<void>
+): Promise<void> => {
+  const edits = collectCellEdits(rows, originalContent) ?? [];
+  
+  const chunks = createChunkWriter(write);
+  const writeUnchanged = (start: number, end: number) =>
+    writeTextChunks(originalContent, chunks.push, start, end);
+  
+  let position = 0;
+  for (const edit of edits) {
+    await writeUnchanged(position, edit.start);
+    await chunks.push(edit.text);
+    position = edit.end;
+  }
+  await writeUnchanged(position, originalContent.length);
+  await chunks.flush();
+};
+
+/**
+ * Items mit Änderungen, die in Spec_item.txt geschrieben werden
+ */
+const getItemsWithChanges = (items: any[]): any[] => items.filter(item => 
+  item && (
+    item.displayName !== undefined || 
+    item.description !== undefined ||
+    item.fields?.specItem?.define !== undefined ||
+    item.fields?.specItem?.itemIcon !== undefined ||
+    item.fields?.mdlDyna?.fileName !== undefined ||
+    (item.effects && item.effects.length > 0) || // Hinzugefügt: Prüfe auf Effekte
+    (item.data && typeof item.data === 'object') // Spaltenwerte, siehe applyItemChangesToColumns
+  )
+);
+
+interface RowEdit {
+  // Zeichenbereich der alten Zeile (ohne Zeilenende) und ihr neuer Text
+  start: number;
+  end: number;
+  text: string;
+}
+
+/**
+ * Neue Texte der geänderten Zeilen, nach Position sortiert (Zeilen ohne Unterschied fehlen)
+ */
+const collectRowEdits = (itemsWithChanges: any[], rowIndex: SpecItemRowIndex): RowEdit[] => {
+  const content = rowIndex.content;
   
-  // Jetzt machen wir selektive Änderungen nur an den Zeilen, die wirklich geändert werden müssen
-  const updatedLines = [...lines];
+  // Zeile -> Spalten; mehrere Items mit derselben Zeile werden nacheinander angewendet
+  const changedRows = new Map<number, { start: number; end: number; columns: string[] }>();
+  let missingCount = 0;
   
-  // Für jedes Item mit Änderungen
   for (const item of itemsWithChanges) {
     if (!item || !item.id) continue;
     
-    const itemId = item.id;
-    console.log(`Verarbeite Änderungen für Item ${itemId}`);
-    
-    // Wenn wir das Item in der Datei gefunden haben
-    if (itemIdToLineMap.has(itemId)) {
-      const fieldMap = fieldPositionMap.get(itemId);
-      if (!fieldMap) continue;
-      
-      // Teile die Zeile in Spalten auf
-      const columns = updatedLines[itemIdToLineMap.get(itemId)!].split('\t');
-      
-      // Aktualisiere die Felder
-      if (item.fields?.specItem?.define !== undefined) {
-        const fieldInfo = fieldMap.get('define');
-        if (fieldInfo) {
-          columns[1] = item.fields.specItem.define;
-        }
-      }
-      
-      if (item.fields?.specItem?.itemIcon !== undefined) {
-        const fieldInfo = fieldMap.get('itemIcon');
-        if (fieldInfo) {
-          // Stelle sicher, dass das Item Icon korrekt formatiert ist (mit dreifachen Anführungszeichen)
-          // Direkter Aufruf von formatItemIconValue
-          const iconValue = item.fields.specItem.itemIcon;
-          // Entferne alle Anführungszeichen und füge dreifache hinzu
-          const cleanIcon = iconValue.replace(/^["']{0,3}|["']{0,3}$/g, '');
-          const formattedIcon = `"""${cleanIcon}"""`;
-          
-          columns[2] = formattedIcon;
-          console.log(`Item Icon formatiert: "${columns[2]}"`);
-        }
-      }
-      
-      if (item.fields?.specItem?.displayName !== undefined || item.displayName !== undefined) {
-        const fieldInfo = fieldMap.get('displayName');
-        if (fieldInfo) {
-          columns[3] = item.fields?.specItem?.displayName || item.displayName;
-        }
-      }
-      
-      if (item.fields?.specItem?.description !== undefined || item.description !== undefined) {
-        const fieldInfo = fieldMap.get('description');
-        if (fieldInfo) {
-          columns[4] = item.fields?.specItem?.description || item.description;
-        }
-      }
-      
-      // Hinzugefügt: Prüfe und aktualisiere dwAbilityMin und dwAbilityMax, wenn vorhanden
-      if (item.data?.dwAbilityMin !== undefined) {
-        console.log(`Aktualisiere dwAbilityMin für Item ${itemId}: ${item.data.dwAbilityMin}`);
-        // Annahme: dwAbilityMin ist die 20. Spalte (0-indexiert) in der Spec_item.txt
-        const dwAbilityMinIndex = 20;
-        // Stelle sicher, dass die Spalten-Arrays groß genug sind
-        while (columns.length <= dwAbilityMinIndex) {
-          columns.push("=");
-        }
-        columns[dwAbilityMinIndex] = item.data.dwAbilityMin === "" ? "=" : String(item.data.dwAbilityMin);
+    const span = rowIndex.find(item.id);
+    if (!span) {
+      if (missingCount++ < 10) {
+        console.warn(`Item ${item.id} nicht in der Original-Datei gefunden, Änderungen werden nicht angewendet`);
       }
+      continue;
+    }
+    
+    let row = changedRows.get(span.line);
+    if (!row) {
+      row = { start: span.start, end: span.end, columns: content.slice(span.start, span.end).split('\t') };
+      changedRows.set(span.line, row);
+    }
+    applyItemChangesToColumns(row.columns, item, rowIndex.schema);
+  }
+  
+  if (missingCount > 0) {
+    console.warn(`${missingCount} Items nicht in der Original-Datei gefunden`);
+  }
+  
+  // Item Icons nur in geänderten Zeilen formatieren, alle anderen Zeilen bleiben byte-genau
+  const edits: RowEdit[] = [];
+  for (const row of changedRows.values()) {
+    const text = fixItemIconCells(row.columns.join('\t'));
+    if (text !== content.slice(row.start, row.end)) {
+      edits.push({ start: row.start, end: row.end, text });
+    }
+  }
+  edits.sort((a, b) => a.start - b.start);
+  
+  console.log(`${changedRows.size} Items in der Datei lokalisiert, ${edits.length} Zeilen geändert`);
+  return edits;
+};
+
+// Muss eine Zelle mit ".dds" noch in dreifache Anführungszeichen gesetzt werden?
+// Schnelle Prüfung ohne die Zeile zu teilen (fast alle Icons sind bereits formatiert)
+const needsIconFix = (line: string): boolean => {
+  for (let hit = line.indexOf('.dds'); hit !== -1; hit = line.indexOf('.dds', hit + 4)) {
+    const cellStart = line.lastIndexOf('\t', hit) + 1;
+    const tab = line.indexOf('\t', hit);
+    const cellEnd = tab === -1 ? line.length : tab;
+    if (!line.startsWith('"""', cellStart) && !line.startsWith('"""', cellEnd - 3)) return true;
+  }
+  return false;
+};
+
+/**
+ * Setzt Item Icons (Zellen mit ".dds") einer Zeile in dreifache Anführungszeichen
+ * @param line Eine Zeile ohne Zeilenende
+ */
+export const fixItemIconCells = (line: string): string => {
+  if (!needsIconFix(line)) return line;
+  
+  // Teile die Zeile in Tabs
+  const parts = line.split('\t');
+  if (parts.length <= 2) return line;
+  
+  for (let i = 0; i < parts.length; i++) {
+    // Prüfe, ob der Teil ein Icon sein könnte
+    if (parts[i] && parts[i].includes('.dds') && !parts[i].startsWith('"""') && !parts[i].endsWith('"""')) {
+      // Entferne alle vorhandenen Anführungszeichen
+      const cleanIcon = parts[i].replace(/^["']{0,3}|["']{0,3}$/g, '');
       
-      if (item.data?.dwAbilityMax !== undefined) {
-        console.log(`Aktualisiere dwAbilityMax für Item ${itemId}: ${item.data.dwAbilityMax}`);
-        // Annahme: dwAbilityMax ist die 21. Spalte (0-indexiert) in der Spec_item.txt
-        const dwAbilityMaxIndex = 21;
-        // Stelle sicher, dass die Spalten-Arrays groß genug sind
-        while (columns.length <= dwAbilityMaxIndex) {
-          columns.push("=");
-        }
-        columns[dwAbilityMaxIndex] = item.data.dwAbilityMax === "" ? "=" : String(item.data.dwAbilityMax);
+      // Formatiere das Icon korrekt mit dreifachen Anführungszeichen
+      parts[i] = `"""${cleanIcon}"""`;
+      console.log(`Icon in Zeile korrigiert: ${cleanIcon} -> ${parts[i]}`);
+    }
+  }
+  
+  return parts.join('\t');
+};
+
+/**
+ * Setzt eine Zelle; kürzere Zeilen werden mit den Standardwerten der Spalten aufgefüllt
+ * @param column -1 (Spalte fehlt in dieser Version) wird ignoriert
+ */
+const setColumn = (columns: string[], schema: SpecItemSchema, column: number, value: string): void => {
+  if (column < 0 || !Number.isInteger(column)) return;
+  while (columns.length <= column) {
+    columns.push(schema.columns[columns.length]?.defaultValue ?? "=");
+  }
+  columns[column] = value;
+};
+
+/**
+ * Überträgt die Änderungen eines Items in die Spalten seiner Zeile
+ * Alle Spalten des Schemas (specItemSchema.ts) werden aus item.data übernommen, wenn sich der
+ * Wert von der Zelle unterscheidet; danach gelten Define, Item Icon und die Effekte. Fehlt eine
+ * Spalte in der Version der Datei, wird die Änderung nicht geschrieben.
+ */
+const applyItemChangesToColumns = (columns: string[], item: any, schema: SpecItemSchema): void => {
+  const setCell = (column: number, value: string) => setColumn(columns, schema, column, value);
+  const slots = schema.effectSlots;
+  // Effekte wurden getrennt von den Daten bearbeitet (EffectsSection), wenn sie von denen der Zeile
+  // abweichen: dann gelten sie für die Effekt-Spalten, sonst die Werte aus item.data (StatsSection)
+  const cell = (column: number) => (columns[column] ?? schema.columns[column]?.defaultValue ?? "=").trim();
+  const effectsEdited = Array.isArray(item.effects) && !effectsMatchRow(item.effects, slots, cell);
+  
+  // Zeilensichten, in die seit dem Laden nicht geschrieben wurde, haben die Werte der Datei
+  const target = getRowViewTarget(item.data);
+  const store = target?.store.schema === schema ? target.store : null;
+  if (item.data && typeof item.data === 'object' && !(store && !store.isRowWritten(target!.row))) {
+    const effectColumns = effectsEdited ? new Set(slots.flatMap(slot => [slot.typeColumn, slot.valueColumn])) : null;
+    // Zeilensichten auf einen Speicher mit diesem Schema direkt über den Spaltenindex lesen
+    for (const column of schema.dataColumns) {
+      const value = store ? store.get(target!.row, column.index) : item.data[column.name];
+      if (value === undefined || value === null || effectColumns?.has(column.index)) continue;
+      const text = value === "" ? column.defaultValue : String(value);
+      const current = columns[column.index];
+      if (text === current) continue;
+      if (text.trim() !== (current ?? column.defaultValue).trim()) {
+        setCell(column.index, text);
       }
+    }
+  }
+  
+  // Das Define ist der Wert der ID-Spalte
+  if (item.fields?.specItem?.define !== undefined && schema.idColumn < columns.length) {
+    setCell(schema.idColumn, item.fields.specItem.define);
+  }
+  
+  if (item.fields?.specItem?.itemIcon !== undefined && schema.iconColumn < columns.length) {
+    // Stelle sicher, dass das Item Icon korrekt formatiert ist (mit dreifachen Anführungszeichen)
+    // Entferne alle Anführungszeichen und füge dreifache hinzu
+    const cleanIcon = item.fields.specItem.itemIcon.replace(/^["']{0,3}|["']{0,3}$/g, '');
+    setCell(schema.iconColumn, `"""${cleanIcon}"""`);
+  }
+  
+  // Anzeigename und Beschreibung stehen nicht in Spec_item.txt (szName/szComment verweisen nur
+  // auf die Texte), sie werden über serializePropItems in propItem.txt.txt geschrieben
+  
+  // dwDestParamN und nAdjParamValN aus den bearbeiteten Effekten
+  if (effectsEdited) {
+    // Zuerst alle Effekt-Spalten auf ihren Standardwert setzen, um alte Werte zu löschen
+    for (const slot of slots) {
+      setCell(slot.typeColumn, schema.columns[slot.typeColumn].defaultValue);
+      setCell(slot.valueColumn, schema.columns[slot.valueColumn].defaultValue);
+    }
+    
+    if (item.effects.length > slots.length) {
+      console.warn(`Item ${item.id} hat ${item.effects.length} Effekte, die Datei hat nur ${slots.length} Effekt-Spalten`);
+    }
+    
+    // Durchlaufe alle vorhandenen Effekte (höchstens so viele, wie die Datei Spalten hat)
+    for (let i = 0; i < Math.min(item.effects.length, slots.length); i++) {
+      const effect = item.effects[i];
       
-      // Hinzugefügt: Aktualisiere dwDestParam1-6 und nAdjParamVal1-6 basierend auf den Effekten
-      if (item.effects && Array.isArray(item.effects)) {
-        console.log(`Aktualisiere Effekte für Item ${itemId}: ${JSON.stringify(item.effects)}`);
-        
-        // Zuerst setze alle Effekt-Spalten auf NONE/_NONE oder leer, um alte Werte zu löschen
-        for (let i = 0; i < 6; i++) {
-          // Position in columns berechnen: dwDestParam1 ist in column 82 (0-indexiert)
-          const dwDestParamIndex = 82 + i;
-          // Position in columns berechnen: nAdjParamVal1 ist in column 88 (0-indexiert)
-          const nAdjParamValIndex = 88 + i;
-          
-          // Stelle sicher, dass die Spalten-Arrays groß genug sind
-          while (columns.length <= nAdjParamValIndex) {
-            columns.push("=");
-          }
-          
-          // Setze Standardwerte
-          columns[dwDestParamIndex] = "_NONE";
-          columns[nAdjParamValIndex] = "=";
-        }
-        
-        // Durchlaufe alle vorhandenen Effekte (maximal 6)
-        for (let i = 0; i < Math.min(item.effects.length, 6); i++) {
-          const effect = item.effects[i];
-          
-          if (!effect || !effect.type || effect.type === '-' || effect.type === '_NONE') {
-            continue; // Überspringe leere oder ungültige Effekte
-          }
-          
-          // dwDestParam Feld aktualisieren (1-indexiert im Spaltennamen, aber 0-indexiert im Array)
-          const dwDestParamIndex = 82 + i;
-          // nAdjParamVal Feld aktualisieren
-          const nAdjParamValIndex = 88 + i;
-          
-          // Stelle sicher, dass die Spalten-Arrays groß genug sind
-          while (columns.length <= nAdjParamValIndex) {
-            columns.push("=");
-          }
-          
-          // Setze den Typ und Wert wenn vorhanden
-          if (effect.type && effect.type !== '-') {
-            columns[dwDestParamIndex] = effect.type;
-            columns[nAdjParamValIndex] = effect.value !== undefined ? effect.value.toString() : "0";
-            console.log(`Setze Effekt ${i+1} für Item ${itemId}: ${effect.type}=${effect.value}`);
-          }
-        }
+      if (!isEffectSet(effect?.type)) {
+        continue; // Überspringe leere oder ungültige Effekte
       }
       
-      // Setze die Zeile wieder zusammen
-      updatedLines[itemIdToLineMap.get(itemId)!] = columns.join('\t');
-    } else {
-      console.warn(`Item ${itemId} nicht in der Original-Datei gefunden, Änderungen werden nicht angewendet`);
+      setCell(slots[i].typeColumn, effect.type);
+      setCell(slots[i].valueColumn, effect.value !== undefined ? effect.value.toString() : "0");
     }
   }
-  
-  // Setze die aktualisierten Zeilen wieder zu einem String zusammen
-  updatedContent = updatedLines.join('\n');
-  
-  return updatedContent;
+};
+
+const isEffectSet = (type: any): boolean => !!type && type !== '-' && type !== '_NONE' && type !== '=';
+
+/**
+ * Entsprechen die Effekte denen, die sich aus den Effekt-Spalten der Zeile ergeben
+ * (wie extractEffectsFromData beim Parsen)?
+ */
+const effectsMatchRow = (effects: any[], slots: EffectSlot[], cell: (column: number) => string): boolean => {
+  const set = effects.filter(effect => isEffectSet(effect?.type));
+  let count = 0;
+  for (const { typeColumn, valueColumn } of slots) {
+    const type = cell(typeColumn);
+    if (!isEffectSet(type)) continue;
+    const effect = set[count++];
+    if (!effect || String(effect.type).trim() !== type || String(effect.value ?? '0').trim() !== (cell(valueColumn) || '0')) {
+      return false;
+    }
+  }
+  return count === set.length;
 };
 
 /**
@@ -333,6 +509,7 @@ function escapeRegExp(string: string): string {
 /**
  * Serialisiert für propItem.txt.txt Dateien
  * @param items Items mit Name und Beschreibung
+ * @param existingContent Bisheriger Inhalt der Datei; ohne ihn entsteht eine Datei nur aus den Einträgen der Items
  * @returns String im propItem.txt.txt Format
  */
 export const serializePropItems = (
@@ -357,88 +534,154 @@ export const serializePropItems = (
   }
   
   // Sammle alle zu speichernden Entries
-  const entries: Map<string, string> = new Map();
+  const entries = collectPropItemEntries(modifiedItems);
+  
+  if (entries.size === 0) {
+    console.warn("Keine Einträge für propItem.txt.txt gefunden");
+    return existingContent || "";
+  }
   
-  // Wenn ein bestehender Inhalt übergeben wurde, verwenden wir diesen als Basis
+  // Mit bestehendem Inhalt nur die geänderten Einträge darin ersetzen (byte-genau, siehe roundTrip.ts)
   if (existingContent && typeof existingContent === 'string' && existingContent.length > 0) {
-    // Parse bestehenden Inhalt
-    const existingLines = existingContent.split(/\r?\n/);
+    const result = applyPropItemEntries(existingContent, entries);
+    console.log(`propItem.txt.txt: ${result.changed} Einträge geändert, ${result.added} angehängt`);
+    return result.content;
+  }
+  
+  // Sortiere die Einträge nach ID
+  const sortedEntries = Array.from(entries.entries()).sort((a, b) => {
+    const idA = parseInt(a[0].match(/\d+/)?.[0] || "0", 10);
+    const idB = parseInt(b[0].match(/\d+/)?.[0] || "0", 10);
+    return idA - idB;
+  });
+  
+  // Erzeuge den finalen Inhalt
+  const lines = sortedEntries.map(([id, value]) => `${id}\t${value}`);
+  
+  console.log(`${lines.length} Zeilen für propItem.txt.txt erzeugt`);
+  
+  // Für Windows-Kompatibilität CRLF-Zeilenenden verwenden
+  return lines.join('\r\n');
+}; 
+
+/**
+ * Überträgt propItem-Einträge (ID -> Text) in den bestehenden Inhalt von propItem.txt.txt
+ * Ersetzt wird nur die Textspalte geänderter Einträge; weitere Spalten, Tabs am Zeilenende und
+ * die Zeilenenden bleiben erhalten. Fehlende Einträge werden angehängt.
+ * @returns Neuer Inhalt (existingContent selbst, wenn sich nichts ändert) und die Zahl der Änderungen
+ */
+export const applyPropItemEntries = (
+  existingContent: string,
+  entries: Map<string, string>
+): { content: string; changed: number; added: number } => {
+  const found = new Set<string>();
+  let changed = 0;
+  
+  const content = editLines(existingContent, line => {
+    const tab = line.indexOf('\t');
+    if (tab === -1) return undefined;
     
-    // Extrahiere alle bestehenden Einträge
-    existingLines.forEach(line => {
-      const parts = line.split('\t');
-      if (parts.length >= 2) {
-        entries.set(parts[0], parts[1]);
-      }
-    });
+    const id = line.slice(0, tab).trim();
+    const value = entries.get(id);
+    if (value === undefined) return undefined;
+    found.add(id);
     
-    console.log(`${entries.size} bestehende Einträge extrahiert`);
-  }
+    const valueEnd = line.indexOf('\t', tab + 1);
+    const oldValue = valueEnd === -1 ? line.slice(tab + 1) : line.slice(tab + 1, valueEnd);
+    // Die Parser trimmen die Werte: bis auf Leerraum gleiche Werte gelten als unverändert
+    if (oldValue.trim() === value.trim()) return undefined;
+    
+    changed++;
+    return line.slice(0, tab + 1) + value + (valueEnd === -1 ? "" : line.slice(valueEnd));
+  });
   
-  // Verarbeite alle Items
-  modifiedItems.forEach(item => {
-    if (!item) {
-      console.warn("Ungültiges Item (null/undefined) gefunden");
-      return;
-    }
+  const missing: string[] = [];
+  entries.forEach((value, id) => {
+    if (!found.has(id)) missing.push(`${id}\t${value}`);
+  });
+  
+  return {
+    // Neue Dateien und Dateien ohne Zeilenumbruch bekommen CRLF (Windows-Kompatibilität)
+    content: appendLines(content, missing, detectLineEnding(existingContent, '\r\n')),
+    changed,
+    added: missing.length
+  };
+};
+
+/**
+ * propItem-Einträge (ID -> Text) für Anzeigename und Beschreibung der Items
+ * Der Name steht unter der ID aus szName, die Beschreibung unter der folgenden ID.
+ */
+export const collectPropItemEntries = (items: any[]): Map<string, string> => {
+  const entries = new Map<string, string>();
+  
+  items.forEach(item => {
+    if (!item || (item.displayName === undefined && item.description === undefined)) return;
     
-    // Get the ID from the item's propItem ID
     const propItemId = (item.data?.szName || item.id) as string;
-    if (!propItemId) {
-      console.warn("Item mit leerer ID gefunden");
-      return;
-    }
-    
-    const idMatch = propItemId.match(/IDS_PROPITEM_TXT_(\d+)/);
+    const idMatch = typeof propItemId === 'string' ? propItemId.match(/IDS_PROPITEM_TXT_(\d+)/) : null;
     if (!idMatch) {
       console.warn(`Ungültige PropItem ID: ${propItemId}`);
       return;
     }
     
     const baseId = parseInt(idMatch[1], 10);
-    if (isNaN(baseId)) {
-      console.warn(`Ungültige Basis-ID: ${idMatch[1]}`);
-      return;
-    }
+    if (isNaN(baseId)) return;
     
-    // Füge Namen hinzu, wenn vorhanden
     if (item.displayName !== undefined) {
-      const nameId = `IDS_PROPITEM_TXT_${baseId.toString().padStart(6, '0')}`;
-      const entryName = item.displayName || item.name || '';
-      
-      // Immer den neuen Wert setzen, unabhängig vom alten Wert
-      entries.set(nameId, entryName);
-      console.log(`PropItem Name: ${nameId} = "${entryName}"`);
+      entries.set(`IDS_PROPITEM_TXT_${baseId.toString().padStart(6, '0')}`, item.displayName || item.name || '');
     }
-    
-    // Füge Beschreibung hinzu, wenn vorhanden
     if (item.description !== undefined) {
-      const descId = `IDS_PROPITEM_TXT_${(baseId + 1).toString().padStart(6, '0')}`;
-      const descriptionText = item.description || '';
-      
-      // Immer den neuen Wert setzen, unabhängig vom alten Wert
-      entries.set(descId, descriptionText);
-      console.log(`PropItem Beschreibung: ${descId} = "${descriptionText.substring(0, Math.min(30, descriptionText.length))}${descriptionText.length > 30 ? '...' : ''}"`);
+      entries.set(`IDS_PROPITEM_TXT_${(baseId + 1).toString().padStart(6, '0')}`, item.description || '');
     }
   });
   
-  if (entries.size === 0) {
-    console.warn("Keine Einträge für propItem.txt.txt gefunden");
-    return "";
+  return entries;
+};
+
+// Einträge (ID -> Text) des zuletzt gelesenen Stands von propItem.txt.txt
+let lastPropItemEntries: { content: string; entries: Map<string, string> } | null = null;
+
+/**
+ * Alle Einträge eines Stands von propItem.txt.txt (ID -> Text, getrimmt, erstes Vorkommen)
+ * Ein Durchlauf je Stand: solange derselbe Inhalt übergeben wird, wird die Tabelle wiederverwendet.
+ */
+const getPropItemEntries = (content: string): Map<string, string> => {
+  if (lastPropItemEntries && lastPropItemEntries.content === content) return lastPropItemEntries.entries;
+  
+  const entries = new Map<string, string>();
+  let lineStart = 0;
+  while (lineStart < content.length) {
+    const newline = content.indexOf('\n', lineStart);
+    const lineEnd = newline === -1 ? content.length : newline;
+    const tab = content.indexOf('\t', lineStart);
+    
+    if (tab !== -1 && tab < lineEnd) {
+      const id = content.slice(lineStart, tab).trim();
+      if (!entries.has(id)) {
+        const nextTab = content.indexOf('\t', tab + 1);
+        entries.set(id, content.slice(tab + 1, nextTab !== -1 && nextTab < lineEnd ? nextTab : lineEnd).trim());
+      }
+    }
+    
+    if (newline === -1) break;
+    lineStart = newline + 1;
   }
   
-  // Sortiere die Einträge nach ID
-  const sortedEntries = Array.from(entries.entries()).sort((a, b) => {
-    const idA = parseInt(a[0].match(/\d+/)?.[0] || "0", 10);
-    const idB = parseInt(b[0].match(/\d+/)?.[0] || "0", 10);
-    return idA - idB;
+  lastPropItemEntries = { content, entries };
+  return entries;
+};
+
+/**
+ * Texte einzelner Einträge aus propItem.txt.txt (getrimmt, wie sie der Parser liest)
+ * @returns ID -> Text; IDs, die in der Datei fehlen, sind nicht enthalten
+ */
+export const readPropItemEntries = (content: string, ids: Set<string>): Map<string, string> => {
+  const entries = getPropItemEntries(content);
+  const values = new Map<string, string>();
+  ids.forEach(id => {
+    const value = entries.get(id);
+    if (value !== undefined) values.set(id, value);
   });
-  
-  // Erzeuge den finalen Inhalt
-  const lines = sortedEntries.map(([id, value]) => `${id}\t${value}`);
-  
-  console.log(`${lines.length} Zeilen für propItem.txt.txt erzeugt`);
-  
-  // Für Windows-Kompatibilität CRLF-Zeilenenden verwenden
-  return lines.join('\r\n');
-}; 
\ No newline at end of file
+  return values;
+};
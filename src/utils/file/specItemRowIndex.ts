@@ -0,0 +1,135 @@
+/**
+ * Zeilenindex für Spec_item.txt: dwID -> Zeile und Zeichenbereich im Inhalt
+ *
+ * Der Serialisierer muss für jedes geänderte Item genau dessen Zeile finden. Früher wurde
+ * dafür jede Zeile mit line.includes(itemId) gegen jedes geänderte Item geprüft
+ * (Zeilen x Änderungen, und "21" passte auf jede Zeile mit einer 21). Der Index wird beim
+ * Parsen einmal aufgebaut und ordnet jede ID exakt ihrer Zeile zu, mit denselben Regeln
+ * wie parseSpecItemRows:
+ *  - Zeile getrimmt, Zellen durch Tabs getrennt, Zeilen mit weniger als 2 Zellen zählen nicht
+ *  - ID aus der Spalte "//dwID"/"dwID"; ohne ID, aber mit szName: "auto_<Zeilennummer>"
+ *  - bei doppelten IDs gilt die erste Zeile (wie beim Nachschlagen im Editor)
+ */
+
+import { type SpecItemSchema, getSpecItemSchema } from "./specItemSchema";
+
+export interface RowSpan {
+  // 0-basierte Zeilennummer
+  line: number;
+  // Zeichenbereich der Zeile ohne Zeilenende (exklusives Ende)
+  start: number;
+  end: number;
+}
+
+export class SpecItemRowIndex {
+  readonly content: string;
+  // Schema der Kopfzeile (Spaltenpositionen für den Serialisierer)
+  readonly schema: SpecItemSchema;
+  readonly idColumn: number;
+  // Zeichenposition des Beginns jeder Zeile
+  private readonly lineStarts: Uint32Array;
+  private readonly lines = new Map<string, number>();
+  duplicateCount = 0;
+
+  private constructor(content: string, header: string[]) {
+    this.content = content;
+    this.schema = getSpecItemSchema(header);
+    this.idColumn = this.schema.idColumn;
+
+    const starts: number[] = [];
+    let position = 0;
+    while (position <= content.length) {
+      starts.push(position);
+      const newline = content.indexOf('\n', position);
+      if (newline === -1) break;
+      position = newline + 1;
+    }
+    this.lineStarts = Uint32Array.from(starts);
+
+    if (this.idColumn === -1) return;
+
+    for (let line = 1; line < this.lineStarts.length; line++) {
+      const { start, end } = this.spanOf(line);
+      const id = readIdCell(content, start, end, this.idColumn);
+      if (!id) continue;
+      if (this.lines.has(id)) {
+        this.duplicateCount++;
+      } else {
+        this.lines.set(id, line);
+      }
+    }
+  }
+
+  /**
+   * Baut den Index für den Inhalt einer Spec_item.txt
+   * @returns null, wenn die erste Zeile keine Spec_item-Kopfzeile ist
+   */
+  static build(content: string): SpecItemRowIndex | null {
+    const firstLineEnd = content.indexOf('\n');
+    const firstLine = content.slice(0, firstLineEnd === -1 ? content.length : firstLineEnd)
+      .replace(/^\uFEFF/, '').replace(/\r$/, '');
+    if (!firstLine.includes('\t')) return null;
+    return new SpecItemRowIndex(content, firstLine.split('\t').map(cell => cell.trim()));
+  }
+
+  get lineCount(): number {
+    return this.lineStarts.length;
+  }
+
+  get size(): number {
+    return this.lines.size;
+  }
+
+  /**
+   * Zeile eines Items (dwID oder auto_<Zeile>)
+   * @returns Zeile und Zeichenbereich oder null, wenn die ID nicht vorkommt
+   */
+  find(itemId: string): RowSpan | null {
+    let line = this.lines.get(itemId);
+    if (line === undefined && itemId.startsWith('auto_')) {
+      const autoLine = Number(itemId.substring(5));
+      if (Number.isInteger(autoLine) && autoLine > 0 && autoLine < this.lineStarts.length) line = autoLine;
+    }
+    return line === undefined ? null : this.spanOf(line);
+  }
+
+  private spanOf(line: number): RowSpan {
+    const start = this.lineStarts[line];
+    let end = line + 1 < this.lineStarts.length ? this.lineStarts[line + 1] - 1 : this.content.length;
+    if (end > start && this.content.charCodeAt(end - 1) === 13) end--;
+    return { line, start, end };
+  }
+}
+
+const isAsciiSpace = (code: number): boolean => code === 32 || (code >= 9 && code <= 13);
+
+// Getrimmte Zelle einer Zeile lesen (Zeile vorher getrimmt wie im Parser)
+// @returns Die ID oder "" (auch bei Zeilen mit weniger als 2 Zellen)
+const readIdCell = (content: string, start: number, end: number, column: number): string => {
+  while (start < end && isAsciiSpace(content.charCodeAt(start))) start++;
+  while (end > start && isAsciiSpace(content.charCodeAt(end - 1))) end--;
+  const firstTab = content.indexOf('\t', start);
+  if (start === end || firstTab === -1 || firstTab >= end) return "";
+
+  let cellStart = start;
+  for (let i = 0; i < column; i++) {
+    const tab = content.indexOf('\t', cellStart);
+    if (tab === -1 || tab >= end) return "";
+    cellStart = tab + 1;
+  }
+  const tab = content.indexOf('\t', cellStart);
+  return content.slice(cellStart, tab === -1 || tab > end ? end : tab).trim();
+};
+
+// Index des zuletzt geparsten bzw. gespeicherten Inhalts
+let lastIndex: SpecItemRowIndex | null = null;
+
+/**
+ * Index für einen Inhalt (wiederverwendet, solange derselbe Inhalt übergeben wird)
+ */
+export const getSpecItemRowIndex = (content: string): SpecItemRowIndex | null => {
+  if (lastIndex && lastIndex.content === content) return lastIndex;
+  const index = SpecItemRowIndex.build(content);
+  if (index) lastIndex = index;
+  return index;
+};
@@ -0,0 +1,153 @@
+/**
+ * Kompiliertes Spaltenschema einer Spec_item.txt (aus der Kopfzeile)
+ *
+ * Die Kopfzeile ("//ver6	//dwID	szName	...") wird einmal in ein Schema übersetzt:
+ * Spaltenname -> Index, Typ und Standardwert. Parser, ColumnStore, Serialisierer und die
+ * Editor-Abschnitte greifen darüber mit vorberechneten Spaltenindizes zu, statt Positionen
+ * wie "dwAbilityMin ist Spalte 20" anzunehmen. Schemata werden je Kopfzeile zwischengespeichert,
+ * Dateien verschiedener Versionen (ver6, ver7, ...) bekommen also jeweils ihr eigenes Schema.
+ */
+
+// Typ einer Spalte nach dem Präfix des Spaltennamens (ungarische Notation der Quelldateien)
+//  - int:    b*, n*, w*, by* (Zahlen)
+//  - float:  f*
+//  - text:   sz* (in der Datei mit """...""" geschrieben)
+//  - symbol: dw* und alles übrige (Zahl oder #define-Name wie IK1_WEAPON, DST_STR)
+export type SchemaColumnType = 'int' | 'float' | 'text' | 'symbol';
+
+export interface SchemaColumn {
+  name: string;
+  index: number;
+  type: SchemaColumnType;
+  // Wert für leere Zellen ("=" bzw. """""" bei Textspalten)
+  defaultValue: string;
+}
+
+// Spaltenpaar eines Effekts (dwDestParamN / nAdjParamValN)
+export interface EffectSlot {
+  typeKey: string;
+  valueKey: string;
+  typeColumn: number;
+  valueColumn: number;
+}
+
+// Effekt-Spalten der ver6-Kopfzeile, falls eine Zeile keinem Schema zugeordnet ist
+const DEFAULT_EFFECT_SLOT_COUNT = 6;
+
+const columnTypeOf = (name: string): SchemaColumnType => {
+  const bare = name.replace(/^["/]+/, '');
+  if (bare.startsWith('sz')) return 'text';
+  if (/^f[A-Z]/.test(bare)) return 'float';
+  if (/^(b|n|w|by)[A-Z]/.test(bare)) return 'int';
+  return 'symbol';
+};
+
+export class SpecItemSchema {
+  readonly header: string[];
+  // Versionsnummer aus "//verN" in der ersten Spalte (null, wenn nicht angegeben)
+  readonly version: number | null;
+  readonly columns: SchemaColumn[];
+  // Eigenschaftsnamen in Objekt-Reihenfolge (erstes Vorkommen), inkl. "dwID"-Alias
+  readonly keys: string[] = [];
+  readonly hasIdAlias: boolean;
+
+  // Vorberechnete Spalten (-1, wenn die Version die Spalte nicht hat)
+  readonly idColumn: number;
+  readonly nameColumn: number;
+  readonly iconColumn: number;
+  readonly effectSlots: EffectSlot[];
+  // Spalten, deren Wert ein Item unter dem Spaltennamen in data führt (bei doppelten Namen die letzte)
+  readonly dataColumns: SchemaColumn[];
+
+  // Spaltenname -> Index (bei doppelten Namen gewinnt wie bei Objekten die letzte Spalte)
+  private readonly columnIndex = new Map<string, number>();
+
+  constructor(header: string[]) {
+    this.header = header;
+    const versionMatch = (header[0] || '').match(/^\/\/ver(\d+)$/i);
+    this.version = versionMatch ? Number(versionMatch[1]) : null;
+
+    this.columns = header.map((name, index) => {
+      const type = columnTypeOf(name);
+      return { name, index, type, defaultValue: type === 'text' ? '""""""' : '=' };
+    });
+
+    header.forEach((name, index) => {
+      if (!name) return;
+      if (!this.columnIndex.has(name)) {
+        this.keys.push(name);
+        if (name === '//dwID') this.keys.push('dwID');
+      }
+      this.columnIndex.set(name, index);
+    });
+    this.hasIdAlias = this.columnIndex.has('//dwID') && !this.columnIndex.has('dwID');
+    this.dataColumns = this.columns.filter(column => column.name && this.columnIndex.get(column.name) === column.index);
+
+    // ID und Name wie im Parser: erste passende Spalte
+    this.idColumn = header.findIndex(name => name === '//dwID' || name === 'dwID');
+    this.nameColumn = header.indexOf('szName');
+    this.iconColumn = this.indexOf('szIcon');
+
+    this.effectSlots = [];
+    for (let n = 1; ; n++) {
+      const typeKey = `dwDestParam${n}`;
+      const valueKey = `nAdjParamVal${n}`;
+      const typeColumn = this.indexOf(typeKey);
+      const valueColumn = this.indexOf(valueKey);
+      if (typeColumn === -1 || valueColumn === -1) break;
+      this.effectSlots.push({ typeKey, valueKey, typeColumn, valueColumn });
+    }
+  }
+
+  get columnCount(): number {
+    return this.columns.length;
+  }
+
+  /**
+   * Index einer Spalte (exakter Name, der ID-Spalte entspricht idColumn)
+   * @returns Der Index oder -1, wenn die Spalte in dieser Version fehlt
+   */
+  indexOf(name: string): number {
+    const index = this.columnIndex.get(name);
+    return index === undefined ? -1 : index;
+  }
+
+  column(name: string): SchemaColumn | undefined {
+    const index = this.indexOf(name);
+    return index === -1 ? undefined : this.columns[index];
+  }
+}
+
+// Kopfzeile -> Schema; mehrere Versionen können nebeneinander geladen sein
+const schemaCache = new Map<string, SpecItemSchema>();
+
+/**
+ * Schema für eine (getrimmte) Kopfzeile, wird je Kopfzeile nur einmal kompiliert
+ */
+export const getSpecItemSchema = (header: string[]): SpecItemSchema => {
+  const key = header.join('\t');
+  let schema = schemaCache.get(key);
+  if (!schema) {
+    schema = new SpecItemSchema(header);
+    schemaCache.set(key, schema);
+    if (schema.idColumn !== -1) {
+      console.log(`Spec_item-Schema ${schema.version !== null ? `ver${schema.version}` : 'ohne Version'}: ${schema.columnCount} Spalten, ${schema.effectSlots.length} Effekt-Slots`);
+    }
+  }
+  return schema;
+};
+
+const defaultEffectSlots: EffectSlot[] = Array.from({ length: DEFAULT_EFFECT_SLOT_COUNT }, (_, i) => ({
+  typeKey: `dwDestParam${i + 1}`,
+  valueKey: `nAdjParamVal${i + 1}`,
+  typeColumn: -1,
+  valueColumn: -1
+}));
+
+/**
+ * Effekt-Spalten für die Daten eines Items
+ * @param schema Schema der Datei, aus der die Daten stammen (ohne Schema: die sechs Slots von ver6)
+ */
+export const getEffectSlots = (schema?: SpecItemSchema | null): EffectSlot[] => {
+  return schema ? schema.effectSlots : defaultEffectSlots;
+};
@@ -0,0 +1,219 @@
+/**
+ * Paralleles Parsen von Spec_item.txt über einen Pool von Webworkern
+ *
+ * Die Datei wird als Bytes an Zeilengrenzen in Abschnitte geteilt; jeder Abschnitt
+ * wird als übertragbarer ArrayBuffer (ohne Kopie) an einen Worker geschickt.
+ * Die Ergebnisse werden in Zeilenreihenfolge zusammengeführt, danach werden die
+ * propItem-Namen im Hauptthread aufgelöst. Für kleine Dateien, Rechner mit wenigen Kernen,
+ * vom Parser-Prozess bereits gescannte Dateien oder ohne Worker-Unterstützung wird der
+ * sequentielle Parser verwendet.
+ *
+ * Der Hauptthread muss die Antworten deserialisieren und die Spalten zusammenführen; bei
+ * 9 MB sind das etwa die Hälfte der sequentiellen Parse-Zeit. Schneller als sequentiell wird
+ * es erst mit vielen Workern, daher die Schwellen unten.
+ */
+import { FileData, ResourceItem } from "../../types/fileTypes";
+import { attachColumnStore, hasPrescannedTable, isSpecItemHeader, parseFileBytes, parseFileContent, resolvePropItemNames, takePrescannedBytes } from "./parseUtils";
+import { ColumnStore } from "./columnStore";
+import { createInternScope } from "./stringPool";
+import { traceBegin, traceEnd, traceSync } from "../trace";
+import { getSpecItemRowIndex } from "./specItemRowIndex";
+import type { SpecItemShardRequest, SpecItemShardResponse } from "./workers/specItemParser.worker";
+
+// Ab dieser Größe lohnt sich das Verteilen auf Worker (kleinere Dateien sind sequentiell schneller)
+const PARALLEL_MIN_BYTES = 8 * 1024 * 1024;
+// Mindestanzahl Kerne; mit weniger Workern kostet das Zusammenführen mehr, als sie sparen
+const PARALLEL_MIN_CORES = 8;
+// Zielgröße eines Abschnitts; mehrere Abschnitte pro Worker gleichen unterschiedlich lange Zeilen aus
+const SHARD_TARGET_BYTES = 2 * 1024 * 1024;
+
+const textEncoder = new TextEncoder();
+
+let workerPool: Worker[] = [];
+
+const getCoreCount = (): number =>
+  typeof navigator !== 'undefined' && navigator.hardwareConcurrency ? navigator.hardwareConcurrency : 2;
+
+const getPoolSize = (): number => {
+  // Ein Kern bleibt für den UI-Thread frei
+  return Math.max(1, Math.min(getCoreCount() - 1, 8));
+};
+
+const getWorkers = (count: number): Worker[] => {
+  while (workerPool.length < count) {
+    workerPool.push(new Worker(new URL('./workers/specItemParser.worker.ts', import.meta.url), { type: 'module' }));
+  }
+  return workerPool.slice(0, count);
+};
+
+/**
+ * Beendet alle Worker des Pools (z.B. beim Schließen des Editors)
+ */
+export const terminateSpecItemWorkers = (): void => {
+  workerPool.forEach(worker => worker.terminate());
+  workerPool = [];
+};
+
+/**
+ * Teilt die Bytes hinter der Kopfzeile an Zeilenumbrüchen in Abschnitte
+ * @returns Start- und Endoffsets der Abschnitte
+ */
+export const findShardBoundaries = (bytes: Uint8Array, bodyStart: number, shardCount: number): [number, number][] => {
+  const shards: [number, number][] = [];
+  const bodyLength = bytes.length - bodyStart;
+  const targetSize = Math.ceil(bodyLength / shardCount);
+  let start = bodyStart;
+
+  while (start < bytes.length) {
+    let end = Math.min(start + targetSize, bytes.length);
+    if (end < bytes.length) {
+      const newline = bytes.indexOf(10, end);
+      end = newline === -1 ? bytes.length : newline + 1;
+    }
+    shards.push([start, end]);
+    start = end;
+  }
+
+  return shards;
+};
+
+/**
+ * Verteilt die Abschnitte auf die Worker; jeder Worker erhält nach Abschluss den nächsten freien Abschnitt
+ */
+const runShards = (
+  workers: Worker[],
+  shards: [number, number][],
+  bytes: Uint8Array,
+  header: string[],
+  encoding: string,
+  results: SpecItemShardResponse[]
+): Promise<void> => {
+  return new Promise<void>((resolve, reject) => {
+    let nextShard = 0;
+    let completed = 0;
+
+    const dispatch = (worker: Worker) => {
+      if (nextShard >= shards.length) return;
+
+      const shardIndex = nextShard++;
+      const [start, end] = shards[shardIndex];
+      // Eigene Kopie des Abschnitts, damit sie ohne weitere Kopie übertragen werden kann
+      const buffer = bytes.slice(start, end).buffer;
+      const request: SpecItemShardRequest = { shardIndex, buffer, header, encoding };
+      worker.postMessage(request, [buffer]);
+    };
+
+    workers.forEach(worker => {
+      worker.onmessage = (event: MessageEvent<SpecItemShardResponse>) => {
+        const response = event.data;
+        if (response.error) {
+          reject(new Error(`Worker-Fehler in Abschnitt ${response.shardIndex}: ${response.error}`));
+          return;
+        }
+
+        results[response.shardIndex] = response;
+        completed++;
+
+        if (completed === shards.length) {
+          resolve();
+        } else {
+          dispatch(worker);
+        }
+      };
+      worker.onerror = (event) => reject(new Error(event.message || 'Worker-Fehler'));
+      dispatch(worker);
+    });
+  });
+};
+
+/**
+ * Parst eine Textdatei; Spec_item.txt-Dateien ab PARALLEL_MIN_BYTES werden auf Rechnern mit
+ * mindestens PARALLEL_MIN_CORES Kernen auf Webworker verteilt
+ * @param content Inhalt als Text oder Rohdaten
+ * @param encoding Kodierung der Rohdaten
+ * @returns Die geparsten Daten, in gleicher Form wie parseTextFile
+ */
+export const parseTextFileParallel = async (content: string | ArrayBuffer, encoding: string = 'utf-8'): Promise<FileData> => {
+  // Der Parser-Prozess hat die Datei bereits gescannt, sequentiell bleibt nur noch das Parsen
+  if (typeof content === 'string' && hasPrescannedTable(content)) {
+    return parseFileContent(content);
+  }
+
+  // Vom Loader mitgelieferte Rohdaten statt den Text neu zu kodieren
+  const raw = typeof content === 'string' ? takePrescannedBytes(content) : null;
+  const bytes = raw ? raw.bytes : typeof content === 'string' ? textEncoder.encode(content) : new Uint8Array(content);
+  // Text wird als UTF-8 kodiert, Rohdaten behalten ihre Kodierung
+  const byteEncoding = raw ? raw.encoding : typeof content === 'string' ? 'utf-8' : encoding;
+
+  if (typeof Worker === 'undefined' || bytes.length < PARALLEL_MIN_BYTES || getCoreCount() < PARALLEL_MIN_CORES) {
+    return parseFileBytes(bytes, byteEncoding);
+  }
+
+  // Kopfzeile im Hauptthread lesen (BOM überspringen)
+  const bomLength = bytes[0] === 0xEF && bytes[1] === 0xBB && bytes[2] === 0xBF ? 3 : 0;
+  const headerEnd = bytes.indexOf(10, bomLength);
+  if (headerEnd === -1) {
+    return parseFileBytes(bytes, byteEncoding);
+  }
+
+  const firstLine = new TextDecoder(byteEncoding).decode(bytes.subarray(bomLength, headerEnd)).replace(/\r$/, '');
+  if (!isSpecItemHeader(firstLine)) {
+    return parseFileBytes(bytes, byteEncoding);
+  }
+
+  const header = firstLine.split("\t").map(h => h.trim());
+  const startTime = performance.now();
+  
+  // Zeilenindex für das Speichern (nur für Text; Rohdaten werden vor dem Speichern ohnehin dekodiert)
+  if (typeof content === 'string') {
+    traceSync("SpecItemRowIndex", "index", () => getSpecItemRowIndex(content));
+  }
+
+  const shardCount = Math.max(2, Math.ceil((bytes.length - headerEnd) / SHARD_TARGET_BYTES));
+  const shards = findShardBoundaries(bytes, headerEnd + 1, shardCount);
+  const workers = getWorkers(Math.min(getPoolSize(), shards.length));
+
+  console.log(`Parse Spec_item.txt parallel: ${shards.length} Abschnitte auf ${workers.length} Workern`);
+
+  const results: SpecItemShardResponse[] = new Array(shards.length);
+
+  const parseSpan = traceBegin("parseSpecItemFormat (parallel)", "parse");
+  try {
+    await runShards(workers, shards, bytes, header, byteEncoding, results);
+    traceEnd(parseSpan, { shards: shards.length, workers: workers.length });
+  } catch (error) {
+    // Pool verwerfen und sequentiell parsen, damit das Laden nicht scheitert
+    console.error("Paralleles Parsen fehlgeschlagen, verwende sequentiellen Parser:", error);
+    terminateSpecItemWorkers();
+    return parseFileBytes(bytes, byteEncoding);
+  }
+
+  // In Zeilenreihenfolge zusammenführen; auto_-IDs auf globale Zeilennummern umrechnen
+  const items: ResourceItem[] = [];
+  const stores: ColumnStore[] = [];
+  let lineOffset = 1;
+
+  results.forEach(result => {
+    stores.push(ColumnStore.fromSnapshot(result.columns!));
+    const shardItems = result.items as ResourceItem[];
+    for (const item of shardItems) {
+      if (item.id.startsWith('auto_')) {
+        item.id = `auto_${Number(item.id.substring(5)) + lineOffset}`;
+      }
+      items.push(item);
+    }
+    lineOffset += (result.lineCount || 1) - 1;
+  });
+
+  // Spalten der Abschnitte zusammenführen; die Effekte wurden bereits in den Workern extrahiert.
+  // Die Werte kommen als Kopien aus den Workern und werden hier in den gemeinsamen Pool übernommen.
+  const internScope = createInternScope("Spec_item.txt");
+  traceSync("ColumnStore.concat", "index", () =>
+    attachColumnStore(items, ColumnStore.concat(stores, internScope.intern), false)
+  );
+  traceSync("resolvePropItemNames", "index", () => resolvePropItemNames(items));
+  internScope.finish();
+
+  console.log(`Geparst: ${items.length} Items aus spec_item.txt Format (parallel, ${(performance.now() - startTime).toFixed(0)} ms)`);
+  return { header, items };
+};
@@ -0,0 +1,96 @@
+/**
+ * Gemeinsamer String-Pool (Symboltabelle) für alle Ressourcen-Parser
+ *
+ * Werte wie "=", "_NONE", "IK1_WEAPON" oder "SND_ITEM_ANIMAL" kommen tausendfach vor.
+ * Statt für jede Zelle einen eigenen String zu behalten, liefert intern() für gleiche
+ * Inhalte immer dieselbe Instanz; Vergleiche treffen dadurch sofort auf identische
+ * Referenzen und die Duplikate können vom GC freigegeben werden.
+ *
+ * Jeder Parser öffnet pro Datei einen Bereich (createInternScope) und meldet am Ende,
+ * wie viele Zellen bereits im Pool lagen und wie viel Speicher das ungefähr spart.
+ * Gezählt wird nur, was durch intern() läuft; Zellen aus dem Dekodier-Cache von TabTable
+ * sind schon dedupliziert und kommen dort gar nicht erst an (TabTable.setIntern).
+ * Der Pool gilt für einen Ladevorgang: loadPredefinedFiles leert ihn (clearStringPool).
+ */
+
+export interface InternStats {
+  fileName: string;
+  // Anzahl der durch den Pool gelaufenen Werte
+  cells: number;
+  // Werte, die bereits im Pool lagen
+  reused: number;
+  // Neu in den Pool aufgenommene Werte
+  added: number;
+  // Geschätzte Ersparnis in Bytes (Stringkopf + Inhalt je wiederverwendetem Wert)
+  savedBytes: number;
+}
+
+// Längere Werte (Beschreibungen, Kommentare) wiederholen sich praktisch nie
+const MAX_INTERN_LENGTH = 64;
+// Ungefähre Größe eines V8-Stringkopfs
+const STRING_HEADER_BYTES = 16;
+
+const pool = new Map<string, string>();
+const statsByFile = new Map<string, InternStats>();
+
+export class InternScope {
+  private readonly stats: InternStats;
+
+  constructor(fileName: string) {
+    this.stats = { fileName, cells: 0, reused: 0, added: 0, savedBytes: 0 };
+  }
+
+  /**
+   * Liefert die gemeinsame Instanz für value
+   */
+  intern = (value: string): string => {
+    if (value.length > MAX_INTERN_LENGTH) return value;
+    this.stats.cells++;
+
+    const existing = pool.get(value);
+    if (existing !== undefined) {
+      this.stats.reused++;
+      this.stats.savedBytes += STRING_HEADER_BYTES + value.length;
+      return existing;
+    }
+
+    pool.set(value, value);
+    this.stats.added++;
+    return value;
+  };
+
+  /**
+   * Schließt den Bereich ab und speichert die Statistik für die Datei
+   */
+  finish(): InternStats {
+    const stats = { ...this.stats };
+    statsByFile.set(stats.fileName, stats);
+
+    if (stats.cells > 0) {
+      console.log(`String-Pool ${stats.fileName}: ${stats.reused} von ${stats.cells} Werten wiederverwendet, ` +
+        `${stats.added} neu, ca. ${(stats.savedBytes / 1024).toFixed(0)} KB gespart (Pool: ${pool.size} Einträge)`);
+    }
+    return stats;
+  }
+}
+
+/**
+ * Öffnet einen Intern-Bereich für eine Datei
+ * @param fileName Name der Datei für die Statistik (z.B. "Spec_item.txt")
+ */
+export const createInternScope = (fileName: string): InternScope => new InternScope(fileName);
+
+/**
+ * Eingespart je Datei (letzter Parse-Vorgang)
+ */
+export const getStringPoolStats = (): InternStats[] => Array.from(statsByFile.values());
+
+export const getStringPoolSize = (): number => pool.size;
+
+/**
+ * Leert den Pool und die Statistik (zu Beginn jedes Ladevorgangs, siehe loadPredefinedFiles)
+ */
+export const clearStringPool = (): void => {
+  pool.clear();
+  statsByFile.clear();
+};
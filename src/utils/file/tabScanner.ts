@@ -0,0 +1,282 @@
+/**
+ * Tab-getrennte Dateien direkt auf Bytes scannen
+ *
+ * Statt split(/\r?\n/) -> trim() -> split('\t') (ein Array und ein Teilstring pro Zelle)
+ * läuft der Scanner einmal über ein Uint8Array und merkt sich nur Offsets:
+ * pro Zeile den ersten Zelleintrag, pro Zelle Start und Ende (getrimmt) im Puffer.
+ * Zellen werden erst beim Lesen dekodiert; kurze ASCII-Werte, die sich wiederholen
+ * ("=", "_NONE", "IK1_WEAPON", ...), kommen dabei aus einem Cache und erzeugen keinen
+ * neuen String. Numerische Zellen können ohne Dekodieren als Zahl gelesen werden.
+ * Mit setIntern laufen nur neu dekodierte Werte durch den String-Pool (stringPool.ts);
+ * Treffer im Cache sind bereits dedupliziert und werden dort nicht noch einmal gezählt.
+ *
+ * Das Trimmen entspricht line.trim() bzw. cell.trim() für ASCII-Leerraum
+ * (Leerzeichen, Tab, CR, LF, VT, FF); Unicode-Leerzeichen bleiben erhalten.
+ */
+
+export interface TabScanOptions {
+  // Bereich im Puffer (Standard: ganzer Puffer)
+  start?: number;
+  end?: number;
+  // Kodierung für Zellen mit Nicht-ASCII-Zeichen
+  encoding?: string;
+  // Zeilen, die (nach dem Trimmen) mit "//" beginnen, überspringen
+  skipComments?: boolean;
+}
+
+const CHAR_TAB = 9;
+const CHAR_LF = 10;
+const CHAR_SLASH = 47;
+
+// Maximale Zelllänge für den Dekodier-Cache
+const CACHE_MAX_LENGTH = 32;
+const CACHE_SIZE = 1 << 14;
+
+const isSpace = (code: number): boolean => code === 32 || (code >= 9 && code <= 13);
+
+export class TabTable {
+  readonly bytes: Uint8Array;
+  readonly rowCount: number;
+  // Anzahl der Zeilen im gescannten Bereich (wie split(/\r?\n/).length)
+  readonly lineCount: number;
+
+  // 0-basierte Zeilennummer (relativ zum Bereichsanfang) je Datenzeile
+  private readonly rowLines: Uint32Array;
+  // Index der ersten Zelle je Zeile; rowCells[rowCount] = Gesamtzahl der Zellen
+  private readonly rowCells: Uint32Array;
+  // Getrimmter Start und Ende (exklusiv) je Zelle
+  private readonly cellStarts: Uint32Array;
+  private readonly cellEnds: Uint32Array;
+
+  private readonly decoder: TextDecoder;
+  private readonly cacheHashes = new Int32Array(CACHE_SIZE);
+  private readonly cacheValues: (string | undefined)[] = new Array(CACHE_SIZE);
+  private intern: ((value: string) => string) | null = null;
+
+  constructor(bytes: Uint8Array, rowLines: Uint32Array, rowCells: Uint32Array, cellStarts: Uint32Array, cellEnds: Uint32Array, lineCount: number, encoding: string) {
+    this.bytes = bytes;
+    this.rowCount = rowLines.length;
+    this.lineCount = lineCount;
+    this.rowLines = rowLines;
+    this.rowCells = rowCells;
+    this.cellStarts = cellStarts;
+    this.cellEnds = cellEnds;
+    this.decoder = new TextDecoder(encoding);
+  }
+
+  /**
+   * Leitet neu dekodierte Zellen durch den String-Pool (null: ohne Pool)
+   */
+  setIntern(intern: ((value: string) => string) | null): void {
+    this.intern = intern;
+  }
+
+  lineOf(row: number): number {
+    return this.rowLines[row];
+  }
+
+  cellCount(row: number): number {
+    return this.rowCells[row + 1] - this.rowCells[row];
+  }
+
+  cellStart(row: number, column: number): number {
+    return this.cellStarts[this.rowCells[row] + column];
+  }
+
+  cellEnd(row: number, column: number): number {
+    return this.cellEnds[this.rowCells[row] + column];
+  }
+
+  /**
+   * Liest eine Zelle als String; undefined, wenn die Zeile weniger Zellen hat
+   */
+  getCell(row: number, column: number): string | undefined {
+    const cell = this.rowCells[row] + column;
+    if (cell >= this.rowCells[row + 1]) return undefined;
+    return this.decode(this.cellStarts[cell], this.cellEnds[cell]);
+  }
+
+  /**
+   * Prüft, ob eine Zelle genau aus einem Zeichen besteht (z.B. "=")
+   */
+  cellIsChar(row: number, column: number, charCode: number): boolean {
+    const cell = this.rowCells[row] + column;
+    if (cell >= this.rowCells[row + 1]) return false;
+    const start = this.cellStarts[cell];
+    return this.cellEnds[cell] - start === 1 && this.bytes[start] === charCode;
+  }
+
+  /**
+   * Liest eine Zelle als Ganzzahl direkt aus den Bytes
+   * @returns Die Zahl oder NaN, wenn die Zelle keine kanonische Dezimalzahl ist
+   *          (führende Nullen, "-0", Vorzeichen "+" und Werte außerhalb von Int32 gelten als Text)
+   */
+  getIntCell(row: number, column: number): number {
+    const cell = this.rowCells[row] + column;
+    if (cell >= this.rowCells[row + 1]) return NaN;
+
+    const bytes = this.bytes;
+    const end = this.cellEnds[cell];
+    let pos = this.cellStarts[cell];
+    const negative = bytes[pos] === 45; // '-'
+    if (negative) pos++;
+
+    const digits = end - pos;
+    if (digits <= 0 || digits > 10) return NaN;
+    if (bytes[pos] === 48 && (digits > 1 || negative)) return NaN;
+
+    let value = 0;
+    for (; pos < end; pos++) {
+      const digit = bytes[pos] - 48;
+      if (digit < 0 || digit > 9) return NaN;
+      value = value * 10 + digit;
+    }
+
+    value = negative ? -value : value;
+    return value >= -0x80000000 && value <= 0x7fffffff ? value : NaN;
+  }
+
+  /**
+   * Dekodiert einen Bytebereich; kurze ASCII-Werte kommen aus dem Cache
+   */
+  decode(start: number, end: number): string {
+    const length = end - start;
+    if (length === 0) return '';
+    const bytes = this.bytes;
+
+    if (length > CACHE_MAX_LENGTH) {
+      return this.pooled(this.decoder.decode(bytes.subarray(start, end)));
+    }
+
+    // FNV-1a über die Bytes, gleichzeitig auf Nicht-ASCII prüfen
+    let hash = 0x811c9dc5;
+    let ascii = true;
+    for (let i = start; i < end; i++) {
+      const byte = bytes[i];
+      if (byte >= 0x80) {
+        ascii = false;
+        break;
+      }
+      hash = Math.imul(hash ^ byte, 0x01000193);
+    }
+
+    if (!ascii) {
+      return this.pooled(this.decoder.decode(bytes.subarray(start, end)));
+    }
+
+    const slot = (hash >>> 0) & (CACHE_SIZE - 1);
+    const cached = this.cacheValues[slot];
+    if (cached !== undefined && this.cacheHashes[slot] === hash && cached.length === length) {
+      let same = true;
+      for (let i = 0; i < length; i++) {
+        if (cached.charCodeAt(i) !== bytes[start + i]) {
+          same = false;
+          break;
+        }
+      }
+      if (same) return cached;
+    }
+
+    const value = this.pooled(String.fromCharCode.apply(null, bytes.subarray(start, end) as unknown as number[]));
+    this.cacheHashes[slot] = hash;
+    this.cacheValues[slot] = value;
+    return value;
+  }
+
+  private pooled(value: string): string {
+    return this.intern ? this.intern(value) : value;
+  }
+}
+
+// Wachsende Uint32-Liste für die Offsets
+class OffsetList {
+  data: Uint32Array;
+  length = 0;
+
+  constructor(capacity: number) {
+    this.data = new Uint32Array(Math.max(16, capacity));
+  }
+
+  push(value: number): void {
+    if (this.length === this.data.length) {
+      const grown = new Uint32Array(this.data.length * 2);
+      grown.set(this.data);
+      this.data = grown;
+    }
+    this.data[this.length++] = value;
+  }
+
+  toArray(): Uint32Array {
+    return this.data.slice(0, this.length);
+  }
+}
+
+/**
+ * Scannt tab-getrennte Bytes in eine Offset-Tabelle
+ * Leere Zeilen werden übersprungen; Zeilenumbrüche \n und \r\n werden erkannt.
+ * @param bytes Dateiinhalt
+ * @param options Bereich, Kodierung und Kommentarbehandlung
+ */
+export const scanTabSeparated = (bytes: Uint8Array, options: TabScanOptions = {}): TabTable => {
+  const start = options.start ?? 0;
+  const end = options.end ?? bytes.length;
+
+  // Schätzung: ~500 Bytes pro Zeile, ~3 Bytes pro Zelle (Spec_item.txt)
+  const rowLines = new OffsetList((end - start) / 500);
+  const rowCells = new OffsetList((end - start) / 500 + 1);
+  const cellStarts = new OffsetList((end - start) / 3);
+  const cellEnds = new OffsetList((end - start) / 3);
+
+  let line = 0;
+  let pos = start;
+
+  while (pos <= end) {
+    let lineEnd = bytes.indexOf(CHAR_LF, pos);
+    if (lineEnd === -1 || lineEnd > end) lineEnd = end;
+
+    // Zeile trimmen (entspricht line.trim())
+    let contentStart = pos;
+    let contentEnd = lineEnd;
+    while (contentStart < contentEnd && isSpace(bytes[contentStart])) contentStart++;
+    while (contentEnd > contentStart && isSpace(bytes[contentEnd - 1])) contentEnd--;
+
+    const isComment = options.skipComments && contentEnd - contentStart >= 2 &&
+      bytes[contentStart] === CHAR_SLASH && bytes[contentStart + 1] === CHAR_SLASH;
+
+    if (contentEnd > contentStart && !isComment) {
+      rowLines.push(line);
+      rowCells.push(cellStarts.length);
+
+      let cellStart = contentStart;
+      while (true) {
+        let cellEnd = cellStart;
+        while (cellEnd < contentEnd && bytes[cellEnd] !== CHAR_TAB) cellEnd++;
+        const next = cellEnd + 1;
+
+        // Zelle trimmen (entspricht cell.trim())
+        while (cellStart < cellEnd && isSpace(bytes[cellStart])) cellStart++;
+        while (cellEnd > cellStart && isSpace(bytes[cellEnd - 1])) cellEnd--;
+        cellStarts.push(cellStart);
+        cellEnds.push(cellEnd);
+
+        if (next > contentEnd) break;
+        cellStart = next;
+      }
+    }
+
+    line++;
+    pos = lineEnd + 1;
+  }
+
+  rowCells.push(cellStarts.length);
+
+  return new TabTable(
+    bytes,
+    rowLines.toArray(),
+    rowCells.toArray(),
+    cellStarts.toArray(),
+    cellEnds.toArray(),
+    line,
+    options.encoding || 'utf-8'
+  );
+};
@@ -0,0 +1,49 @@
+/**
+ * Webworker für das parallele Parsen von Spec_item.txt
+ * Erhält einen Abschnitt der Datei als übertragenen ArrayBuffer (nur ganze Zeilen)
+ * und liefert die ResourceItems dieses Abschnitts zurück. Die Werte werden als
+ * Spalten (übertragbare Typed Arrays) statt als Objekte pro Zeile zurückgeschickt.
+ */
+import { parseSpecItemRows } from '../parseUtils';
+import { type ColumnStoreSnapshot } from '../columnStore';
+import { createInternScope } from '../stringPool';
+import { scanTabSeparated } from '../tabScanner';
+
+export interface SpecItemShardRequest {
+  shardIndex: number;
+  buffer: ArrayBuffer;
+  header: string[];
+  encoding: string;
+}
+
+export interface SpecItemShardResponse {
+  shardIndex: number;
+  // Items mit leerem data; die Werte stehen in columns (Zeile k gehört zu items[k])
+  items?: any[];
+  columns?: ColumnStoreSnapshot;
+  lineCount?: number;
+  error?: string;
+}
+
+self.onmessage = (event: MessageEvent<SpecItemShardRequest>) => {
+  const { shardIndex, buffer, header, encoding } = event.data;
+
+  try {
+    // Der Abschnitt wird direkt auf Bytes gescannt, ohne ihn vorher zu dekodieren
+    const table = scanTabSeparated(new Uint8Array(buffer), { encoding });
+    // Worker teilen keinen Speicher mit dem Hauptthread, daher ein eigener Pool je Worker
+    const internScope = createInternScope(`Spec_item.txt (Abschnitt ${shardIndex})`);
+    const { items, store } = parseSpecItemRows(table, header, 0, table.rowCount, 0, internScope.intern);
+    internScope.finish();
+    const { snapshot, transfer } = store.toSnapshot();
+
+    // Zeilensichten lassen sich nicht klonen, sie werden im Hauptthread neu erzeugt
+    const shellItems = items.map(item => ({ ...item, data: {} }));
+
+    const response: SpecItemShardResponse = { shardIndex, items: shellItems, columns: snapshot, lineCount: table.lineCount };
+    self.postMessage(response, { transfer });
+  } catch (error) {
+    const response: SpecItemShardResponse = { shardIndex, error: String(error) };
+    self.postMessage(response);
+  }
+};
@@ -1,4 +1,12 @@
 import { NPCItem, NPCFileData, NPCDialogue } from '../../types/npcTypes';
+import { type DefineSymbol, loadOrCompileSymbolTable } from '../file/defineSymbolTable';
+import { getLexedDefineHeader, toDefineSymbols } from '../file/defineLexer';
+import { createInternScope } from '../file/stringPool';
+import { scanTabSeparated } from '../file/tabScanner';
+import { traceAsync, traceBegin, traceEnd, traceSync } from '../trace';
+
+// Version des defineObj.h-Parsers - bei Änderungen erhöhen, damit alte .symtab-Dateien verworfen werden
+const DEFINE_OBJ_PARSER_VERSION = 'defineObj-3';
 
 /**
  * Load a resource file from the public/resource directory
@@ -56,9 +64,10 @@ const loadNPCShop = async (npcId: string): Promise<any | null> => {
  * Load NPCs from propMover.txt and related files
  */
 export const getNPCsFromPropMover = async (): Promise<NPCItem[]> => {
+  const span = traceBegin('getNPCsFromPropMover', 'load');
   try {
     // Load propMover.txt first, as it's the primary source
-    const propMoverText = await loadResourceFile('NPC/propMover.txt');
+    const propMoverText = await traceAsync('NPC/propMover.txt', 'fetch', () => loadResourceFile('NPC/propMover.txt'));
     
     // If propMover.txt is not available, return demo NPCs
     if (!propMoverText) {
@@ -67,19 +76,19 @@ export const getNPCsFromPropMover = async (): Promise<NPCItem[]> => {
     }
     
     // Load remaining files with fallbacks for missing files
-    const [defineObjText, propMoverTxtText, characterIncText, propMoverExText] = await Promise.all([
+    const [defineObjText, propMoverTxtText, characterIncText, propMoverExText] = await traceAsync('NPC/*.h, *.inc, *.txt.txt', 'fetch', () => Promise.all([
       loadResourceFile('NPC/defineObj.h'),
       loadResourceFile('NPC/propMover.txt.txt'),
       loadResourceFile('NPC/character.inc'),
       loadResourceFile('NPC/propMoverEx.inc')
-    ]);
+    ]));
     
     // Parse all files, with empty objects as fallbacks
-    const defineObjData = defineObjText ? parseDefineObj(defineObjText) : {};
-    const propMoverData = parsePropMover(propMoverText);
-    const propMoverTxtData = propMoverTxtText ? parseMoverTxtTxt(propMoverTxtText) : {};
-    const characterIncData = characterIncText ? parseCharacterInc(characterIncText) : {};
-    const propMoverExData = propMoverExText ? parsePropMoverEx(propMoverExText) : {};
+    const defineObjData = defineObjText ? await traceAsync('NPC/defineObj.h', 'parse', () => loadDefineObj(defineObjText)) : {};
+    const propMoverData = traceSync('NPC/propMover.txt', 'parse', () => parsePropMover(propMoverText));
+    const propMoverTxtData = propMoverTxtText ? traceSync('NPC/propMover.txt.txt', 'parse', () => parseMoverTxtTxt(propMoverTxtText)) : {};
+    const characterIncData = characterIncText ? traceSync('NPC/character.inc', 'parse', () => parseCharacterInc(characterIncText)) : {};
+    const propMoverExData = propMoverExText ? traceSync('NPC/propMoverEx.inc', 'parse', () => parsePropMoverEx(propMoverExText)) : {};
     
     if (Object.keys(defineObjData).length === 0) {
       console.warn('define.obj not loaded or empty, returning demo NPCs');
@@ -87,7 +96,9 @@ export const getNPCsFromPropMover = async (): Promise<NPCItem[]> => {
     }
     
     // Merge data into a usable NPC list
-    const npcs = mergeNpcData(propMoverData, propMoverTxtData, defineObjData, characterIncData, propMoverExData);
+    const npcs = traceSync('mergeNpcData', 'index', () =>
+      mergeNpcData(propMoverData, propMoverTxtData, defineObjData, characterIncData, propMoverExData)
+    );
     
     if (npcs.length === 0) {
       console.warn("No NPCs found in propMover.txt, returning demo NPCs");
@@ -95,6 +106,7 @@ export const getNPCsFromPropMover = async (): Promise<NPCItem[]> => {
     }
     
     // Load dialogues and shop data for each NPC
+    const extrasSpan = traceBegin('NPC dialogues + shops', 'fetch');
     const npcsWithExtras = await Promise.all(
       npcs.map(async (npc) => {
         try {
@@ -137,34 +149,48 @@ export const getNPCsFromPropMover = async (): Promise<NPCItem[]> => {
       })
     );
     
+    traceEnd(extrasSpan, { npcs: npcs.length });
+    
     return npcsWithExtras;
   } catch (error) {
     console.error('Error loading NPC files:', error);
     console.warn('Resource files not found or incomplete, returning demo NPCs');
     return []; // Return empty array instead of demo NPCs
+  } finally {
+    traceEnd(span);
   }
 };
 
 /**
  * Parse defineObj.h file to extract NPC type definitions
  */
-const parseDefineObj = (text: string): Record<string, number> => {
-  const regex = /#define\s+(MI_[^\s]+)\s+(\d+)/g;
-  let match;
-  const data: Record<string, number> = {};
-  
-  while ((match = regex.exec(text)) !== null) {
-    data[match[1]] = parseInt(match[2]);
+const parseDefineObj = (text: string): DefineSymbol[] => {
+  return toDefineSymbols(getLexedDefineHeader(text).tables.MI);
+};
+
+/**
+ * Load NPC type definitions from defineObj.h via its compiled symbol table
+ */
+const loadDefineObj = async (text: string): Promise<Record<string, number>> => {
+  try {
+    const table = await loadOrCompileSymbolTable('NPC/defineObj.h', text, DEFINE_OBJ_PARSER_VERSION, parseDefineObj);
+    return table.toRecord();
+  } catch (error) {
+    console.error('Error loading symbol table for defineObj.h:', error);
+    const data: Record<string, number> = {};
+    parseDefineObj(text).forEach(symbol => {
+      data[symbol.name] = symbol.value;
+    });
+    return data;
   }
-  
-  return data;
 };
 
 /**
  * Parse propMover.txt file
  */
 const parsePropMover = (text: string): Record<string, any> => {
-  const lines = text.split("\n").filter(line => line && !line.startsWith("//"));
+  // Direkt auf Bytes scannen; Kommentarzeilen (//) überspringt der Scanner
+  const table = scanTabSeparated(new TextEncoder().encode(text), { skipComments: true });
   const headers = [
     "id", "szName", "dwClass", "dwLevel", "dwBelligerence", 
     "dwStr", "dwSta", "dwDex", "dwInt", "dwHR", 
@@ -172,18 +198,21 @@ const parsePropMover = (text: string): Record<string, any> => {
   ];
   
   const movers: Record<string, any> = {};
+  const internScope = createInternScope("propMover.txt");
+  table.setIntern(internScope.intern);
   
-  lines.forEach(line => {
-    const parts = line.split("\t");
-    if (parts.length >= headers.length) {
-      const npcId = parts[0];
-      movers[npcId] = headers.reduce((acc, key, index) => {
-        acc[key] = parts[index] || "";
-        return acc;
-      }, {} as Record<string, any>);
-    }
-  });
+  for (let row = 0; row < table.rowCount; row++) {
+    if (table.cellCount(row) < headers.length) continue;
+    
+    const npcId = table.getCell(row, 0)!;
+    movers[npcId] = headers.reduce((acc, key, index) => {
+      acc[key] = table.getCell(row, index) || "";
+      return acc;
+    }, {} as Record<string, any>);
+  }
   
+  table.setIntern(null);
+  internScope.finish();
   return movers;
 };
 
@@ -193,17 +222,19 @@ const parsePropMover = (text: string): Record<string, any> => {
 const parseMoverTxtTxt = (text: string): Record<string, {name: string, description: string}> => {
   const lines = text.split("\n").filter(line => line.trim() !== "");
   const names: Record<string, {name: string, description: string}> = {};
+  const internScope = createInternScope("propMover.txt.txt");
   
   lines.forEach(line => {
     const parts = line.split("\t");
     if (parts.length >= 2) {
       const id = parts[0].trim();
-      const name = parts[1].trim();
-      const description = parts.length >= 3 ? parts[2].trim() : "";
+      const name = internScope.intern(parts[1].trim());
+      const description = parts.length >= 3 ? internScope.intern(parts[2].trim()) : "";
       names[id] = { name, description };
     }
   });
   
+  internScope.finish();
   return names;
 };
 
@@ -315,23 +346,26 @@ const parseCharacterInc = (text: string): Record<string, any> => {
 const parsePropMoverEx = (text: string): Record<string, any> => {
   const lines = text.split("\n").filter(line => line.trim() !== "" && !line.startsWith("//"));
   const npcExData: Record<string, any> = {};
+  const internScope = createInternScope("propMoverEx.inc");
+  const intern = internScope.intern;
   
   lines.forEach(line => {
     const parts = line.split(",");
     if (parts.length >= 8) {
       const npcId = parts[0].trim();
       npcExData[npcId] = {
-        dialogType: parts[1].trim(),
-        shopType: parts[2].trim(),
+        dialogType: intern(parts[1].trim()),
+        shopType: intern(parts[2].trim()),
         isQuestGiver: parts[3].trim() === "TRUE",
-        combatType: parts[4].trim(),
-        faction: parts[5].trim(),
+        combatType: intern(parts[4].trim()),
+        faction: intern(parts[5].trim()),
         respawnTime: parseInt(parts[6].trim()),
-        voiceSet: parts[7].trim()
+        voiceSet: intern(parts[7].trim())
       };
     }
   });
   
+  internScope.finish();
   return npcExData;
 };
 
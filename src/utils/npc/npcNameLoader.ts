@@ -1,4 +1,5 @@
 import { toast } from 'sonner';
+import { createInternScope } from '../file/stringPool';
 
 // Typdefinition für das Ergebnis
 export interface NpcNameMap {
@@ -30,6 +31,7 @@ const loadFile = async (filePath: string): Promise<string> => {
 const parsePropMover = (content: string): { [id: string]: { reference: string } } => {
   const npcs: { [id: string]: { reference: string } } = {};
   const lines = content.split(/\r?\n/);
+  const internScope = createInternScope("propMover.txt");
   // Verwende eine weniger strenge Regex, die IDS_PROPMOVER_TXT_ + Zahlen findet,
   // aber nicht unbedingt am Anfang der Zeile
   const idRegex = /(IDS_PROPMOVER_TXT_\d+)/;
@@ -44,11 +46,12 @@ const parsePropMover = (content: string): { [id: string]: { reference: string }
         const match = potentialRef.match(idRegex);
         const npcNameRef = match ? match[0] : null;
         if (npcId && npcNameRef) {
-          npcs[npcId] = { reference: npcNameRef };
+          npcs[npcId] = { reference: internScope.intern(npcNameRef) };
         }
       }
     }
   });
+  internScope.finish();
   return npcs;
 };
 
@@ -56,6 +59,7 @@ const parsePropMover = (content: string): { [id: string]: { reference: string }
 const parsePropMoverNames = (content: string): { [reference: string]: string } => {
   const names: { [reference: string]: string } = {};
   const lines = content.split(/\r?\n/);
+  const internScope = createInternScope("propMover.txt.txt");
   
   console.log(`Processing ${lines.length} lines from propMover.txt.txt`);
   
@@ -84,7 +88,7 @@ const parsePropMoverNames = (content: string): { [reference: string]: string } =
           // Nur gerade IDs enthalten Namen (0, 2, 4, ...)
           // Ungerade IDs sind Beschreibungen (1, 3, 5, ...)
           if (idNumber % 2 === 0) {
-            const name = parts.length >= 2 ? parts[1] : "";
+            const name = parts.length >= 2 ? internScope.intern(parts[1]) : "";
             
             // Speichere den Namen mit dem originalen Schlüssel (wichtig für das Mapping)
             names[key] = name;
@@ -98,6 +102,7 @@ const parsePropMoverNames = (content: string): { [reference: string]: string } =
     }
   });
   
+  internScope.finish();
   const namesCount = Object.keys(names).length;
   console.log(`Parsed ${namesCount} name mappings from propMover.txt.txt`);
   
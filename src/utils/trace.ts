@@ -0,0 +1,187 @@
+/**
+ * Tracing für Start- und Ladephasen
+ *
+ * Spans (Name, Kategorie, Start, Dauer) landen in einem Ringpuffer fester Größe aus
+ * Typed Arrays; Aufzeichnen kostet nur zwei performance.now()-Aufrufe und ein paar
+ * Schreibzugriffe, alte Einträge werden überschrieben. exportChromeTrace erzeugt daraus
+ * eine Trace-Event-Datei, die sich in about:tracing oder Perfetto (ui.perfetto.dev)
+ * öffnen lässt. Export per Strg+Umschalt+T oder in der Konsole: cyrusTrace.download()
+ *
+ * Kategorien: fetch (Datei lesen), decode (Bytes -> Text), parse, index (Nachschlagetabellen
+ * aufbauen), render, load (ganze Ladevorgänge, umfasst die anderen)
+ */
+
+export type TraceCategory = 'load' | 'fetch' | 'decode' | 'parse' | 'index' | 'render';
+
+const CATEGORIES: TraceCategory[] = ['load', 'fetch', 'decode', 'parse', 'index', 'render'];
+const CAPACITY = 8192;
+
+// Ringpuffer
+const eventName = new Uint16Array(CAPACITY);
+const eventCategory = new Uint8Array(CAPACITY);
+const eventStart = new Float64Array(CAPACITY);
+const eventDuration = new Float64Array(CAPACITY);
+const eventArgs: (Record<string, unknown> | undefined)[] = new Array(CAPACITY);
+let eventCount = 0;
+
+// Namen werden einmal abgelegt, im Puffer steht nur der Index
+const names: string[] = [];
+const nameIndexes = new Map<string, number>();
+
+const internName = (name: string): number => {
+  let index = nameIndexes.get(name);
+  if (index === undefined) {
+    index = names.length;
+    names.push(name);
+    nameIndexes.set(name, index);
+  }
+  return index;
+};
+
+export interface TraceSpan {
+  name: string;
+  category: TraceCategory;
+  start: number;
+}
+
+/**
+ * Span mit bekannten Zeiten aufzeichnen (performance.now()-Zeitstempel in ms)
+ */
+export const recordTraceSpan = (name: string, category: TraceCategory, start: number, end: number, args?: Record<string, unknown>): void => {
+  const slot = eventCount % CAPACITY;
+  eventName[slot] = internName(name);
+  eventCategory[slot] = CATEGORIES.indexOf(category);
+  eventStart[slot] = start;
+  eventDuration[slot] = end - start;
+  eventArgs[slot] = args;
+  eventCount++;
+};
+
+export const traceBegin = (name: string, category: TraceCategory): TraceSpan =>
+  ({ name, category, start: performance.now() });
+
+export const traceEnd = (span: TraceSpan, args?: Record<string, unknown>): void =>
+  recordTraceSpan(span.name, span.category, span.start, performance.now(), args);
+
+/**
+ * Synchronen Abschnitt als Span aufzeichnen
+ */
+export const traceSync = <T>(name: string, category: TraceCategory, fn: () => T): T => {
+  const span = traceBegin(name, category);
+  try {
+    return fn();
+  } finally {
+    traceEnd(span);
+  }
+};
+
+/**
+ * Asynchronen Abschnitt als Span aufzeichnen (bis das Promise erfüllt oder abgelehnt ist)
+ */
+export const traceAsync = async <T>(name: string, category: TraceCategory, fn: () => Promise<T>): Promise<T> => {
+  const span = traceBegin(name, category);
+  try {
+    return await fn();
+  } finally {
+    traceEnd(span);
+  }
+};
+
+interface ChromeTraceEvent {
+  name: string;
+  cat?: string;
+  ph: 'X' | 'M';
+  ts: number;
+  dur?: number;
+  pid: number;
+  tid: number;
+  args?: Record<string, unknown>;
+}
+
+/**
+ * Gepufferte Spans als Chrome-Trace-Event-Objekt ({ traceEvents: [...] })
+ *
+ * Complete-Events ('X') müssen je Thread sauber verschachtelt sein. Asynchrone Spans
+ * überlappen sich aber (z.B. parallel geladene Dateien), daher werden sie auf Spuren
+ * verteilt: ein Span kommt in die erste Spur, in der er in den offenen Span passt.
+ */
+export const exportChromeTrace = (): { traceEvents: ChromeTraceEvent[]; displayTimeUnit: string } => {
+  const first = Math.max(0, eventCount - CAPACITY);
+  const slots: number[] = [];
+  for (let i = first; i < eventCount; i++) slots.push(i % CAPACITY);
+  // Nach Start, bei gleichem Start den längeren (äußeren) zuerst
+  slots.sort((a, b) => eventStart[a] - eventStart[b] || eventDuration[b] - eventDuration[a]);
+
+  const lanes: number[][] = [];
+  const traceEvents: ChromeTraceEvent[] = [];
+  const pid = 1;
+
+  for (const slot of slots) {
+    const start = eventStart[slot];
+    const end = start + eventDuration[slot];
+
+    let lane = 0;
+    for (; lane < lanes.length; lane++) {
+      const stack = lanes[lane];
+      while (stack.length > 0 && eventStart[stack[stack.length - 1]] + eventDuration[stack[stack.length - 1]] <= start) {
+        stack.pop();
+      }
+      const top = stack[stack.length - 1];
+      if (top === undefined || eventStart[top] + eventDuration[top] >= end) break;
+    }
+    if (lane === lanes.length) lanes.push([]);
+    lanes[lane].push(slot);
+
+    traceEvents.push({
+      name: names[eventName[slot]],
+      cat: CATEGORIES[eventCategory[slot]],
+      ph: 'X',
+      // Mikrosekunden seit dem Start der Seite
+      ts: Math.round(start * 1000),
+      dur: Math.round(eventDuration[slot] * 1000),
+      pid,
+      tid: lane + 1,
+      ...(eventArgs[slot] ? { args: eventArgs[slot] } : {})
+    });
+  }
+
+  traceEvents.push({ name: 'process_name', ph: 'M', ts: 0, pid, tid: 0, args: { name: 'Cyrus Resource Tool (Renderer)' } });
+  lanes.forEach((_, lane) => {
+    traceEvents.push({ name: 'thread_name', ph: 'M', ts: 0, pid, tid: lane + 1, args: { name: lane === 0 ? 'Laden' : `Laden (parallel ${lane})` } });
+  });
+
+  return { traceEvents, displayTimeUnit: 'ms' };
+};
+
+/**
+ * Trace als JSON-Datei herunterladen
+ */
+export const downloadChromeTrace = (): void => {
+  const trace = exportChromeTrace();
+  const blob = new Blob([JSON.stringify(trace)], { type: 'application/json' });
+  const url = URL.createObjectURL(blob);
+  const link = document.createElement('a');
+  link.href = url;
+  link.download = `cyrus-trace-${new Date().toISOString().replace(/[:.]/g, '-')}.json`;
+  link.click();
+  setTimeout(() => URL.revokeObjectURL(url), 1000);
+  console.log(`Trace exportiert: ${trace.traceEvents.length} Events (${Math.min(eventCount, CAPACITY)} Spans, ${Math.max(0, eventCount - CAPACITY)} überschrieben)`);
+};
+
+let exportInitialized = false;
+
+/**
+ * Export-Tastenkürzel (Strg+Umschalt+T) und window.cyrusTrace einrichten (einmalig)
+ */
+export const initTraceExport = (): void => {
+  if (exportInitialized || typeof window === 'undefined') return;
+  exportInitialized = true;
+
+  (window as any).cyrusTrace = { export: exportChromeTrace, download: downloadChromeTrace };
+  window.addEventListener('keydown', (event) => {
+    if (event.ctrlKey && event.shiftKey && (event.key === 'T' || event.key === 't')) {
+      event.preventDefault();
+      downloadChromeTrace();
+    }
+  });
+};